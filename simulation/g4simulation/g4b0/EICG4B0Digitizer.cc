@@ -0,0 +1,271 @@
+#include "EICG4B0Digitizer.h"
+
+#include <trackbase/TrkrClusterContainerv3.h>
+#include <trackbase/TrkrClusterv2.h>
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitv2.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <memory>
+#include <set>
+
+namespace
+{
+  uint64_t PixelKey(const int layer, const int column, const int row)
+  {
+    return (((uint64_t) layer) << 32) | (((uint64_t) column) << 16) | row;
+  }
+}  // namespace
+
+EICG4B0Digitizer::EICG4B0Digitizer(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+void EICG4B0Digitizer::AddLayer(const std::string &name, const int layer, const double radius,
+                                const double x, const double y, const double z, const double rot_y)
+{
+  Layer l;
+  l.nodename = "G4HIT_" + name;
+  l.layer = layer;
+  l.radius = radius;
+  l.center[0] = x;
+  l.center[1] = y;
+  l.center[2] = z;
+  l.rot_y = rot_y * M_PI / 180.;
+  m_Layers.push_back(l);
+}
+
+int EICG4B0Digitizer::InitRun(PHCompositeNode *topNode)
+{
+  if (m_Layers.empty())
+  {
+    std::cout << PHWHERE << " no B0 layers, use AddLayer()" << std::endl;
+    exit(1);
+  }
+  for (Layer &l : m_Layers)
+  {
+    l.npixels = std::ceil(2. * l.radius / m_Pitch);
+    if (l.npixels > 65536 || l.layer < 0 || l.layer > 255)
+    {
+      std::cout << PHWHERE << " layer " << l.layer << " with " << l.npixels
+                << " pixels per row does not fit into the keys" << std::endl;
+      exit(1);
+    }
+  }
+  CreateNodes(topNode);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int EICG4B0Digitizer::process_event(PHCompositeNode *topNode)
+{
+  m_PixelEnergy.clear();
+  for (unsigned int ilayer = 0; ilayer < m_Layers.size(); ilayer++)
+  {
+    PHG4HitContainer *g4hits = findNode::getClass<PHG4HitContainer>(topNode, m_Layers[ilayer].nodename);
+    if (!g4hits)
+    {
+      std::cout << PHWHERE << " Could not locate g4 hit node " << m_Layers[ilayer].nodename << std::endl;
+      exit(1);
+    }
+    PHG4HitContainer::ConstRange hit_begin_end = g4hits->getHits();
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      PHG4Hit *g4hit = hiter->second;
+      if (g4hit->get_hit_type() < 0 || g4hit->get_edep() <= 0)
+      {
+        continue;
+      }
+      // the hit positions are in the local frame of the plane
+      const double dx = g4hit->get_x(1) - g4hit->get_x(0);
+      const double dy = g4hit->get_y(1) - g4hit->get_y(0);
+      const int nsub = std::min(1000, std::max(1, (int) std::ceil(2. * std::sqrt(dx * dx + dy * dy) / m_Pitch)));
+      for (int i = 0; i < nsub; i++)
+      {
+        const double frac = (i + 0.5) / nsub;
+        AddDeposit(ilayer, g4hit->get_x(0) + frac * dx, g4hit->get_y(0) + frac * dy, g4hit->get_edep() / nsub);
+      }
+    }
+  }
+
+  MakeHitsAndClusters();
+
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << m_PixelEnergy.size() << " pixels with signal, "
+              << m_Clusters->size() << " clusters" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void EICG4B0Digitizer::AddDeposit(const int ilayer, const double x, const double y, const double edep)
+{
+  const Layer &l = m_Layers[ilayer];
+  const int column = std::floor((x + l.radius) / m_Pitch);
+  const int row = std::floor((y + l.radius) / m_Pitch);
+  if (column < 0 || column >= l.npixels || row < 0 || row >= l.npixels)
+  {
+    return;
+  }
+  m_PixelEnergy[PixelKey(ilayer, column, row)] += edep;
+}
+
+void EICG4B0Digitizer::MakeHitsAndClusters()
+{
+  std::set<uint64_t> fired;
+  for (auto &iter : m_PixelEnergy)
+  {
+    if (iter.second * 1e6 < m_Threshold)
+    {
+      continue;
+    }
+    fired.insert(iter.first);
+    const Layer &l = m_Layers[iter.first >> 32];
+    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, l.layer);
+    TrkrHitSetContainer::ConstIterator hitset = m_HitSets->findOrAddHitSet(hitsetkey);
+    TrkrHitv2 *hit = new TrkrHitv2();
+    hit->setAdc(iter.second * 1e9);
+    hitset->second->addHitSpecificKey(iter.first & 0xFFFFFFFF, hit);
+  }
+
+  // connected pixels, every fired pixel is visited once
+  std::map<int, unsigned int> clusid;
+  std::vector<uint64_t> stack;
+  while (!fired.empty())
+  {
+    const uint64_t seed = *fired.begin();
+    fired.erase(fired.begin());
+    const int ilayer = seed >> 32;
+    stack.assign(1, seed);
+    double sumx = 0.;
+    double sumy = 0.;
+    double sume = 0.;
+    int colrange[2] = {0xFFFF, 0};
+    int rowrange[2] = {0xFFFF, 0};
+    while (!stack.empty())
+    {
+      const uint64_t key = stack.back();
+      stack.pop_back();
+      const int column = (key >> 16) & 0xFFFF;
+      const int row = key & 0xFFFF;
+      const double e = m_PixelEnergy[key];
+      sumx += e * (column + 0.5);
+      sumy += e * (row + 0.5);
+      sume += e;
+      colrange[0] = std::min(colrange[0], column);
+      colrange[1] = std::max(colrange[1], column);
+      rowrange[0] = std::min(rowrange[0], row);
+      rowrange[1] = std::max(rowrange[1], row);
+      for (int dc = -1; dc <= 1; dc++)
+      {
+        for (int dr = -1; dr <= 1; dr++)
+        {
+          if ((!dc && !dr) || column + dc < 0 || row + dr < 0)
+          {
+            continue;
+          }
+          auto neighbour = fired.find(PixelKey(ilayer, column + dc, row + dr));
+          if (neighbour != fired.end())
+          {
+            stack.push_back(*neighbour);
+            fired.erase(neighbour);
+          }
+        }
+      }
+    }
+
+    // local position in the middle of the plane, rotated around y
+    const Layer &l = m_Layers[ilayer];
+    const double localx = sumx / sume * m_Pitch - l.radius;
+    const double localy = sumy / sume * m_Pitch - l.radius;
+    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, l.layer);
+    auto clus = std::make_unique<TrkrClusterv2>();
+    TrkrDefs::cluskey key = hitsetkey;
+    key = (key << TrkrDefs::kBitShiftClusId) | clusid[l.layer]++;
+    clus->setClusKey(key);
+    clus->setPosition(0, l.center[0] + localx * std::cos(l.rot_y));
+    clus->setPosition(1, l.center[1] + localy);
+    clus->setPosition(2, l.center[2] + localx * std::sin(l.rot_y));
+    // error pitch/sqrt(12) and half the cluster extent in the plane, none
+    // along its normal, rotated like the position
+    const double localerr[3] = {m_Pitch * m_Pitch / 12., m_Pitch * m_Pitch / 12., 0.};
+    const double localsize[3] = {std::pow(0.5 * (colrange[1] - colrange[0] + 1) * m_Pitch, 2),
+                                 std::pow(0.5 * (rowrange[1] - rowrange[0] + 1) * m_Pitch, 2), 0.};
+    // columns: local x, y and the normal in the global frame
+    const double rot[3][3] = {{std::cos(l.rot_y), 0., -std::sin(l.rot_y)},
+                              {0., 1., 0.},
+                              {std::sin(l.rot_y), 0., std::cos(l.rot_y)}};
+    for (int i = 0; i < 3; i++)
+    {
+      for (int k = 0; k < 3; k++)
+      {
+        double err = 0.;
+        double size = 0.;
+        for (int j = 0; j < 3; j++)
+        {
+          err += rot[i][j] * localerr[j] * rot[k][j];
+          size += rot[i][j] * localsize[j] * rot[k][j];
+        }
+        clus->setError(i, k, err);
+        clus->setSize(i, k, size);
+      }
+    }
+    clus->setGlobal();
+    clus->setAdc(sume * 1e6);
+    m_Clusters->addCluster(clus.release());
+  }
+}
+
+void EICG4B0Digitizer::CreateNodes(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+    exit(1);
+  }
+  PHNodeIterator dstiter(dstNode);
+  PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+  if (!DetNode)
+  {
+    DetNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(DetNode);
+  }
+
+  std::string nodename = "TRKR_HITSET_" + m_Detector;
+  m_HitSets = findNode::getClass<TrkrHitSetContainer>(DetNode, nodename);
+  if (!m_HitSets)
+  {
+    m_HitSets = new TrkrHitSetContainerv1();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_HitSets, nodename, "PHObject"));
+  }
+
+  nodename = "TRKR_CLUSTER_" + m_Detector;
+  m_Clusters = findNode::getClass<TrkrClusterContainer>(DetNode, nodename);
+  if (!m_Clusters)
+  {
+    m_Clusters = new TrkrClusterContainerv3();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_Clusters, nodename, "PHObject"));
+  }
+  return;
+}
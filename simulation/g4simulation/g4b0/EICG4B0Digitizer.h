@@ -0,0 +1,90 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef EICG4B0DIGITIZER_H
+#define EICG4B0DIGITIZER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class TrkrClusterContainer;
+class TrkrHitSetContainer;
+
+/**
+ * \brief SubsysReco module turning the G4Hits of the B0 silicon planes into
+ * pixels and clusters
+ *
+ * Every plane is a separate EICG4B0Subsystem whose G4Hits are stored in the
+ * local frame of the plane. The energy of each G4Hit is shared along its
+ * path over square pixels in local x, y, pixels above threshold are joined
+ * into clusters with their neighbours (including corners). The cluster
+ * position is the energy weighted mean of the pixel centers, transformed
+ * to the global frame with the placement given in AddLayer, its error is
+ * pitch/sqrt(12) in the plane. Output nodes:
+ *  - TRKR_HITSET_<detector>: one hitset per plane (mvtx id, layer),
+ *    hitkey = (column << 16) | row, adc = energy in eV
+ *  - TRKR_CLUSTER_<detector>: clusters in global coordinates, adc = energy in keV
+ */
+class EICG4B0Digitizer : public SubsysReco
+{
+ public:
+  EICG4B0Digitizer(const std::string &name = "EICG4B0Digitizer");
+  ~EICG4B0Digitizer() override {}
+
+  //! run initialization
+  int InitRun(PHCompositeNode *topNode) override;
+
+  //! event processing
+  int process_event(PHCompositeNode *topNode) override;
+
+  /** Name used for the output nodes.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  //! plane with G4Hits in G4HIT_<name>; outer radius, global position of the
+  //! center (cm) and rotation around y (deg) like for its EICG4B0Subsystem
+  void AddLayer(const std::string &name, const int layer, const double radius,
+                const double x, const double y, const double z, const double rot_y);
+
+  //! pixel pitch (cm)
+  void set_pitch(const double p) { m_Pitch = p; }
+  //! pixel threshold (keV)
+  void set_threshold(const double t) { m_Threshold = t; }
+
+ private:
+  struct Layer
+  {
+    std::string nodename;
+    int layer = 0;
+    double radius = 0.;
+    double center[3] = {0., 0., 0.};
+    double rot_y = 0.;
+    int npixels = 0;
+  };
+
+  void CreateNodes(PHCompositeNode *topNode);
+
+  //! add energy (GeV) at local x, y (cm)
+  void AddDeposit(const int ilayer, const double x, const double y, const double edep);
+
+  void MakeHitsAndClusters();
+
+  TrkrHitSetContainer *m_HitSets = nullptr;
+  TrkrClusterContainer *m_Clusters = nullptr;
+
+  std::string m_Detector = "B0";
+
+  double m_Pitch = 0.002;
+  double m_Threshold = 0.36;
+
+  std::vector<Layer> m_Layers;
+
+  //! (layer index << 32) | (column << 16) | row -> energy (GeV)
+  std::map<uint64_t, double> m_PixelEnergy;
+};
+
+#endif  // EICG4B0DIGITIZER_H
@@ -0,0 +1,385 @@
+#include "EICG4B0MomentumReco.h"
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackMap_v1.h>
+#include <trackbase_historic/SvtxTrack_v2.h>
+
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TDatabasePDG.h>
+#include <TFile.h>
+#include <TParticlePDG.h>
+#include <TProfile2D.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <map>
+#include <set>
+
+namespace
+{
+  struct Point
+  {
+    TrkrDefs::cluskey key;
+    double pos[3];
+  };
+
+  double Det3(const double m[3][3])
+  {
+    return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+           m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+           m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  }
+}  // namespace
+
+EICG4B0MomentumReco::EICG4B0MomentumReco(const std::string &name, const std::string &lutfile)
+  : SubsysReco(name)
+  , m_LUTFile(lutfile)
+{
+}
+
+EICG4B0MomentumReco::~EICG4B0MomentumReco()
+{
+  delete m_QOverP;
+  delete m_ThetaX;
+  delete m_ThetaY;
+}
+
+int EICG4B0MomentumReco::InitRun(PHCompositeNode *topNode)
+{
+  if (m_BuildLUT)
+  {
+    m_QOverP = new TProfile2D("qoverp", "q/p;x (cm);dx/dz;q/p (1/GeV)", m_NPosBins, m_PosRange[0], m_PosRange[1], m_NSlopeBins, m_SlopeRange[0], m_SlopeRange[1]);
+    m_ThetaX = new TProfile2D("thetax", "#theta_{x};x (cm);dx/dz;#theta_{x}", m_NPosBins, m_PosRange[0], m_PosRange[1], m_NSlopeBins, m_SlopeRange[0], m_SlopeRange[1]);
+    m_ThetaY = new TProfile2D("thetay", "#theta_{y};y (cm);dy/dz;#theta_{y}", m_NPosBins, m_PosRange[0], m_PosRange[1], m_NSlopeBins, m_SlopeRange[0], m_SlopeRange[1]);
+    for (TProfile2D *lut : {m_QOverP, m_ThetaX, m_ThetaY})
+    {
+      lut->SetDirectory(nullptr);
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  TFile lutfile(m_LUTFile.c_str());
+  if (!lutfile.IsOpen())
+  {
+    std::cout << PHWHERE << " cannot open lookup table " << m_LUTFile << std::endl;
+    exit(1);
+  }
+  TProfile2D *qoverp = dynamic_cast<TProfile2D *>(lutfile.Get("qoverp"));
+  TProfile2D *thetax = dynamic_cast<TProfile2D *>(lutfile.Get("thetax"));
+  TProfile2D *thetay = dynamic_cast<TProfile2D *>(lutfile.Get("thetay"));
+  if (!qoverp || !thetax || !thetay)
+  {
+    std::cout << PHWHERE << " incomplete lookup table in " << m_LUTFile << std::endl;
+    exit(1);
+  }
+  m_QOverP = dynamic_cast<TProfile2D *>(qoverp->Clone());
+  m_ThetaX = dynamic_cast<TProfile2D *>(thetax->Clone());
+  m_ThetaY = dynamic_cast<TProfile2D *>(thetay->Clone());
+  for (TProfile2D *lut : {m_QOverP, m_ThetaX, m_ThetaY})
+  {
+    lut->SetDirectory(nullptr);
+  }
+
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+    exit(1);
+  }
+  PHNodeIterator dstiter(dstNode);
+  PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "SVTX"));
+  if (!DetNode)
+  {
+    DetNode = new PHCompositeNode("SVTX");
+    dstNode->addNode(DetNode);
+  }
+  const std::string nodename = "SvtxTrackMap_" + m_Detector;
+  m_TrackMap = findNode::getClass<SvtxTrackMap>(DetNode, nodename);
+  if (!m_TrackMap)
+  {
+    m_TrackMap = new SvtxTrackMap_v1();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_TrackMap, nodename, "PHObject"));
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int EICG4B0MomentumReco::process_event(PHCompositeNode *topNode)
+{
+  const std::string clusnodename = "TRKR_CLUSTER_" + m_Detector;
+  m_Clusters = findNode::getClass<TrkrClusterContainer>(topNode, clusnodename);
+  if (!m_Clusters)
+  {
+    std::cout << PHWHERE << " Could not locate cluster node " << clusnodename << std::endl;
+    exit(1);
+  }
+
+  std::vector<Track> tracks;
+  FindTracks(tracks);
+
+  if (m_BuildLUT)
+  {
+    PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+    if (!truthinfo)
+    {
+      std::cout << PHWHERE << " G4TruthInfo node missing" << std::endl;
+      exit(1);
+    }
+    PHG4TruthInfoContainer::ConstRange range = truthinfo->GetPrimaryParticleRange();
+    // one reference particle per event, the best track belongs to it
+    if (tracks.empty() || range.first == range.second)
+    {
+      return Fun4AllReturnCodes::EVENT_OK;
+    }
+    const PHG4Particle *particle = range.first->second;
+    const TParticlePDG *pdg = TDatabasePDG::Instance()->GetParticle(particle->get_pid());
+    const double p = std::sqrt(particle->get_px() * particle->get_px() + particle->get_py() * particle->get_py() + particle->get_pz() * particle->get_pz());
+    if (!pdg || pdg->Charge() == 0 || p <= 0)
+    {
+      return Fun4AllReturnCodes::EVENT_OK;
+    }
+    const Track &track = tracks.front();
+    m_QOverP->Fill(track.par[0], track.par[1], pdg->Charge() / 3. / p);
+    m_ThetaX->Fill(track.par[0], track.par[1], std::atan2(particle->get_px(), particle->get_pz()));
+    m_ThetaY->Fill(track.par[2], track.par[3], std::atan2(particle->get_py(), particle->get_pz()));
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  for (const Track &track : tracks)
+  {
+    double qoverp, thetax, thetay;
+    if (!Lookup(m_QOverP, track.par[0], track.par[1], qoverp) ||
+        !Lookup(m_ThetaX, track.par[0], track.par[1], thetax) ||
+        !Lookup(m_ThetaY, track.par[2], track.par[3], thetay) ||
+        qoverp == 0)
+    {
+      continue;
+    }
+    const double p = 1. / std::abs(qoverp);
+    const double tx = std::tan(thetax);
+    const double ty = std::tan(thetay);
+    const double pz = p / std::sqrt(1. + tx * tx + ty * ty);
+    SvtxTrack_v2 svtxtrack;
+    svtxtrack.set_id(m_TrackMap->size());
+    svtxtrack.set_charge(qoverp > 0 ? 1 : -1);
+    svtxtrack.set_px(pz * tx);
+    svtxtrack.set_py(pz * ty);
+    svtxtrack.set_pz(pz);
+    svtxtrack.set_x(0.);
+    svtxtrack.set_y(0.);
+    svtxtrack.set_z(0.);
+    svtxtrack.set_chisq(track.chi2);
+    svtxtrack.set_ndf(2 * track.clusters.size() - 5);
+    for (TrkrDefs::cluskey key : track.clusters)
+    {
+      svtxtrack.insert_cluster_key(key);
+    }
+    m_TrackMap->insert(&svtxtrack);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << tracks.size() << " track candidates, "
+              << m_TrackMap->size() << " tracks" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int EICG4B0MomentumReco::End(PHCompositeNode * /*topNode*/)
+{
+  if (m_BuildLUT)
+  {
+    TFile lutfile(m_LUTFile.c_str(), "RECREATE");
+    m_QOverP->Write();
+    m_ThetaX->Write();
+    m_ThetaY->Write();
+    lutfile.Close();
+    std::cout << Name() << ": lookup table from " << m_QOverP->GetEntries()
+              << " reference tracks written to " << m_LUTFile << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void EICG4B0MomentumReco::FindTracks(std::vector<Track> &tracks)
+{
+  // clusters by layer, the layers ordered along z
+  std::map<int, std::vector<Point>> bylayer;
+  for (TrkrDefs::hitsetkey hitsetkey : m_Clusters->getHitSetKeys())
+  {
+    std::vector<Point> &points = bylayer[TrkrDefs::getLayer(hitsetkey)];
+    TrkrClusterContainer::ConstRange range = m_Clusters->getClusters(hitsetkey);
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      points.push_back({iter->first, {iter->second->getX(), iter->second->getY(), iter->second->getZ()}});
+    }
+  }
+  std::vector<std::vector<Point>> layers;
+  for (auto &iter : bylayer)
+  {
+    if (!iter.second.empty())
+    {
+      layers.push_back(iter.second);
+    }
+  }
+  std::sort(layers.begin(), layers.end(), [](const std::vector<Point> &a, const std::vector<Point> &b) { return a.front().pos[2] < b.front().pos[2]; });
+  if (layers.size() < 3)
+  {
+    return;
+  }
+
+  std::vector<Track> candidates;
+  for (const Point &first : layers.front())
+  {
+    for (const Point &last : layers.back())
+    {
+      const double dz = last.pos[2] - first.pos[2];
+      if (dz <= 0)
+      {
+        continue;
+      }
+      Track track;
+      track.clusters.push_back(first.key);
+      for (unsigned int i = 1; i < layers.size() - 1; i++)
+      {
+        const Point *best = nullptr;
+        double bestdist = m_RoadWidth;
+        for (const Point &point : layers[i])
+        {
+          const double frac = (point.pos[2] - first.pos[2]) / dz;
+          const double dx = point.pos[0] - (first.pos[0] + frac * (last.pos[0] - first.pos[0]));
+          const double dy = point.pos[1] - (first.pos[1] + frac * (last.pos[1] - first.pos[1]));
+          const double dist = std::sqrt(dx * dx + dy * dy);
+          if (dist < bestdist)
+          {
+            bestdist = dist;
+            best = &point;
+          }
+        }
+        if (best)
+        {
+          track.clusters.push_back(best->key);
+        }
+      }
+      track.clusters.push_back(last.key);
+      if (track.clusters.size() >= 3 && Fit(track))
+      {
+        candidates.push_back(track);
+      }
+    }
+  }
+
+  // best candidates first, clusters are used only once
+  std::sort(candidates.begin(), candidates.end(), [](const Track &a, const Track &b) { return a.chi2 / a.clusters.size() < b.chi2 / b.clusters.size(); });
+  std::set<TrkrDefs::cluskey> used;
+  for (const Track &track : candidates)
+  {
+    if (std::none_of(track.clusters.begin(), track.clusters.end(), [&used](TrkrDefs::cluskey key) { return used.count(key); }))
+    {
+      used.insert(track.clusters.begin(), track.clusters.end());
+      tracks.push_back(track);
+    }
+  }
+}
+
+bool EICG4B0MomentumReco::Fit(Track &track) const
+{
+  // x = a + b u + c u^2 and y = d + e u with u = z - reference z
+  double sx[3][3] = {{0.}};
+  double rx[3] = {0.};
+  double sy[2][2] = {{0.}};
+  double ry[2] = {0.};
+  std::vector<std::array<double, 3>> points;
+  for (TrkrDefs::cluskey key : track.clusters)
+  {
+    const TrkrCluster *cluster = m_Clusters->findCluster(key);
+    const double u = cluster->getZ() - m_ReferenceZ;
+    const double powers[3] = {1., u, u * u};
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        sx[i][j] += powers[i] * powers[j];
+      }
+      rx[i] += powers[i] * cluster->getX();
+    }
+    for (int i = 0; i < 2; i++)
+    {
+      for (int j = 0; j < 2; j++)
+      {
+        sy[i][j] += powers[i] * powers[j];
+      }
+      ry[i] += powers[i] * cluster->getY();
+    }
+    points.push_back({u, cluster->getX(), cluster->getY()});
+  }
+  const double detx = Det3(sx);
+  const double dety = sy[0][0] * sy[1][1] - sy[0][1] * sy[1][0];
+  if (std::abs(detx) < 1e-12 || std::abs(dety) < 1e-12)
+  {
+    return false;
+  }
+  // Cramer's rule
+  double parx[3];
+  for (int k = 0; k < 3; k++)
+  {
+    double m[3][3];
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        m[i][j] = (j == k) ? rx[i] : sx[i][j];
+      }
+    }
+    parx[k] = Det3(m) / detx;
+  }
+  const double pary[2] = {(ry[0] * sy[1][1] - sy[0][1] * ry[1]) / dety,
+                          (sy[0][0] * ry[1] - ry[0] * sy[1][0]) / dety};
+  track.par[0] = parx[0];
+  track.par[1] = parx[1];
+  track.par[2] = pary[0];
+  track.par[3] = pary[1];
+  track.chi2 = 0.;
+  for (const auto &point : points)
+  {
+    const double dx = point[1] - (parx[0] + parx[1] * point[0] + parx[2] * point[0] * point[0]);
+    const double dy = point[2] - (pary[0] + pary[1] * point[0]);
+    track.chi2 += dx * dx + dy * dy;
+  }
+  return true;
+}
+
+bool EICG4B0MomentumReco::Lookup(const TProfile2D *lut, const double x, const double slope, double &value)
+{
+  const int ix = lut->GetXaxis()->FindFixBin(x);
+  const int iy = lut->GetYaxis()->FindFixBin(slope);
+  if (ix < 1 || ix > lut->GetNbinsX() || iy < 1 || iy > lut->GetNbinsY())
+  {
+    return false;
+  }
+  const int bin = lut->GetBin(ix, iy);
+  if (lut->GetBinEntries(bin) <= 0)
+  {
+    return false;
+  }
+  value = lut->GetBinContent(bin);
+  return true;
+}
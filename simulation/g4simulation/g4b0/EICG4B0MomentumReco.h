@@ -0,0 +1,109 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef EICG4B0MOMENTUMRECO_H
+#define EICG4B0MOMENTUMRECO_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <trackbase/TrkrDefs.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class SvtxTrackMap;
+class TProfile2D;
+class TrkrClusterContainer;
+
+/**
+ * \brief fast momentum reconstruction for the B0 spectrometer from a
+ * lookup table
+ *
+ * Tracks are found in the clusters of EICG4B0Digitizer: every pair of
+ * clusters in the first and last plane with hits defines a straight road,
+ * the planes in between contribute the closest cluster inside the road. At
+ * least three planes are needed. x(z) (bending plane of the dipole) is fit
+ * with a parabola, y(z) with a straight line, and both are evaluated at the
+ * reference z. The lookup table maps (x, dx/dz) at the reference z to q/p
+ * and the horizontal angle at the vertex, (y, dy/dz) to the vertical angle.
+ *
+ * The table is built by the same module with set_build_lut(true) from
+ * single reference particles (e.g. protons with a flat momentum and angle
+ * distribution) tracked through the beamline geometry, the truth of the
+ * first primary particle is averaged in every bin and written at End.
+ * Tracks go to SvtxTrackMap_<detector>, with the momentum at the vertex
+ * (0, 0, 0).
+ */
+class EICG4B0MomentumReco : public SubsysReco
+{
+ public:
+  EICG4B0MomentumReco(const std::string &name = "EICG4B0MomentumReco", const std::string &lutfile = "B0MomentumLUT.root");
+  ~EICG4B0MomentumReco() override;
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  //! writes the lookup table in build mode
+  int End(PHCompositeNode *topNode) override;
+
+  /** Name used for the cluster and track nodes.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  void set_build_lut(const bool b) { m_BuildLUT = b; }
+  //! z (cm) at which the track parameters are evaluated, e.g. the first plane
+  void set_reference_z(const double z) { m_ReferenceZ = z; }
+  //! largest distance (cm) of a cluster from the straight road
+  void set_road_width(const double w) { m_RoadWidth = w; }
+  //! binning of the lookup table in position (cm) and slope at the reference z
+  void set_lut_bins(const int npos, const double posmin, const double posmax,
+                    const int nslope, const double slopemin, const double slopemax)
+  {
+    m_NPosBins = npos;
+    m_PosRange[0] = posmin;
+    m_PosRange[1] = posmax;
+    m_NSlopeBins = nslope;
+    m_SlopeRange[0] = slopemin;
+    m_SlopeRange[1] = slopemax;
+  }
+
+ private:
+  struct Track
+  {
+    std::vector<TrkrDefs::cluskey> clusters;
+    //! x, dx/dz, y, dy/dz at the reference z
+    double par[4] = {0., 0., 0., 0.};
+    //! sum of the squared residuals (cm^2)
+    double chi2 = 0.;
+  };
+
+  void FindTracks(std::vector<Track> &tracks);
+  //! fits the clusters, false if the fit is not possible
+  bool Fit(Track &track) const;
+
+  //! lookup table value at the bin of x, slope, false if the bin is empty
+  static bool Lookup(const TProfile2D *lut, const double x, const double slope, double &value);
+
+  TrkrClusterContainer *m_Clusters = nullptr;
+  SvtxTrackMap *m_TrackMap = nullptr;
+
+  std::string m_Detector = "B0";
+  std::string m_LUTFile;
+  bool m_BuildLUT = false;
+
+  double m_ReferenceZ = 590.;
+  double m_RoadWidth = 1.;
+
+  int m_NPosBins = 100;
+  double m_PosRange[2] = {-40., 40.};
+  int m_NSlopeBins = 100;
+  double m_SlopeRange[2] = {-0.05, 0.05};
+
+  //! (x, dx/dz) -> q/p (1/GeV), horizontal angle; (y, dy/dz) -> vertical angle
+  TProfile2D *m_QOverP = nullptr;
+  TProfile2D *m_ThetaX = nullptr;
+  TProfile2D *m_ThetaY = nullptr;
+};
+
+#endif  // EICG4B0MOMENTUMRECO_H
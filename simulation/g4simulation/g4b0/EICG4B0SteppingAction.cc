@@ -24,6 +24,8 @@
 
 #include <g4detectors/PHG4StepStatusDecode.h>
 
+#include <g4eicutils/PHG4TrackKiller.h>
+
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Hitv1.h>
@@ -75,6 +77,7 @@ EICG4B0SteppingAction::EICG4B0SteppingAction(EICG4B0Detector *detector, const PH
   , m_BlackHoleFlag(m_Params->get_int_param("blackhole"))
   , m_EdepSum(0)
   , m_EionSum(0)
+  , m_TrackKiller(new PHG4TrackKiller(parameters))
 {
 }
 
@@ -86,6 +89,8 @@ EICG4B0SteppingAction::~EICG4B0SteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  m_TrackKiller->Print(GetName());
+  delete m_TrackKiller;
 }
 
 //____________________________________________________________________________..
@@ -116,6 +121,11 @@ bool EICG4B0SteppingAction::UserSteppingAction(const G4Step *aStep, bool was_use
     G4Track *killtrack = const_cast<G4Track *>(aTrack);
     killtrack->SetTrackStatus(fStopAndKill);
   }
+  // slow neutrons etc. which are too late for the readout
+  else
+  {
+    m_TrackKiller->Apply(const_cast<G4Track *>(aTrack));
+  }
   // we use here only one detector in this simple example
   // if you deal with multiple detectors in this stepping action
   // the detector id can be used to distinguish between them
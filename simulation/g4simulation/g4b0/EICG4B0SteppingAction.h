@@ -12,6 +12,7 @@ class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4Hit;
 class PHG4HitContainer;
+class PHG4TrackKiller;
 class PHParameters;
 
 class EICG4B0SteppingAction : public PHG4SteppingAction
@@ -47,6 +48,8 @@ class EICG4B0SteppingAction : public PHG4SteppingAction
   int m_BlackHoleFlag;
   double m_EdepSum;
   double m_EionSum;
+
+  PHG4TrackKiller* m_TrackKiller;
 };
 
 #endif  // EICG4B0STEPPINGACTION_H
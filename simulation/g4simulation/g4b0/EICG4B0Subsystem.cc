@@ -123,4 +123,10 @@ void EICG4B0Subsystem::SetDefaultParameters()
   set_default_int_param("ispipe", 0);               //pipe or detector (for future implementation)
 
   set_default_string_param("material", "G4_PbWO4");  //detector material
+
+  // kill the particles in kill_particles (comma separated G4 names) after
+  // kill_time (ns) or below kill_ekin (GeV), values <= 0 disable the cut
+  set_default_string_param("kill_particles", "neutron");
+  set_default_double_param("kill_time", -1.);
+  set_default_double_param("kill_ekin", -1.);
 }
@@ -56,6 +56,32 @@ int BeastMagnetDetector::IsInDetector(G4VPhysicalVolume *volume) const
 
 //_______________________________________________________________
 void BeastMagnetDetector::ConstructMe(G4LogicalVolume *logicWorld)
+{
+  vector<PHG4GeometryCache::Placement> placed;
+  unique_ptr<PHG4GeometryCache> cache;
+  if (!m_Params->get_string_param("GeometryCache").empty())
+  {
+    cache.reset(new PHG4GeometryCache(m_Params->get_string_param("GeometryCache")));
+    cache->Verbosity(Verbosity());
+    cache->AddSourceFile(m_GDMPath);
+    cache->AddKey(m_TopVolName);
+  }
+  if (!cache || !cache->Load(logicWorld, placed))
+  {
+    ConstructFromGDML(logicWorld, placed);
+    if (cache)
+    {
+      cache->Save(placed);
+    }
+  }
+  for (auto &p : placed)
+  {
+    InsertVolumes(p.first);
+  }
+  return;
+}
+
+void BeastMagnetDetector::ConstructFromGDML(G4LogicalVolume *logicWorld, vector<PHG4GeometryCache::Placement> &placed)
 {
   unique_ptr<G4GDMLReadStructure> reader(new G4GDMLReadStructure());
   G4GDMLParser gdmlParser(reader.get());
@@ -81,7 +107,7 @@ void BeastMagnetDetector::ConstructMe(G4LogicalVolume *logicWorld)
   vector<G4VPhysicalVolume *>::iterator it = avol->GetVolumesIterator();
   for (unsigned int i = 0; i < avol->TotalImprintedVolumes(); i++)
   {
-    InsertVolumes(*it);
+    placed.push_back(make_pair(*it, 0));
     ++it;
   }
 
@@ -3,10 +3,13 @@
 #ifndef BEASTMAGNETDETECTOR_H
 #define BEASTMAGNETDETECTOR_H
 
+#include <g4eicutils/PHG4GeometryCache.h>
+
 #include <g4main/PHG4Detector.h>
 
 #include <set>
 #include <string>  // for string
+#include <vector>
 
 class BeastMagnetDisplayAction;
 class G4LogicalVolume;
@@ -38,6 +41,8 @@ class BeastMagnetDetector : public PHG4Detector
   const std::string SuperDetector() const { return m_SuperDetector; }
 
  private:
+  //! parse the GDML file and imprint the top assembly in the world
+  void ConstructFromGDML(G4LogicalVolume *logicWorld, std::vector<PHG4GeometryCache::Placement> &placed);
   void InsertVolumes(G4VPhysicalVolume *physvol);
   BeastMagnetDisplayAction *m_DisplayAction;
   PHParameters *m_Params;
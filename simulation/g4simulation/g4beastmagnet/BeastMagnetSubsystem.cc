@@ -134,4 +134,6 @@ void BeastMagnetSubsystem::SetDefaultParameters()
 
   set_default_string_param("GDMPath", "DefaultParameters-InvalidPath");
   set_default_string_param("TopVolName", "DefaultParameters-InvalidVol");
+  // binary cache of the volumes built from the GDML file, empty: no cache
+  set_default_string_param("GeometryCache", "");
 }
@@ -64,6 +64,12 @@ struct EICG4dRICHConfig
   double gas_n = 1.0008;   // gas refractive index, at reference wavelength
   double wavelength_ref = 400 * nm; // reference wavelength (for aerogel, gas, mirror ...)
 
+  // sensitive volumes: photosensors are always sensitive, the vessel is
+  // sensitive only if entrance/exit hits are wanted; activateAll restores
+  // the old behaviour where every volume of the tree is active
+  bool activateVessel = true;
+  bool activateAll = false;
+
   // Create a global messenger that will be used
   inline EICG4dRICHConfig() 
   {
@@ -142,6 +148,11 @@ struct EICG4dRICHConfig
       cmd4.SetParameterName("aerOptMod", true);
       cmd4.SetDefaultValue(3);
 
+      Messenger->DeclareProperty("ActivateVessel", activateVessel,
+                                 "Save hits on vessel entrance and exit");
+      Messenger->DeclareProperty("ActivateAll", activateAll,
+                                 "Mark every volume as active (slow, debugging only)");
+
       //      Messenger->DeclareProperty("GeometryFile", geometry_file, "Full
       //      path of Geometry configuration file (e.g. sensor array coordinates
       //      ...)");
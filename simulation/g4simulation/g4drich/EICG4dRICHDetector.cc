@@ -2,6 +2,8 @@
 #include "EICG4dRICHConfig.hh"
 #include "EICG4dRICHOptics.hh"
 
+#include <g4eicutils/PHG4GeometryCache.h>
+
 #include <fun4all/Fun4AllBase.h>
 
 #include <phparameter/PHParameters.h>
@@ -19,6 +21,10 @@
 
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 
 class G4VSolid;
 class PHCompositeNode;
@@ -28,15 +34,17 @@ EICG4dRICHDetector::EICG4dRICHDetector(PHG4Subsystem *subsys, PHCompositeNode *N
                                        PHParameters *parameters, const std::string &dnam)
   : PHG4Detector(subsys, Node, dnam)
   , m_Params(parameters)
+  , m_ActivateVessel(true)
+  , m_ActivateAll(false)
+  , m_Photosensor(nullptr)
 {
 }
 
 // ---------------------------------------------------
 int EICG4dRICHDetector::IsInDetector(G4VPhysicalVolume *volume) const
 {
-  std::set<G4VPhysicalVolume *>::const_iterator iter =
-      m_PhysicalVolumesSet.find(volume);
-  if (iter != m_PhysicalVolumesSet.end())
+  auto iter = m_VolumeInfoMap.find(volume);
+  if (iter != m_VolumeInfoMap.end() && iter->second.active)
   {
     return 1;
   }
@@ -48,6 +56,10 @@ void EICG4dRICHDetector::ConstructMe(G4LogicalVolume *logicWorld)
 {
   EICG4dRICHConfig cfg;
   cfg.model_file = m_Params->get_string_param("mapping_file");
+  cfg.activateVessel = m_Params->get_int_param("activate_vessel");
+  cfg.activateAll = m_Params->get_int_param("activate_all");
+  m_ActivateVessel = cfg.activateVessel;
+  m_ActivateAll = cfg.activateAll;
   if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[+] MODEL TEXT FILE: " << cfg.model_file << std::endl;
   // - check existence
   std::ifstream mf(cfg.model_file.data());
@@ -67,18 +79,37 @@ void EICG4dRICHDetector::ConstructMe(G4LogicalVolume *logicWorld)
   logicWorld->SetVisAttributes(G4VisAttributes::Invisible);
   // logicWorld->SetVisAttributes(vis);
 
-  // build detector by text file
-  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[+] read model text file" << std::endl;
-  G4tgbVolumeMgr *volmgr = G4tgbVolumeMgr::GetInstance();
-  volmgr->AddTextFile(cfg.model_file);
-  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[+] construct detector from text file" << std::endl;
-  G4VPhysicalVolume *vesselPhysVol = volmgr->ReadAndConstructDetector();
-  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE)
+  // optional binary cache of the volumes built from the text file, it
+  // depends on the text file and the placement
+  std::unique_ptr<PHG4GeometryCache> cache;
+  if (!m_Params->get_string_param("geometry_cache").empty())
   {
-    std::cout << "[+] detector summary" << std::endl;
-    volmgr->DumpSummary();
-    std::cout << "[+] detector G4Solid list" << std::endl;
-    volmgr->DumpG4SolidList();
+    cache.reset(new PHG4GeometryCache(m_Params->get_string_param("geometry_cache")));
+    cache->Verbosity(Verbosity());
+    cache->AddSourceFile(cfg.model_file);
+    std::ostringstream placement;
+    placement.precision(17);
+    for (const char *par : {"place_x", "place_y", "place_z", "rot_x", "rot_y", "rot_z"})
+    {
+      placement << m_Params->get_double_param(par) << " ";
+    }
+    cache->AddKey(placement.str());
+  }
+  std::vector<PHG4GeometryCache::Placement> placed;
+  G4VPhysicalVolume *vesselPhysVol = nullptr;
+  if (cache && cache->Load(logicWorld, placed) && placed.size() == 1)
+  {
+    vesselPhysVol = placed.front().first;
+  }
+  else
+  {
+    vesselPhysVol = ConstructFromTextFile(cfg.model_file, logicWorld);
+    if (cache)
+    {
+      // before the optical properties are attached to the materials
+      placed.assign(1, std::make_pair(vesselPhysVol, 0));
+      cache->Save(placed);
+    }
   }
 
   // material optical properties (see shared header EICG4dRICHOptics.hh)
@@ -97,12 +128,41 @@ void EICG4dRICHDetector::ConstructMe(G4LogicalVolume *logicWorld)
   auto gasPO = new EICG4dRICHGas("EICG4dRICHgasMat");
   gasPO->setOpticalParams();
   // - photo sensors
-  auto photoSensor = new EICG4dRICHPhotosensor("EICG4dRICHpsst");
-  photoSensor->setOpticalParams("EICG4dRICH");
+  m_Photosensor = new EICG4dRICHPhotosensor("EICG4dRICHpsst");
+  m_Photosensor->setOpticalParams("EICG4dRICH");
+  const std::string qeFile = m_Params->get_string_param("qe_file");
+  if (!qeFile.empty() && !m_Photosensor->readQE(qeFile))
+  {
+    std::cout << "ERROR in " << __FILE__ << ": cannot read the photosensor PDE from " << qeFile << std::endl;
+    exit(1);
+  }
   // - mirror (simular to photosensor, but different params)
   auto mirror = new EICG4dRICHMirror("EICG4dRICHmirror");
   mirror->setOpticalParams("EICG4dRICH");
 
+  // activate volumes, for hit readout
+  this->ActivateVolumeTree(vesselPhysVol);
+
+  return;
+}
+
+// ---------------------------------------------------
+// build the vessel from the text file and place it in the world
+G4VPhysicalVolume *EICG4dRICHDetector::ConstructFromTextFile(const std::string &model_file, G4LogicalVolume *logicWorld)
+{
+  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[+] read model text file" << std::endl;
+  G4tgbVolumeMgr *volmgr = G4tgbVolumeMgr::GetInstance();
+  volmgr->AddTextFile(model_file);
+  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[+] construct detector from text file" << std::endl;
+  G4VPhysicalVolume *vesselPhysVol = volmgr->ReadAndConstructDetector();
+  if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE)
+  {
+    std::cout << "[+] detector summary" << std::endl;
+    volmgr->DumpSummary();
+    std::cout << "[+] detector G4Solid list" << std::endl;
+    volmgr->DumpG4SolidList();
+  }
+
   G4RotationMatrix *rotation = new G4RotationMatrix(m_Params->get_double_param("rot_x") * deg,
                                                     m_Params->get_double_param("rot_y") * deg,
                                                     m_Params->get_double_param("rot_z") * deg);
@@ -117,18 +177,18 @@ void EICG4dRICHDetector::ConstructMe(G4LogicalVolume *logicWorld)
   // add to logical world
   logicWorld->AddDaughter(vesselPhysVol);
 
-  // activate volumes, for hit readout
-  this->ActivateVolumeTree(vesselPhysVol);
-
-  return;
+  return vesselPhysVol;
 }
 
 // ---------------------------------------------------
 // recursively add detectors to active volume list, descending the tree
 // from `volu`
+// - every volume gets an entry in `m_VolumeInfoMap` with its role, petal
+//   and photosensor number, so the stepping action never has to look
+//   at volume names
 // - use the "activation filter" to decide for which volumes to save hits
-// - the petal number is added to `m_PetalMap`, which together
-//   with the copy number, provides a unique ID for each photo sensor
+// - the petal number, together with the copy number, provides a unique
+//   ID for each photo sensor
 void EICG4dRICHDetector::ActivateVolumeTree(G4VPhysicalVolume *volu, G4int petal)
 {
   // get objects
@@ -136,26 +196,40 @@ void EICG4dRICHDetector::ActivateVolumeTree(G4VPhysicalVolume *volu, G4int petal
   G4int voluCopyNo = volu->GetCopyNo();
   G4LogicalVolume *logi = volu->GetLogicalVolume();
 
-  // obtain petal number
-  if (voluName.contains("petal"))
+  // obtain role and petal number
+  VolumeRole role = kOther;
+  if (voluName.contains("psst"))
+  {
+    role = kPSST;
+  }
+  else if (voluName.contains("petal"))
   {
+    role = kPetal;
     petal = voluCopyNo;
   }
+  else if (voluName.contains("vessel"))
+  {
+    role = kVessel;
+  }
 
   // activation filter: use this to decide which volumes to save
   // hits for, i.e., which volumes are "active"
-  // TODO: need to decide what volume we want to be active
-  G4bool activate = true;  // voluName.contains("psst") || voluName.contains("vessel");
-  if (activate)
+  // - photosensors are always active, photosensor hits are steps
+  //   from the petal into the sensor, so the stepping action picks
+  //   them up by role even though the petal itself stays passive
+  // - the vessel only if entrance/exit hits are wanted
+  G4bool activate = m_ActivateAll || role == kPSST || (m_ActivateVessel && role == kVessel);
+  if (activate && Verbosity() >= Fun4AllBase::VERBOSITY_SOME)
   {
-    if (Verbosity() >= Fun4AllBase::VERBOSITY_SOME)
-    {
-      std::cout << "[+] activate " << voluName << " petal " << petal << " copy "
-                << voluCopyNo << std::endl;
-    }
-    m_PhysicalVolumesSet.insert(volu);
-    m_PetalMap.insert(std::pair<G4VPhysicalVolume *, G4int>(volu, petal));
+    std::cout << "[+] activate " << voluName << " petal " << petal << " copy "
+              << voluCopyNo << std::endl;
   }
+  VolumeInfo info;
+  info.role = role;
+  info.active = activate;
+  info.petal = petal;
+  info.psst = (role == kPSST) ? voluCopyNo : 0;
+  m_VolumeInfoMap[volu] = info;
 
   // loop over daughters
   G4int nd = logi->GetNoDaughters();
@@ -167,27 +241,32 @@ void EICG4dRICHDetector::ActivateVolumeTree(G4VPhysicalVolume *volu, G4int petal
 
 // ---------------------------------------------------
 // get petal number
-int EICG4dRICHDetector::GetPetal(G4VPhysicalVolume *volu)
+int EICG4dRICHDetector::GetPetal(G4VPhysicalVolume *volu) const
 {
-  int petalNum;
-  try
-  {
-    petalNum = m_PetalMap.at(volu);
-  }
-  catch (const std::out_of_range &ex)
+  auto iter = m_VolumeInfoMap.find(volu);
+  if (iter == m_VolumeInfoMap.end())
   {
     std::cerr << "ERROR in EICG4dRICHDetector: cannot find petal associated with volume"
               << std::endl;
     return -1;
   }
-  return petalNum;
+  return iter->second.petal;
 }
 
 // ---------------------------------------------------
 // get PSST number
-int EICG4dRICHDetector::GetPSST(G4VPhysicalVolume *volu)
+int EICG4dRICHDetector::GetPSST(G4VPhysicalVolume *volu) const
+{
+  auto iter = m_VolumeInfoMap.find(volu);
+  return (iter != m_VolumeInfoMap.end()) ? iter->second.psst : 0;
+}
+
+// ---------------------------------------------------
+// get volume role, kNone for volumes outside of the dRICH
+EICG4dRICHDetector::VolumeRole EICG4dRICHDetector::GetVolumeRole(G4VPhysicalVolume *volu) const
 {
-  return volu->GetName().contains("psst") ? volu->GetCopyNo() : 0;
+  auto iter = m_VolumeInfoMap.find(volu);
+  return (iter != m_VolumeInfoMap.end()) ? iter->second.role : kNone;
 }
 
 // ---------------------------------------------------
@@ -4,10 +4,10 @@
 #include <g4main/PHG4Detector.h>
 
 #include <fstream>
-#include <map>
-#include <set>
 #include <string>  // for string
+#include <unordered_map>
 
+class EICG4dRICHPhotosensor;
 class G4LogicalVolume;
 class G4VPhysicalVolume;
 class PHCompositeNode;
@@ -17,6 +17,16 @@ class PHParameters;
 class EICG4dRICHDetector : public PHG4Detector
 {
  public:
+  //! role of a volume in the dRICH tree, used to classify steps
+  enum VolumeRole
+  {
+    kNone = 0, /* not part of the dRICH */
+    kVessel,
+    kPetal,
+    kPSST,
+    kOther
+  };
+
   //! constructor
   EICG4dRICHDetector(PHG4Subsystem *subsys, PHCompositeNode *Node,
                      PHParameters *parameters, const std::string &dnam);
@@ -38,18 +48,38 @@ class EICG4dRICHDetector : public PHG4Detector
   void ActivateVolumeTree(G4VPhysicalVolume *volu, G4int petal = 0);
 
   // access detector numbers, for the given volume
-  int GetPetal(G4VPhysicalVolume *volu);
-  int GetPSST(G4VPhysicalVolume *volu);
+  int GetPetal(G4VPhysicalVolume *volu) const;
+  int GetPSST(G4VPhysicalVolume *volu) const;
+  VolumeRole GetVolumeRole(G4VPhysicalVolume *volu) const;
+
+  // photosensor optics, provides the QE lookup for the stacking action
+  const EICG4dRICHPhotosensor *GetPhotosensor() const { return m_Photosensor; }
 
   void SuperDetector(const std::string &name) { m_SuperDetector = name; }
   const std::string SuperDetector() const { return m_SuperDetector; }
 
  private:
+  // build the vessel from the text file and place it in the world
+  G4VPhysicalVolume *ConstructFromTextFile(const std::string &model_file, G4LogicalVolume *logicWorld);
+
   PHParameters *m_Params;
 
-  // active volumes
-  std::set<G4VPhysicalVolume *> m_PhysicalVolumesSet;
-  std::map<G4VPhysicalVolume *, G4int> m_PetalMap;
+  // per volume info, filled once in ActivateVolumeTree
+  struct VolumeInfo
+  {
+    VolumeRole role;
+    bool active;
+    int petal;
+    int psst;
+  };
+
+  // flags which volumes are sensitive, see EICG4dRICHConfig
+  bool m_ActivateVessel;
+  bool m_ActivateAll;
+
+  EICG4dRICHPhotosensor *m_Photosensor;
+
+  std::unordered_map<G4VPhysicalVolume *, VolumeInfo> m_VolumeInfoMap;
 
   std::string m_SuperDetector;
 };
@@ -7,6 +7,7 @@
 #include <G4Color.hh>
 #include <G4Element.hh>
 #include <G4LogicalSkinSurface.hh>
+#include <G4LogicalVolumeStore.hh>
 #include <G4Material.hh>
 #include <G4MaterialPropertiesTable.hh>
 #include <G4OpticalSurface.hh>
@@ -17,12 +18,73 @@
 #include <G4tgbVolumeMgr.hh>
 #include <G4PVDivision.hh>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 /*
  * Service Classes
  */
 
+//
+// Linear interpolation on a sorted table, binary search for the bin
+// values outside of the table are clamped to the first/last point
+//
+inline double EICG4dRICHlinint(double val, int n, const double *x, const double *y)
+{
+  if (val <= x[0]) return y[0];
+  if (val >= x[n - 1]) return y[n - 1];
+  int i = std::upper_bound(x, x + n, val) - x - 1;
+  return (y[i + 1] - y[i]) / (x[i + 1] - x[i]) * (val - x[i]) + y[i];
+}
+
+//
+// Uniform grid lookup table: the (x,y) points are resampled once, each
+// eval() is then a single bin computation, to be used in per-track code
+// (e.g. the stacking action)
+//
+class EICG4dRICHTable
+{
+  public:
+    void build(int n, const double *x, const double *y, int nBins = 1000)
+    {
+      xMin = x[0];
+      xMax = x[n - 1];
+      step = (xMax - xMin) / nBins;
+      table.resize(nBins + 1);
+      for (int i = 0; i <= nBins; i++)
+      {
+        table[i] = EICG4dRICHlinint(xMin + i * step, n, x, y);
+      }
+    }
+
+    double eval(double val) const
+    {
+      if (table.empty()) return 0.;
+      if (val <= xMin) return table.front();
+      if (val >= xMax) return table.back();
+      double fbin = (val - xMin) / step;
+      unsigned int i = fbin;
+      if (i + 1 >= table.size()) return table.back();
+      return table[i] + (table[i + 1] - table[i]) * (fbin - i);
+    }
+
+    double max() const
+    {
+      return table.empty() ? 0. : *std::max_element(table.begin(), table.end());
+    }
+
+  private:
+    double xMin = 0.;
+    double xMax = 0.;
+    double step = 1.;
+    std::vector<double> table;
+};
+
 //
 // Generic optical parameters class
 //
@@ -68,7 +130,8 @@ class EICG4dRICHOptics : public SubsysReco
       {
         if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "# Material " << matName.data() << std::endl;
 
-        mat = G4tgbMaterialMgr::GetInstance()->FindBuiltG4Material(matName);
+        // from the material table, the volumes may come from the geometry cache
+        mat = G4Material::GetMaterial(matName, false);
 
         if (mat == NULL) 
         {
@@ -98,7 +161,7 @@ class EICG4dRICHOptics : public SubsysReco
       if (logVolName != "_NA_") 
       {
         if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "# Logical Volume " << logVolName.data() << std::endl;
-        logVolume = G4tgbVolumeMgr::GetInstance()->FindG4LogVol(logVolName, 0);
+        logVolume = G4LogicalVolumeStore::GetInstance()->GetVolume(logVolName, false);
         if (logVolume == NULL) 
         {
           std::cout << "# ERROR: Cannot retrieve " << logVolName.data() << " logical volume in EICG4dRICH" << std::endl;
@@ -173,16 +236,7 @@ class EICG4dRICHOptics : public SubsysReco
     // Linear Interpolation method
     double linint(double val, int n, const double *x, const double *y) 
     {
-      if (val <= x[0]) return y[0];
-      if (val >= x[n - 1]) return y[n - 1];
-      for (int i = 0; i < (n - 1); i++) 
-      {
-        if ((val >= x[i]) && (val < x[i + 1])) 
-        {
-          return (y[i + 1] - y[i]) / (x[i + 1] - x[i]) * (val - x[i]) + y[i];
-        }
-      }
-      return 0.;
+      return EICG4dRICHlinint(val, n, x, y);
     } 
 };
 
@@ -743,8 +797,79 @@ class EICG4dRICHPhotosensor : public EICG4dRICHOptics
 
       new G4LogicalSkinSurface(skinSurfaceName, logVolume, pOps);
 
+      setFlatQE();
+
       return 2;
     }
+
+    // photon detection efficiency at wavelength wl (G4 units), O(1)
+    double getQE(double wl) const { return qeTable.eval(wl); }
+
+    // highest photon detection efficiency over the whole spectrum
+    double getMaxQE() const { return qeTable.max(); }
+
+    // photon detection efficiency table (wavelengths in G4 units), replaces
+    // the flat PDE = 1 which matches the surface EFFICIENCY above
+    void setQE(int n, const double *wl, const double *pde)
+    {
+      qeTable.build(n, wl, pde);
+    }
+
+    // reads the PDE of the sensor from a text file, one "wavelength(nm) PDE"
+    // pair per line in any order, lines starting with # are skipped; false
+    // if the file cannot be read or a wavelength appears twice
+    bool readQE(const std::string &fileName)
+    {
+      std::ifstream fin(fileName);
+      if (!fin)
+      {
+        return false;
+      }
+      std::vector<std::pair<double, double>> points;
+      std::string line;
+      while (std::getline(fin, line))
+      {
+        std::istringstream sline(line);
+        double w, q;
+        if (line.empty() || line[0] == '#' || !(sline >> w >> q))
+        {
+          continue;
+        }
+        points.push_back(std::make_pair(w * nm, q));
+      }
+      if (points.size() < 2)
+      {
+        std::cout << "# ERROR: less than two PDE points in " << fileName << std::endl;
+        return false;
+      }
+      // the interpolation needs strictly increasing wavelengths
+      std::sort(points.begin(), points.end());
+      std::vector<double> wl;
+      std::vector<double> pde;
+      for (const auto &point : points)
+      {
+        if (!wl.empty() && point.first <= wl.back())
+        {
+          std::cout << "# ERROR: wavelength " << point.first / nm << " nm appears twice in " << fileName << std::endl;
+          return false;
+        }
+        wl.push_back(point.first);
+        pde.push_back(point.second);
+      }
+      setQE(wl.size(), wl.data(), pde.data());
+      return true;
+    }
+
+  private:
+    // no sensor response is assumed until a measured PDE is loaded
+    void setFlatQE()
+    {
+      const double qeWL[] = {100 * nm, 1000 * nm};
+      const double qeVal[] = {1., 1.};
+      setQE(2, qeWL, qeVal);
+    }
+
+    EICG4dRICHTable qeTable;
 };
 
 #endif // G4E_CI_DRICH_MODEL_HH
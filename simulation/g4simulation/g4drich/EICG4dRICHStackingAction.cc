@@ -0,0 +1,76 @@
+#include "EICG4dRICHStackingAction.h"
+#include "EICG4dRICHDetector.h"
+#include "EICG4dRICHOptics.hh"
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/PHRandomSeed.h>
+
+#include <G4OpticalPhoton.hh>
+#include <G4PhysicalConstants.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4Track.hh>
+
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>
+#include <iostream>
+
+//____________________________________________________________________________..
+EICG4dRICHStackingAction::EICG4dRICHStackingAction(EICG4dRICHDetector *detector,
+                                                   const PHParameters *parameters)
+  : PHG4StackingAction(detector->GetName())
+  , m_Detector(detector)
+  , m_SafetyFactor(parameters->get_double_param("qe_safety_factor"))
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+}
+
+//____________________________________________________________________________..
+EICG4dRICHStackingAction::~EICG4dRICHStackingAction()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+//____________________________________________________________________________..
+G4ClassificationOfNewTrack EICG4dRICHStackingAction::ClassifyNewTrack(const G4Track *aTrack)
+{
+  if (aTrack->GetDefinition() != G4OpticalPhoton::OpticalPhotonDefinition())
+  {
+    return fUrgent;
+  }
+  // only photons produced in the dRICH radiators
+  if (m_Detector->GetVolumeRole(aTrack->GetVolume()) == EICG4dRICHDetector::kNone)
+  {
+    return fUrgent;
+  }
+  const EICG4dRICHPhotosensor *sensor = m_Detector->GetPhotosensor();
+  if (!sensor)
+  {
+    return fUrgent;
+  }
+
+  double wl = h_Planck * c_light / aTrack->GetTotalEnergy();
+  double prob = std::min(1., m_SafetyFactor * sensor->getQE(wl));
+  if (gsl_rng_uniform(m_RandomGenerator) >= prob)
+  {
+    m_KilledPhotons++;
+    return fKill;
+  }
+  m_KeptPhotons++;
+  return fUrgent;
+}
+
+//____________________________________________________________________________..
+void EICG4dRICHStackingAction::PrepareNewEvent()
+{
+  if (Verbosity())
+  {
+    std::cout << "EICG4dRICHStackingAction: optical photons kept: " << m_KeptPhotons
+              << ", killed: " << m_KilledPhotons << std::endl;
+  }
+  m_KeptPhotons = 0;
+  m_KilledPhotons = 0;
+  return;
+}
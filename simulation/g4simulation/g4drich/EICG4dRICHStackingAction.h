@@ -0,0 +1,42 @@
+#ifndef DRICHSTACKINGACTION_H
+#define DRICHSTACKINGACTION_H
+
+#include <g4main/PHG4StackingAction.h>
+
+#include <G4UserStackingAction.hh>
+
+#include <gsl/gsl_rng.h>
+
+class EICG4dRICHDetector;
+class PHParameters;
+
+/**
+ * \brief kill optical photons at creation according to the photosensor QE
+ *
+ * Each Cherenkov photon produced inside the dRICH is kept with probability
+ * min(1, qe_safety_factor * QE(lambda)), the QE is taken from the
+ * EICG4dRICHPhotosensor lookup table. A safety factor > 1 keeps more
+ * photons than would be detected (the remaining QE has then to be applied
+ * offline), a very large one keeps the full photon sample.
+ */
+class EICG4dRICHStackingAction : public PHG4StackingAction
+{
+ public:
+  //! constructor
+  EICG4dRICHStackingAction(EICG4dRICHDetector *detector, const PHParameters *parameters);
+
+  //! destructor
+  ~EICG4dRICHStackingAction() override;
+
+  G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track *aTrack) override;
+  void PrepareNewEvent() override;
+
+ private:
+  gsl_rng *m_RandomGenerator = nullptr;
+  EICG4dRICHDetector *m_Detector = nullptr;
+  double m_SafetyFactor = 1.;
+  unsigned int m_KeptPhotons = 0;
+  unsigned int m_KilledPhotons = 0;
+};
+
+#endif  // DRICHSTACKINGACTION_H
@@ -117,11 +117,9 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
     return false;
   }
 
-  // get volume names
-  G4String prePointVolName = prePoint->GetPhysicalVolume()->GetName();
-  G4String postPointVolName = postPoint->GetPhysicalVolume()->GetName();
-  G4String preTouchVolName = preVol->GetName();
-  G4String postTouchVolName = postVol->GetName();
+  // get volume roles, precomputed by the detector
+  EICG4dRICHDetector::VolumeRole preRole = m_Detector->GetVolumeRole(preVol);
+  EICG4dRICHDetector::VolumeRole postRole = m_Detector->GetVolumeRole(postVol);
 
   // get track
   const G4Track *aTrack = aStep->GetTrack();
@@ -139,8 +137,8 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
   int whichactive = m_Detector->IsInDetector(preVol);
   if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE)
   {
-    std::cout << "[_] step preVol=" << preTouchVolName
-              << ", postVol=" << postTouchVolName << ", whichactive=" << whichactive
+    std::cout << "[_] step preVol=" << preVol->GetName()
+              << ", postVol=" << postVol->GetName() << ", whichactive=" << whichactive
               << std::endl;
   }
 
@@ -148,16 +146,17 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
   //hitType = -1;
   //hitSubtype = -1;
 
-  // classify hit type
-  if (prePointVolName.contains("DRICHpetal") && postPointVolName.contains("DRICHpsst"))
+  // classify hit type; the vessel is placed directly in the world, so
+  // anything outside of the dRICH next to the vessel is the world
+  if (preRole == EICG4dRICHDetector::kPetal && postRole == EICG4dRICHDetector::kPSST)
   {
     hitType = hPSST;
   }
-  else if (prePointVolName.contains("World") && postPointVolName.contains("DRICHvessel"))
+  else if (preRole == EICG4dRICHDetector::kNone && postRole == EICG4dRICHDetector::kVessel && m_Detector->IsInDetector(postVol))
   {
     hitType = hEntrance;
   }
-  else if (prePointVolName.contains("DRICHvessel") && postPointVolName.contains("World"))
+  else if (preRole == EICG4dRICHDetector::kVessel && postRole == EICG4dRICHDetector::kNone && whichactive)
   {
     hitType = hExit;
   }
@@ -171,14 +170,31 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
     std::cout << "[__] step is ENTERING vessel" << std::endl;
   }
 
-  // skip this step, if it's outside the detector, and not an entrance
-  // or exit of the vessel
-  if (!whichactive && hitType != hEntrance && hitType != hExit)
+  // skip this step, if it's outside the active volumes, and not an
+  // entrance, exit or photosensor hit
+  if (!whichactive && hitType == hIgnore)
   {
     if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "... skip this step" << std::endl;
     return false;
   }
 
+  // only the sensitive volumes are active, so the earlier steps of this
+  // track may never have been seen; start a fresh hit for it
+  if (hitType != hIgnore && aTrack->GetTrackID() != m_SaveTrackId)
+  {
+    if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << "[++++] NEW hit (first step seen)" << std::endl;
+    if (!m_Hit)
+    {
+      m_Hit = new EICG4dRICHHit();
+    }
+    else
+    {
+      m_Hit->Reset();
+    }
+    this->InitHit(prePoint, aTrack, true);
+    m_SavePostStepStatus = -1;
+  }
+
   // get step energy // TODO: do we need `eion`?
   G4double edep = 0;
   G4double eion = 0;
@@ -233,7 +249,7 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
                   << std::endl;
         std::cout << "last track: " << m_SaveTrackId
                   << ", current trackid: " << aTrack->GetTrackID() << std::endl;
-        std::cout << "phys pre vol: " << preTouchVolName
+        std::cout << "phys pre vol: " << preVol->GetName()
                   << " post vol : " << postTouch->GetVolume()->GetName() << std::endl;
         std::cout << " previous phys pre vol: " << m_SaveVolPre->GetName()
                   << " previous phys post vol: " << m_SaveVolPost->GetName() << std::endl;
@@ -337,7 +353,7 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
               << PHG4StepStatusDecode::GetStepStatus(m_SavePostStepStatus) << std::endl;
     std::cout << "last track: " << m_SaveTrackId
               << ", current trackid: " << aTrack->GetTrackID() << std::endl;
-    std::cout << "phys pre vol: " << preTouchVolName
+    std::cout << "phys pre vol: " << preVol->GetName()
               << " post vol : " << postTouch->GetVolume()->GetName() << std::endl;
     std::cout << " previous phys pre vol: " << m_SaveVolPre->GetName()
               << " previous phys post vol: " << m_SaveVolPost->GetName() << std::endl;
@@ -392,7 +408,7 @@ bool EICG4dRICHSteppingAction::UserSteppingAction(const G4Step *aStep,
   {
     if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE)
     {
-      std::cout << "[---+] last step in the volume (pre=" << prePointVolName << ", post=" << postPointVolName << ")" << std::endl;
+      std::cout << "[---+] last step in the volume (pre=" << preVol->GetName() << ", post=" << postVol->GetName() << ")" << std::endl;
     }
 
     // hits to keep +++++++++++++++++++++++
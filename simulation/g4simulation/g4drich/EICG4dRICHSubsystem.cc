@@ -10,11 +10,13 @@
 //
 #include "EICG4dRICHSubsystem.h"
 #include "EICG4dRICHDetector.h"
+#include "EICG4dRICHStackingAction.h"
 #include "EICG4dRICHSteppingAction.h"
 
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4StackingAction.h>
 #include <g4main/PHG4SteppingAction.h>
 
 #include <phool/PHCompositeNode.h>
@@ -29,6 +31,7 @@ EICG4dRICHSubsystem::EICG4dRICHSubsystem(const std::string &name)
   : PHG4DetectorSubsystem(name)
   , m_Detector(nullptr)
   , m_SteppingAction(nullptr)
+  , m_StackingAction(nullptr)
 {
   // call base class method which will set up parameter infrastructure
   // and call our SetDefaultParameters() method
@@ -74,6 +77,17 @@ int EICG4dRICHSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
   {
     m_SteppingAction = new EICG4dRICHSteppingAction(m_Detector, GetParams());
   }
+  // kill photons which would not be detected right when they are created
+  if (GetParams()->get_int_param("qe_culling"))
+  {
+    if (GetParams()->get_string_param("qe_file").empty())
+    {
+      std::cout << "ERROR in " << __FILE__ << ": qe_culling needs the measured photosensor PDE in qe_file" << std::endl;
+      exit(1);
+    }
+    m_StackingAction = new EICG4dRICHStackingAction(m_Detector, GetParams());
+    m_StackingAction->Verbosity(Verbosity());
+  }
   return 0;
 }
 //_______________________________________________________________________
@@ -121,5 +135,18 @@ void EICG4dRICHSubsystem::SetDefaultParameters()
 
   //set_default_string_param("material", "G4_Cu");
 
+  // sensitive volumes: photosensors always, vessel for entrance/exit hits
+  set_default_int_param("activate_vessel", 1);
+  set_default_int_param("activate_all", 0);
+
+  // photons are killed at creation with probability 1 - qe_safety_factor * QE,
+  // off by default: all photons reaching the sensors make hits
+  set_default_int_param("qe_culling", 0);
+  set_default_double_param("qe_safety_factor", 1.);
+  // photosensor PDE, "wavelength(nm) PDE" per line, empty: PDE = 1
+  set_default_string_param("qe_file", "");
+
   set_default_string_param("mapping_file", m_geoFile.c_str());
+  // binary cache of the volumes built from the mapping file, empty: no cache
+  set_default_string_param("geometry_cache", "");
 }
@@ -6,6 +6,7 @@
 class PHCompositeNode;
 class PHG4Detector;
 class EICG4dRICHDetector;
+class PHG4StackingAction;
 class PHG4SteppingAction;
 
 /**
@@ -45,6 +46,8 @@ class EICG4dRICHSubsystem : public PHG4DetectorSubsystem
 
   PHG4SteppingAction *GetSteppingAction() const override { return m_SteppingAction; }
 
+  PHG4StackingAction *GetStackingAction() const override { return m_StackingAction; }
+
   void SetGeometryFile(const std::string &fileName) { m_geoFile = fileName; }
 
   //! Print info (from SubsysReco)
@@ -63,6 +66,9 @@ class EICG4dRICHSubsystem : public PHG4DetectorSubsystem
   /*! derives from PHG4SteppingActions */
   PHG4SteppingAction *m_SteppingAction;
 
+  //! optical photon QE culling at creation
+  PHG4StackingAction *m_StackingAction;
+
   std::string m_geoFile;
 };
 
@@ -1,5 +1,8 @@
 #include "PHG4BackwardHcalDetector.h"
 #include "PHG4BackwardHcalDisplayAction.h"
+#include "PHG4ShowerLibraryModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -14,6 +17,7 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4SystemOfUnits.hh>
 #include <Geant4/G4ThreeVector.hh>      // for G4ThreeVector
@@ -102,6 +106,14 @@ void PHG4BackwardHcalDetector::ConstructMe(G4LogicalVolume* logicWorld)
 
   m_DisplayAction->AddVolume(hcal_envelope_log, "FHcalEnvelope");
 
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(hcal_envelope_log);
+  if (!m_Params->get_string_param("showerlib_file").empty())
+  {
+    m_ShowerModel = new PHG4ShowerLibraryModel(GetName(), region, m_Params);
+  }
+
   /* Define rotation attributes for envelope cone */
   G4RotationMatrix hcal_rotm;
   hcal_rotm.rotateX(m_Params->get_double_param("rot_x") * deg);
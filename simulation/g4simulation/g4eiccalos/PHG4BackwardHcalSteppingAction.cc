@@ -1,6 +1,7 @@
 #include "PHG4BackwardHcalSteppingAction.h"
 
 #include "PHG4BackwardHcalDetector.h"
+#include "PHG4ShowerLibraryModel.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -60,15 +61,15 @@ PHG4BackwardHcalSteppingAction::~PHG4BackwardHcalSteppingAction()
 bool PHG4BackwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
 
-  // m_Detector->IsInBackwardHcal(volume)
-  // returns
+  // GetTowerIndex returns
   //  0 is outside of Forward HCAL
   //  1 is inside scintillator
   // -1 is inside absorber (dead material)
 
-  int whichactive = m_Detector->IsInBackwardHcal(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
@@ -76,9 +77,6 @@ bool PHG4BackwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, boo
   }
 
   int layer_id = m_Detector->get_Layer();
-  unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
-  int idx_j = icopy >> 16;
-  int idx_k = icopy & 0xFFFF;
 
   /* Get energy deposited by this step */
   double edep = aStep->GetTotalEnergyDeposit() / GeV;
@@ -267,6 +265,46 @@ bool PHG4BackwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, boo
   }
 }
 
+//____________________________________________________________________________..
+int PHG4BackwardHcalSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInBackwardHcal(touch->GetVolume());
+  if (whichactive)
+  {
+    unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
+    idx_j = icopy >> 16;
+    idx_k = icopy & 0xFFFF;
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+void PHG4BackwardHcalSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_HitContainer : m_AbsorberHitContainer;
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_Layer(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4BackwardHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -300,4 +338,8 @@ void PHG4BackwardHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNo
       std::cout << "PHG4BackwardHcalSteppingAction::SetTopNode - unable to find " << absorbernodename << std::endl;
     }
   }
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
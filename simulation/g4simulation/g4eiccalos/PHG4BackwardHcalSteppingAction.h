@@ -3,12 +3,16 @@
 #ifndef G4DETECTORS_PHG4BACKWARDHCALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4BACKWARDHCALSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 #include <Geant4/G4TouchableHandle.hh>
 
 class G4Step;
+class G4Track;
 class G4VPhysicalVolume;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4BackwardHcalDetector;
 class PHG4Hit;
@@ -16,7 +20,7 @@ class PHG4HitContainer;
 class PHG4Shower;
 class PHParameters;
 
-class PHG4BackwardHcalSteppingAction : public PHG4SteppingAction
+class PHG4BackwardHcalSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -31,6 +35,12 @@ class PHG4BackwardHcalSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
+  //! tower index from the copy numbers, returns IsInBackwardHcal() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! hits of the frozen showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
  private:
   //! pointer to the detector
   PHG4BackwardHcalDetector* m_Detector = nullptr;
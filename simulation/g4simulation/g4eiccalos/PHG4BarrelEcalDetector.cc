@@ -1,5 +1,9 @@
 #include "PHG4BarrelEcalDetector.h"
 #include "PHG4BarrelEcalDisplayAction.h"
+#include "PHG4EMShowerModel.h"
+#include "PHG4LogicalVolumeCache.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -12,6 +16,7 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4ThreeVector.hh>      // for G4ThreeVector
 #include <Geant4/G4Transform3D.hh>      // for G4Transform3D
@@ -164,6 +169,14 @@ void PHG4BarrelEcalDetector::ConstructMe(G4LogicalVolume* logicWorld)
                                        "BCAL_SOLID", 0, 0, 0);
 
   m_DisplayAction->AddVolume(cylinder_logic, "BCalCylinder");
+
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(cylinder_logic);
+  if (m_Params->get_int_param("fastshower"))
+  {
+    m_ShowerModel = new PHG4EMShowerModel(GetName(), region, m_Params);
+  }
   
   std::string name_envelope = m_TowerLogicNamePrefix + "_envelope";
 
@@ -173,6 +186,10 @@ void PHG4BarrelEcalDetector::ConstructMe(G4LogicalVolume* logicWorld)
 
   gdml_config->exclude_physical_vol(phys_envelope);
   PlaceTower(cylinder_logic);
+  if (Verbosity() > 0)
+  {
+    m_VolumeCache.Print("PHG4BarrelEcalDetector");
+  }
 
   return;
 }
@@ -479,30 +496,49 @@ int PHG4BarrelEcalDetector::ParseParametersFromTable()
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructTower(std::map<std::string, towerposition>::iterator iterator)
 {
+  G4Material* material_shell = GetCarbonFiber();
+  assert(material_shell);
+  // the glass cutout is shifted depending on the tower rotation
+  const std::vector<G4double> dims = {iterator->second.sizex1, iterator->second.sizey1, iterator->second.sizex2, iterator->second.sizey2, iterator->second.sizez, iterator->second.pTheta, iterator->second.roty};
+  const std::string kind = (iterator->second.idx_k % 2 == 0) ? "Tower_Block1" : "Tower_Block2";
+  G4LogicalVolume* block_logic = m_VolumeCache.Find(kind, material_shell, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
   G4Trap *block_tower = GetTowerTrap(iterator);
-  G4Trap *block_glass = GetGlassTrapSubtract(iterator); 
+  G4Trap *block_glass = GetGlassTrapSubtract(iterator);
   G4ThreeVector shift = G4ThreeVector(-th*sin(iterator->second.roty - M_PI_2), 0, th/2*abs(cos(iterator->second.roty - M_PI_2)));
   G4VSolid* block_solid = new G4SubtractionSolid(G4String(string(iterator->first)  + string("_Envelope")), block_tower, block_glass, 0, shift);
-  G4Material* material_shell = GetCarbonFiber();
-  assert(material_shell);
-    
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_shell,
+
+  block_logic = new G4LogicalVolume(block_solid, material_shell,
                                                      G4String(string(iterator->first)  + string("_Tower")), 0, 0,
                                                      nullptr);
   m_AbsorberLogicalVolSet.insert(block_logic);
+  m_VolumeCache.Add(kind, material_shell, dims, block_logic);
   return block_logic;
 }
 
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructGlass(std::map<std::string, towerposition>::iterator iterator)
 {
-  G4Trap *block_solid = GetGlassTrap(iterator);   
   G4Material* material_glass = GetSciGlass();
   assert(material_glass);
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_glass,
+  const std::vector<G4double> dims = {iterator->second.sizex1, iterator->second.sizey1, iterator->second.sizex2, iterator->second.sizey2, iterator->second.sizez, iterator->second.pTheta};
+  const std::string kind = (iterator->second.idx_k % 2 == 0) ? "Glass_Block1" : "Glass_Block2";
+  G4LogicalVolume* block_logic = m_VolumeCache.Find(kind, material_glass, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
+  G4Trap *block_solid = GetGlassTrap(iterator);
+  block_logic = new G4LogicalVolume(block_solid, material_glass,
                                                      G4String(string(iterator->first) + string("_Glass")), 0, 0,
                                                      nullptr);
   m_ScintiLogicalVolSet.insert(block_logic);
+  m_VolumeCache.Add(kind, material_glass, dims, block_logic);
   return block_logic;
 }
 
@@ -621,12 +657,20 @@ G4Trap* PHG4BarrelEcalDetector::GetSiTrap(std::map<std::string, towerposition>::
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructSi(std::map<std::string, towerposition>::iterator iterator)
 {
-  G4Trap *block_solid = GetSiTrap(iterator);   
   G4Material* material_si = G4Material::GetMaterial("G4_POLYSTYRENE");
   assert(material_si);
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_si,
+  const std::vector<G4double> dims = {iterator->second.sizex2, iterator->second.sizey2, iterator->second.pTheta};
+  G4LogicalVolume* block_logic = m_VolumeCache.Find("Si", material_si, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
+  G4Trap *block_solid = GetSiTrap(iterator);
+  block_logic = new G4LogicalVolume(block_solid, material_si,
                                                      G4String(string(iterator->first) + string("_solid_Si")), 0, 0,
                                                      nullptr);
+  m_VolumeCache.Add("Si", material_si, dims, block_logic);
   return block_logic;
 }
 
@@ -651,12 +695,20 @@ G4Trap* PHG4BarrelEcalDetector::GetKaptonTrap(std::map<std::string, towerpositio
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructKapton(std::map<std::string, towerposition>::iterator iterator)
 {
-  G4Trap *block_solid = GetKaptonTrap(iterator);   
   G4Material* material_kapton = G4Material::GetMaterial("G4_KAPTON");
   assert(material_kapton);
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_kapton,
+  const std::vector<G4double> dims = {iterator->second.sizex2, iterator->second.sizey2, iterator->second.pTheta};
+  G4LogicalVolume* block_logic = m_VolumeCache.Find("Kapton", material_kapton, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
+  G4Trap *block_solid = GetKaptonTrap(iterator);
+  block_logic = new G4LogicalVolume(block_solid, material_kapton,
                                                      G4String(string(iterator->first) + string("_solid_Si")), 0, 0,
                                                      nullptr);
+  m_VolumeCache.Add("Kapton", material_kapton, dims, block_logic);
   return block_logic;
 }
 
@@ -683,12 +735,20 @@ G4Trap* PHG4BarrelEcalDetector::GetSIO2Trap(std::map<std::string, towerposition>
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructSIO2(std::map<std::string, towerposition>::iterator iterator)
 {
-  G4Trap *block_solid = GetSIO2Trap(iterator);   
   G4Material* material_SIO2 = G4Material::GetMaterial("Quartz");
   assert(material_SIO2);
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_SIO2,
+  const std::vector<G4double> dims = {iterator->second.sizex2, iterator->second.sizey2, iterator->second.pTheta};
+  G4LogicalVolume* block_logic = m_VolumeCache.Find("SIO2", material_SIO2, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
+  G4Trap *block_solid = GetSIO2Trap(iterator);
+  block_logic = new G4LogicalVolume(block_solid, material_SIO2,
                                                      G4String(string(iterator->first) + string("_solid_material_SIO2")), 0, 0,
                                                      nullptr);
+  m_VolumeCache.Add("SIO2", material_SIO2, dims, block_logic);
   return block_logic;
 }
 
@@ -716,11 +776,20 @@ G4Trap* PHG4BarrelEcalDetector::GetCarbonTrap(std::map<std::string, towerpositio
 G4LogicalVolume*
 PHG4BarrelEcalDetector::ConstructCarbon(std::map<std::string, towerposition>::iterator iterator)
 {
-  G4Trap *block_solid = GetCarbonTrap(iterator);   
   G4Material* material_Carbon = G4Material::GetMaterial("G4_C");
   assert(material_Carbon);
-  G4LogicalVolume* block_logic = new G4LogicalVolume(block_solid, material_Carbon,
+  const std::vector<G4double> dims = {iterator->second.sizex2, iterator->second.sizey2, iterator->second.pTheta};
+  const std::string kind = (iterator->second.idx_k % 2 == 0) ? "Carbon_Block1" : "Carbon_Block2";
+  G4LogicalVolume* block_logic = m_VolumeCache.Find(kind, material_Carbon, dims);
+  if (block_logic)
+  {
+    return block_logic;
+  }
+
+  G4Trap *block_solid = GetCarbonTrap(iterator);
+  block_logic = new G4LogicalVolume(block_solid, material_Carbon,
                                                      G4String(string(iterator->first) + string("_solid_material_C")), 0, 0,
                                                      nullptr);
+  m_VolumeCache.Add(kind, material_Carbon, dims, block_logic);
   return block_logic;
 }
@@ -3,6 +3,8 @@
 #ifndef G4DETECTORS_PHG4BarrelEcalDETECTOR_H
 #define G4DETECTORS_PHG4BarrelEcalDETECTOR_H
 
+#include "PHG4LogicalVolumeCache.h"
+
 #include <g4main/PHG4Detector.h>
 
 #include <Geant4/G4Types.hh>  // for G4double
@@ -20,6 +22,7 @@ class G4Material;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4BarrelEcalDisplayAction;
+class PHG4EMShowerModel;
 class PHG4Subsystem;
 class PHParameters;
 class PHG4GDMLConfig;
@@ -50,6 +53,9 @@ class PHG4BarrelEcalDetector : public PHG4Detector
 
   int get_Layer() const { return m_Layer; }
 
+  //! parametrised EM showers, nullptr if not enabled
+  PHG4EMShowerModel *GetShowerModel() const { return m_ShowerModel; }
+
  private:
 
   //! BECAL parameters
@@ -113,6 +119,7 @@ class PHG4BarrelEcalDetector : public PHG4Detector
 
   PHG4BarrelEcalDisplayAction *m_DisplayAction = nullptr;
   PHParameters *m_Params = nullptr;
+  PHG4EMShowerModel *m_ShowerModel = nullptr;
 
   int m_ActiveFlag = 1;
   int m_AbsorberActiveFlag = 0;
@@ -131,6 +138,9 @@ class PHG4BarrelEcalDetector : public PHG4Detector
   std::set<G4LogicalVolume *> m_ScintiLogicalVolSet;
   std::set<G4LogicalVolume *> m_SupportLogicalVolSet;
 
+  //! towers of the same shape share their solids and logical volumes
+  PHG4LogicalVolumeCache m_VolumeCache;
+
   //! registry for volumes that should not be exported, i.e. fibers
   PHG4GDMLConfig* gdml_config = nullptr;
 };
@@ -1,5 +1,6 @@
 #include "PHG4BarrelEcalSteppingAction.h"
 #include "PHG4BarrelEcalDetector.h"
+#include "PHG4EMShowerModel.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -62,25 +63,21 @@ PHG4BarrelEcalSteppingAction::~PHG4BarrelEcalSteppingAction()
 bool PHG4BarrelEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
 
-  // m_Detector->IsInBarrelEcal(volume)
-  // returns
+  // GetTowerIndex returns
   //  0 is outside of Forward ECAL
   //  1 is inside scintillator
   // -1 is inside absorber (dead material)
 
-  int whichactive = m_Detector->IsInBarrelEcal(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
     return false;
   }
 
-   unsigned int icopy = touch->GetVolume(0)->GetCopyNo();
-  int idx_k = icopy >> 16;
-  int idx_j = icopy & 0xFFFF;
-
   int layer_id = m_Detector->get_Layer();
 
   /* Get energy deposited by this step */
@@ -241,6 +238,45 @@ bool PHG4BarrelEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   }
 }
 
+//____________________________________________________________________________..
+int PHG4BarrelEcalSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInBarrelEcal(touch->GetVolume());
+  if (whichactive)
+  {
+    unsigned int icopy = touch->GetVolume(0)->GetCopyNo();
+    idx_k = icopy >> 16;
+    idx_j = icopy & 0xFFFF;
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+void PHG4BarrelEcalSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_HitContainer : m_AbsorberHitContainer;
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_Layer(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
 
 //____________________________________________________________________________..
 void PHG4BarrelEcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
@@ -268,4 +304,8 @@ void PHG4BarrelEcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode
       std::cout << "PHG4BarrelEcalSteppingAction::SetTopNode - unable to find " << m_SupportNodeName << std::endl;
     }
   }
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
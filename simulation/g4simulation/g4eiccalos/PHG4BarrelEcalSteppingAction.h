@@ -3,9 +3,13 @@
 #ifndef G4DETECTORS_PHG4PHG4BARRELECALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4PHG4BARRELECALSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 class G4Step;
+class G4Track;
+class G4VTouchable;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4BarrelEcalDetector;
@@ -14,7 +18,7 @@ class PHG4HitContainer;
 class PHG4Shower;
 class PHParameters;
 
-class PHG4BarrelEcalSteppingAction : public PHG4SteppingAction
+class PHG4BarrelEcalSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -34,6 +38,12 @@ class PHG4BarrelEcalSteppingAction : public PHG4SteppingAction
   void SetAbsorberNodeName(const std::string& nam) { m_AbsorberNodeName = nam; }
   void SetSupportNodeName(const std::string& nam) { m_SupportNodeName = nam; }
 
+  //! tower index from the copy number, returns IsInBarrelEcal() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! hits of the parametrised EM showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
  private:
   //! pointer to the detector
   PHG4BarrelEcalDetector* m_Detector = nullptr;
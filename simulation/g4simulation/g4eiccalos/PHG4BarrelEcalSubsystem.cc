@@ -4,6 +4,8 @@
 #include "PHG4BarrelEcalDisplayAction.h"
 #include "PHG4BarrelEcalSteppingAction.h"
 
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
@@ -42,6 +44,12 @@ PHG4BarrelEcalSubsystem::~PHG4BarrelEcalSubsystem()
 //_______________________________________________________________________
 int PHG4BarrelEcalSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
 {
+  // the parametrised EM shower model of the detector uses the fast simulation physics
+  if (GetParams()->get_int_param("fastshower"))
+  {
+    PHG4CalorimeterRegion::RegisterFastSimulationPhysics();
+  }
+
   PHNodeIterator iter(topNode);
   PHCompositeNode* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
 
@@ -153,6 +161,24 @@ void PHG4BarrelEcalSubsystem::SetDefaultParameters()
   set_default_double_param("Carbon_width_half",1.);
   set_default_double_param("support_length",1.5);
 
+  // range cuts (cm) of the REGION_<name> G4Region
+  for (const auto &par : PHG4CalorimeterRegion::DefaultParameters())
+  {
+    set_default_double_param(par.first, par.second);
+  }
+
+  // parametrised EM showers in the REGION_<name> region (off by default),
+  // e+, e- and gammas above fastshower_emin (GeV) are not tracked further.
+  // Shower medium (SciGlass): radiation length and Moliere radius (cm),
+  // critical energy (MeV), effective Z
+  set_default_int_param("fastshower", 0);
+  set_default_double_param("fastshower_emin", 1.);
+  set_default_double_param("fastshower_x0", 2.8);
+  set_default_double_param("fastshower_rm", 3.5);
+  set_default_double_param("fastshower_ec", 16.);
+  set_default_double_param("fastshower_z", 45.);
+  set_default_double_param("fastshower_spots_per_gev", 200.);
+
   return;
 }
 
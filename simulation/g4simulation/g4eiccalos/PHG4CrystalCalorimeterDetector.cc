@@ -1,5 +1,8 @@
 #include "PHG4CrystalCalorimeterDetector.h"
 #include "PHG4CrystalCalorimeterDisplayAction.h"
+#include "PHG4EMShowerModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -15,6 +18,7 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4String.hh>          // for G4String
 #include <Geant4/G4SubtractionSolid.hh>
@@ -99,6 +103,14 @@ void PHG4CrystalCalorimeterDetector::ConstructMe(G4LogicalVolume* logicWorld)
   G4LogicalVolume* eemc_envelope_log = new G4LogicalVolume(eemc_envelope_solid, WorldMaterial, G4String("eemc_envelope"), 0, 0, 0);
 
   GetDisplayAction()->AddVolume(eemc_envelope_log, "Envelope");
+
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(eemc_envelope_log);
+  if (m_Params->get_int_param("fastshower"))
+  {
+    m_ShowerModel = new PHG4EMShowerModel(GetName(), region, m_Params);
+  }
   /* Define rotation attributes for envelope cone */
   G4RotationMatrix eemc_rotm;
   eemc_rotm.rotateX(m_Params->get_double_param("rot_x") * deg);
@@ -15,6 +15,7 @@ class G4LogicalVolume;
 class G4Material;
 class G4VPhysicalVolume;
 class PHCompositeNode;
+class PHG4EMShowerModel;
 class PHG4CrystalCalorimeterDisplayAction;
 class PHG4Subsystem;
 class PHParameters;
@@ -52,11 +53,17 @@ class PHG4CrystalCalorimeterDetector : public PHG4Detector
 
   PHParameters *GetParams() { return m_Params; }
 
+  //! parametrised EM showers, nullptr if not enabled
+  PHG4EMShowerModel *GetShowerModel() const { return m_ShowerModel; }
+
  protected:  // for variables also used in PHG4ProjCrystalCalorimeterDetector
   PHG4CrystalCalorimeterDisplayAction *GetDisplayAction() { return m_DisplayAction; }
   G4Material *GetCarbonFiber();
   virtual int GetCaloType() const { return PHG4CrystalCalorimeterDefs::CaloType::nonprojective; }
 
+  //! created in ConstructMe if the fastshower parameter is set
+  PHG4EMShowerModel *m_ShowerModel = nullptr;
+
  private:  // private stuff
   G4LogicalVolume *ConstructTower();
   int PlaceTower(G4LogicalVolume *envelope, G4LogicalVolume *tower);
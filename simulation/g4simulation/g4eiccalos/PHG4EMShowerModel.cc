@@ -0,0 +1,136 @@
+#include "PHG4EMShowerModel.h"
+
+#include "PHG4ShowerHitHandler.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/PHRandomSeed.h>
+
+#include <Geant4/G4Electron.hh>
+#include <Geant4/G4FastStep.hh>
+#include <Geant4/G4FastTrack.hh>
+#include <Geant4/G4Gamma.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4PhysicalConstants.hh>
+#include <Geant4/G4Positron.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Track.hh>
+
+#include <gsl/gsl_randist.h>
+
+#include <algorithm>
+#include <cmath>
+
+PHG4EMShowerModel::PHG4EMShowerModel(const std::string &name, G4Region *envelope, const PHParameters *params)
+  : G4VFastSimulationModel(name + "_EMShowerModel", envelope)
+  , m_Emin(params->get_double_param("fastshower_emin") * GeV)
+  , m_X0(params->get_double_param("fastshower_x0") * cm)
+  , m_RM(params->get_double_param("fastshower_rm") * cm)
+  , m_Ec(params->get_double_param("fastshower_ec") * MeV)
+  , m_Z(params->get_double_param("fastshower_z"))
+  , m_SpotsPerGeV(params->get_double_param("fastshower_spots_per_gev"))
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+  m_HitMaker.SetDensityWeighting(true);
+  PHG4CalorimeterRegion::ActivateFastSimulation({G4Electron::Definition(), G4Positron::Definition(), G4Gamma::Definition()});
+}
+
+PHG4EMShowerModel::~PHG4EMShowerModel()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+G4bool PHG4EMShowerModel::IsApplicable(const G4ParticleDefinition &particle)
+{
+  return &particle == G4Electron::Definition() ||
+         &particle == G4Positron::Definition() ||
+         &particle == G4Gamma::Definition();
+}
+
+G4bool PHG4EMShowerModel::ModelTrigger(const G4FastTrack &fastTrack)
+{
+  return m_HitHandler && fastTrack.GetPrimaryTrack()->GetKineticEnergy() > m_Emin;
+}
+
+void PHG4EMShowerModel::SetHitHandler(PHG4ShowerHitHandler *handler)
+{
+  m_HitHandler = handler;
+}
+
+void PHG4EMShowerModel::DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep)
+{
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  const G4ParticleDefinition *particle = track->GetParticleDefinition();
+  double energy = track->GetKineticEnergy();
+  // positrons annihilate at the end of the shower
+  if (particle == G4Positron::Definition())
+  {
+    energy += 2. * electron_mass_c2;
+  }
+  // the energy goes into our hits, do not propose it as energy deposit
+  // of this step or the stepping action would count it a second time
+  fastStep.KillPrimaryTrack();
+  fastStep.ProposePrimaryTrackPathLength(0.);
+
+  // mean profiles of a homogeneous medium (Grindhammer et al.), depth in
+  // radiation lengths, radii in Moliere radii
+  const double lny = std::log(energy / m_Ec);
+  const double lne = std::log(energy / GeV);
+  const double tmax = std::max(0.1, lny + ((particle == G4Gamma::Definition()) ? 0.5 : -0.5));
+  const double alpha = std::max(1.1, 0.21 + (0.492 + 2.38 / m_Z) * lny);
+  const double beta = (alpha - 1.) / tmax;
+  const double z1 = 0.0251 + 0.00319 * lne;
+  const double z2 = 0.1162 - 0.000381 * m_Z;
+  const double k1 = 0.659 - 0.00309 * m_Z;
+  const double k2 = 0.645;
+  const double k3 = -2.59;
+  const double k4 = 0.3585 + 0.0421 * lne;
+  const double p1 = 2.632 - 0.00094 * m_Z;
+  const double p2 = 0.401 + 0.00187 * m_Z;
+  const double p3 = 1.313 - 0.0686 * lne;
+
+  const G4ThreeVector start = track->GetPosition();
+  const G4ThreeVector dir = track->GetMomentumDirection();
+  const G4ThreeVector orth1 = dir.orthogonal().unit();
+  const G4ThreeVector orth2 = dir.cross(orth1);
+  const double t0 = track->GetGlobalTime();
+
+  const int nspots = std::max(10, (int) (m_SpotsPerGeV * energy / GeV));
+  int nspots_in = 0;
+  double weight_sum = 0.;
+  m_HitMaker.StartShower(m_HitHandler);
+  for (int i = 0; i < nspots; i++)
+  {
+    const double depth = gsl_ran_gamma(m_RandomGenerator, alpha, 1. / beta);
+    const double tau = depth / tmax;
+    const double q = (p2 - tau) / p3;
+    const double pcore = std::min(1., std::max(0., p1 * std::exp(q - std::exp(q))));
+    const double rcore = z1 + z2 * tau;
+    const double rtail = k1 * (std::exp(k3 * (tau - k2)) + std::exp(k4 * (tau - k2)));
+    const double rscale = (gsl_rng_uniform(m_RandomGenerator) < pcore) ? rcore : rtail;
+    // inverse of the cumulative distribution of 2 r R^2 / (r^2 + R^2)^2
+    const double u = gsl_rng_uniform(m_RandomGenerator);
+    const double r = rscale * std::sqrt(u / (1. - u));
+    const double phi = 2. * M_PI * gsl_rng_uniform(m_RandomGenerator);
+    const G4ThreeVector pos = start + depth * m_X0 * dir + r * m_RM * (std::cos(phi) * orth1 + std::sin(phi) * orth2);
+
+    const double weight = m_HitMaker.AddSpot(pos, 1., t0 + depth * m_X0 / c_light);
+    if (weight > 0)
+    {
+      weight_sum += weight;
+      nspots_in++;
+    }
+  }
+  if (!nspots_in)
+  {
+    return;
+  }
+
+  // every spot carries energy/nspots at the mean electron density of the
+  // spots inside the calorimeter, the spots outside of it are leakage
+  m_HitMaker.EndShower(track, energy / nspots * nspots_in / weight_sum);
+}
@@ -0,0 +1,63 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4EMSHOWERMODEL_H
+#define G4DETECTORS_PHG4EMSHOWERMODEL_H
+
+#include "PHG4ShowerHitHandler.h"
+#include "PHG4ShowerHitMaker.h"
+
+#include <Geant4/G4Types.hh>
+#include <Geant4/G4VFastSimulationModel.hh>
+
+#include <gsl/gsl_rng.h>
+
+#include <string>
+
+class G4FastStep;
+class G4FastTrack;
+class G4ParticleDefinition;
+class G4Region;
+class PHParameters;
+
+/*!
+ * \brief GFlash style parametrised EM showers for the ECALs
+ *
+ * Electrons, positrons and photons above fastshower_emin (GeV) entering the
+ * region of the calorimeter are killed and their energy is distributed over
+ * spots using the mean Grindhammer longitudinal (gamma function) and lateral
+ * (core + tail) profiles of a homogeneous medium with radiation length
+ * fastshower_x0 (cm), Moliere radius fastshower_rm (cm), critical energy
+ * fastshower_ec (MeV) and effective Z fastshower_z. PHG4ShowerHitMaker
+ * weights each spot with the electron density of the volume it ends up in,
+ * which gives the sampling fraction of sampling calorimeters, and hands the
+ * per tower sums to the stepping action as ordinary G4Hits.
+ */
+class PHG4EMShowerModel : public G4VFastSimulationModel
+{
+ public:
+  //! e+, e- and gammas get the fast simulation process, the subsystem has
+  //! to call PHG4CalorimeterRegion::RegisterFastSimulationPhysics() first
+  PHG4EMShowerModel(const std::string &name, G4Region *envelope, const PHParameters *params);
+  ~PHG4EMShowerModel() override;
+
+  G4bool IsApplicable(const G4ParticleDefinition &particle) override;
+  G4bool ModelTrigger(const G4FastTrack &fastTrack) override;
+  void DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep) override;
+
+  //! set by the stepping action once the hit containers are known
+  void SetHitHandler(PHG4ShowerHitHandler *handler);
+
+ private:
+  gsl_rng *m_RandomGenerator = nullptr;
+  PHG4ShowerHitHandler *m_HitHandler = nullptr;
+  PHG4ShowerHitMaker m_HitMaker;
+
+  double m_Emin;
+  double m_X0;
+  double m_RM;
+  double m_Ec;
+  double m_Z;
+  double m_SpotsPerGeV;
+};
+
+#endif
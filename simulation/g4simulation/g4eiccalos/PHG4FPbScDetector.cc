@@ -136,6 +136,7 @@ void PHG4FPbScDetector::ConstructMe(G4LogicalVolume* logicWorld)
                                                absorber_logic_[layer],
                                                G4String(ss.str()),
                                                logicWorld, false, 0, false);
+    absorber_layer_[absorber_physi_[layer]] = layer;
 
     current_center_position += 0.5 * absorber_thickness;
     current_center_position += 0.5 * scintillator_thickness;
@@ -163,6 +164,7 @@ void PHG4FPbScDetector::ConstructMe(G4LogicalVolume* logicWorld)
                                                    scintillator_logic_[layer],
                                                    G4String(ss.str()),
                                                    logicWorld, false, 0, false);
+    scintillator_layer_[scintillator_physi_[layer]] = layer;
 
     current_center_position += 0.5 * scintillator_thickness;
     current_center_position += layer_separation;
@@ -170,28 +172,32 @@ void PHG4FPbScDetector::ConstructMe(G4LogicalVolume* logicWorld)
   }
 }
 
-bool PHG4FPbScDetector::isInScintillator(G4VPhysicalVolume* volume)
+bool PHG4FPbScDetector::isInScintillator(G4VPhysicalVolume* volume) const
 {
-  //loop over the physical volumes and see if this is a match
-  std::map<unsigned int, G4VPhysicalVolume*>::iterator vol_iter = scintillator_physi_.begin();
-  for (; vol_iter != scintillator_physi_.end(); ++vol_iter)
+  return scintillator_layer_.find(volume) != scintillator_layer_.end();
+}
+
+int PHG4FPbScDetector::getScintillatorLayer(G4VPhysicalVolume* volume) const
+{
+  auto iter = scintillator_layer_.find(volume);
+  if (iter != scintillator_layer_.end())
   {
-    if (vol_iter->second == volume)
-    {
-      return true;
-    }
+    return iter->second;
   }
-  return false;
+  return -1;
+}
+
+bool PHG4FPbScDetector::isInAbsorber(G4VPhysicalVolume* volume) const
+{
+  return absorber_layer_.find(volume) != absorber_layer_.end();
 }
 
-int PHG4FPbScDetector::getScintillatorLayer(G4VPhysicalVolume* volume)
+int PHG4FPbScDetector::getAbsorberLayer(G4VPhysicalVolume* volume) const
 {
-  //loop over the physical volumes and see if this is a match
-  std::map<unsigned int, G4VPhysicalVolume*>::iterator vol_iter = scintillator_physi_.begin();
-  for (; vol_iter != scintillator_physi_.end(); ++vol_iter)
+  auto iter = absorber_layer_.find(volume);
+  if (iter != absorber_layer_.end())
   {
-    if (vol_iter->second == volume)
-      return vol_iter->first;
+    return iter->second;
   }
   return -1;
 }
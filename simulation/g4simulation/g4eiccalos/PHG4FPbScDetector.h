@@ -13,6 +13,7 @@
 #include <cstddef>  // for size_t
 #include <map>
 #include <string>  // for string
+#include <unordered_map>
 
 class G4Material;
 class G4Box;
@@ -39,8 +40,12 @@ class PHG4FPbScDetector : public PHG4Detector
       return 0;
   }
 
-  bool isInScintillator(G4VPhysicalVolume* volume);
-  int getScintillatorLayer(G4VPhysicalVolume* volume);
+  bool isInScintillator(G4VPhysicalVolume* volume) const;
+  //! layer of this scintillator volume, -1 if it is not a scintillator
+  int getScintillatorLayer(G4VPhysicalVolume* volume) const;
+  bool isInAbsorber(G4VPhysicalVolume* volume) const;
+  //! layer of this absorber volume, -1 if it is not an absorber
+  int getAbsorberLayer(G4VPhysicalVolume* volume) const;
   // compute tower index
   unsigned int computeIndex(unsigned int layer, G4double x, G4double y, G4double z, G4double& xcenter, G4double& ycenter, G4double& zcenter);
   void set_Place(G4double x, G4double y, G4double z)
@@ -71,6 +76,10 @@ class PHG4FPbScDetector : public PHG4Detector
   std::map<unsigned int, G4LogicalVolume*> scintillator_logic_;
   std::map<unsigned int, G4VPhysicalVolume*> scintillator_physi_;
 
+  // reverse lookup volume -> layer, filled in ConstructMe
+  std::unordered_map<const G4VPhysicalVolume*, int> absorber_layer_;
+  std::unordered_map<const G4VPhysicalVolume*, int> scintillator_layer_;
+
   G4Region* _region;
 };
 
@@ -46,9 +46,9 @@ void PHG4FPbScRegionSteppingAction::UserSteppingAction( const G4Step* aStep)
   const G4Track* aTrack = aStep->GetTrack();
 
   // make sure we are in a volume
-  if ( detector_->isInScintillator(volume) )
+  int layer_id = detector_->getScintillatorLayer(volume);
+  if ( layer_id >= 0 )
     {
-      int layer_id = 0;
       G4StepPoint * prePoint = aStep->GetPreStepPoint();
       G4StepPoint * postPoint = aStep->GetPostStepPoint();
        cout << "track id " << aTrack->GetTrackID() << endl;
@@ -39,9 +39,9 @@ bool PHG4FPbScSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4VPhysicalVolume* volume = aStep->GetPreStepPoint()->GetTouchableHandle()->GetVolume();
 
-  int layer_id = 0;
-
-  if ((detector_->isInScintillator(volume)) == false)
+  // one lookup gives both, -1 if this is not a scintillator layer
+  int layer_id = detector_->getScintillatorLayer(volume);
+  if (layer_id < 0)
   {
     return false;
   }
@@ -51,8 +51,6 @@ bool PHG4FPbScSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     return false;
   }
 
-  layer_id = detector_->getScintillatorLayer(volume);
-
   G4StepPoint* prePoint = aStep->GetPreStepPoint();
   G4StepPoint* postPoint = aStep->GetPostStepPoint();
   G4Track* aTrack = aStep->GetTrack();
@@ -1,6 +1,9 @@
 #include "PHG4ForwardEcalDetector.h"
 
 #include "PHG4ForwardEcalDisplayAction.h"
+#include "PHG4EMShowerModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -15,6 +18,7 @@
 
 #include <Geant4/G4Box.hh>
 #include <Geant4/G4Cons.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4SubtractionSolid.hh>
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
@@ -32,6 +36,7 @@
 
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <fstream>
@@ -84,6 +89,13 @@ int PHG4ForwardEcalDetector::IsInForwardEcal(G4VPhysicalVolume* volume) const
       return 1;
     }
   }
+  if (m_ActiveFlag)
+  {
+    if (m_SamplingFractionMap.find(mylogvol) != m_SamplingFractionMap.end())
+    {
+      return 2;
+    }
+  }
   if (m_AbsorberActiveFlag)
   {
     if (m_AbsorberLogicalVolSet.find(mylogvol) != m_AbsorberLogicalVolSet.end())
@@ -128,6 +140,14 @@ void PHG4ForwardEcalDetector::ConstructMe(G4LogicalVolume* logicWorld)
   /* Define visualization attributes for envelope cone */
   GetDisplayAction()->AddVolume(ecal_envelope_log, "Envelope");
 
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(ecal_envelope_log);
+  if (m_Params->get_int_param("fastshower"))
+  {
+    m_ShowerModel = new PHG4EMShowerModel(GetName(), region, m_Params);
+  }
+
   /* Define rotation attributes for envelope cone */
   G4RotationMatrix ecal_rotm;
   ecal_rotm.rotateX(m_XRot);
@@ -425,6 +445,12 @@ PHG4ForwardEcalDetector::ConstructTowerType3_4_5_6(int type)
                                                             name_single_tower_logic,
                                                             0, 0, 0);
 
+  if (m_Params->get_int_param("homogeneous_towers"))
+  {
+    ConstructHomogeneousTower(single_tower_logic, type, num_fibers_x, num_fibers_y);
+    return single_tower_logic;
+  }
+
   // Now the absorber and then the fibers:
 
   std::string absorberName = "single_absorber_solid" + std::to_string(type);
@@ -503,6 +529,133 @@ PHG4ForwardEcalDetector::ConstructTowerType3_4_5_6(int type)
   return single_tower_logic;
 }
 
+void PHG4ForwardEcalDetector::ConstructHomogeneousTower(G4LogicalVolume* single_tower_logic, int type, int num_fibers_x, int num_fibers_y)
+{
+  const double tower_dx = m_TowerDx[type];
+  const double tower_dy = m_TowerDy[type];
+  const double tower_dz = m_TowerDz[type];
+  // same fiber grid as the fiber by fiber construction
+  const double fiber_radius = 0.055 * cm;
+  const double fiber_unit_cell = 10.0 * cm / 47.0;
+
+  G4Material* material_absorber = G4Material::GetMaterial("E864_Absorber");
+  G4Material* material_scintillator = G4Material::GetMaterial("G4_POLYSTYRENE");
+
+  // scintillator volume fraction of the whole tower
+  const double fiber_fraction = num_fibers_x * num_fibers_y * M_PI * fiber_radius * fiber_radius / (tower_dx * tower_dy);
+  std::string matname = "E864_Homogeneous" + std::to_string(type);
+  G4Material* material_mix = G4Material::GetMaterial(matname, false);  // false suppresses warning that material does not exist
+  if (!material_mix)
+  {
+    const double mass_scintillator = fiber_fraction * material_scintillator->GetDensity();
+    const double mass_absorber = (1. - fiber_fraction) * material_absorber->GetDensity();
+    material_mix = new G4Material(matname, mass_scintillator + mass_absorber, 2);
+    material_mix->AddMaterial(material_scintillator, mass_scintillator / (mass_scintillator + mass_absorber));
+    material_mix->AddMaterial(material_absorber, mass_absorber / (mass_scintillator + mass_absorber));
+  }
+
+  std::string mixName = "single_homogeneous_solid" + std::to_string(type);
+  G4VSolid* single_mix_solid = new G4Box(mixName,
+                                         tower_dx / 2.0,
+                                         tower_dy / 2.0,
+                                         tower_dz / 2.0);
+  std::string mixLogicName = "single_homogeneous_logic" + std::to_string(type);
+  G4LogicalVolume* single_mix_logic = new G4LogicalVolume(single_mix_solid,
+                                                          material_mix,
+                                                          mixLogicName,
+                                                          0, 0, 0);
+  GetDisplayAction()->AddVolume(single_mix_logic, "Absorber");
+
+  // sampling fraction map: scintillator area fraction of every bin, weighted
+  // with the electron density, i.e. the mip dE/dx of fiber and absorber. This
+  // is a geometric estimate, EM showers in lead sample less than mips
+  // (e/mip < 1) and homogeneous_sf_scale has to be calibrated against the
+  // fiber by fiber towers
+  SamplingFractionMap& sfmap = m_SamplingFractionMap[single_mix_logic];
+  sfmap.dx = tower_dx;
+  sfmap.dy = tower_dy;
+  sfmap.nbins = m_Params->get_int_param("homogeneous_map_bins");
+  sfmap.sf.assign(sfmap.nbins * sfmap.nbins, 0.);
+  const double ne_scintillator = material_scintillator->GetElectronDensity();
+  const double ne_absorber = material_absorber->GetElectronDensity();
+  const double scale = m_Params->get_double_param("homogeneous_sf_scale");
+  const int nsub = 16;
+  double sum = 0.;
+  for (int ix = 0; ix < sfmap.nbins; ix++)
+  {
+    for (int iy = 0; iy < sfmap.nbins; iy++)
+    {
+      int ninside = 0;
+      for (int sx = 0; sx < nsub; sx++)
+      {
+        for (int sy = 0; sy < nsub; sy++)
+        {
+          // position from the lower left corner of the tower
+          const double x = (ix + (sx + 0.5) / nsub) * tower_dx / sfmap.nbins;
+          const double y = (iy + (sy + 0.5) / nsub) * tower_dy / sfmap.nbins;
+          const int fx = x / fiber_unit_cell;
+          const int fy = y / fiber_unit_cell;
+          if (fx >= num_fibers_x || fy >= num_fibers_y)
+          {
+            continue;
+          }
+          const double rx = x - (fx + 0.5) * fiber_unit_cell;
+          const double ry = y - (fy + 0.5) * fiber_unit_cell;
+          if (rx * rx + ry * ry < fiber_radius * fiber_radius)
+          {
+            ninside++;
+          }
+        }
+      }
+      const double f = (double) ninside / (nsub * nsub);
+      const double sf = scale * f * ne_scintillator / (f * ne_scintillator + (1. - f) * ne_absorber);
+      sfmap.sf[ix * sfmap.nbins + iy] = sf;
+      sum += sf;
+    }
+  }
+  sfmap.mean = sum / sfmap.sf.size();
+  m_TypeSamplingFraction[type] = sfmap.mean;
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHG4ForwardEcalDetector: homogeneous tower type " << type
+              << ", scintillator fraction " << fiber_fraction
+              << ", mean sampling fraction " << sfmap.mean << std::endl;
+  }
+
+  // placed like the absorber, the tower index stays in the copy number
+  // of the mother volume
+  std::string name_mix = m_TowerLogicNamePrefix + "_single_homogeneous" + std::to_string(type);
+  new G4PVPlacement(0, G4ThreeVector(0.0, 0.0, 0.0),
+                    single_mix_logic,
+                    name_mix,
+                    single_tower_logic,
+                    0, 0, OverlapCheck());
+  GetDisplayAction()->AddVolume(single_tower_logic, "SingleTower");
+}
+
+double PHG4ForwardEcalDetector::GetSamplingFraction(G4LogicalVolume* logvol, const double x, const double y) const
+{
+  auto iter = m_SamplingFractionMap.find(logvol);
+  if (iter == m_SamplingFractionMap.end())
+  {
+    return 1.;
+  }
+  const SamplingFractionMap& sfmap = iter->second;
+  const int ix = std::min(sfmap.nbins - 1, std::max(0, (int) ((x / sfmap.dx + 0.5) * sfmap.nbins)));
+  const int iy = std::min(sfmap.nbins - 1, std::max(0, (int) ((y / sfmap.dy + 0.5) * sfmap.nbins)));
+  return sfmap.sf[ix * sfmap.nbins + iy];
+}
+
+double PHG4ForwardEcalDetector::GetMeanSamplingFraction(const int idx_j, const int idx_k) const
+{
+  auto iter = m_TowerSamplingFraction.find((idx_j << 16) + idx_k);
+  if (iter == m_TowerSamplingFraction.end())
+  {
+    return 1.;
+  }
+  return iter->second;
+}
+
 int PHG4ForwardEcalDetector::PlaceTower(G4LogicalVolume* ecalenvelope, G4LogicalVolume* singletowerIn[7])
 {
   /* Loop over all tower positions in vector and place tower */
@@ -527,6 +680,12 @@ int PHG4ForwardEcalDetector::PlaceTower(G4LogicalVolume* ecalenvelope, G4Logical
                           0, copyno, OverlapCheck());
 
     m_GdmlConfig->exclude_physical_vol(tower_placement);
+
+    auto sfiter = m_TypeSamplingFraction.find(iterator->second.type);
+    if (sfiter != m_TypeSamplingFraction.end())
+    {
+      m_TowerSamplingFraction[copyno] = sfiter->second;
+    }
   }
 
   return 0;
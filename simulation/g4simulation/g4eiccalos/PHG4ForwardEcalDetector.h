@@ -12,10 +12,12 @@
 #include <set>
 #include <string>
 #include <utility>  // for pair, make_pair
+#include <vector>
 
 class G4LogicalVolume;
 class G4VPhysicalVolume;
 class PHCompositeNode;
+class PHG4EMShowerModel;
 class PHG4ForwardEcalDisplayAction;
 class PHG4Subsystem;
 class PHG4GDMLConfig;
@@ -40,8 +42,15 @@ class PHG4ForwardEcalDetector : public PHG4Detector
   virtual void ConstructMe(G4LogicalVolume *world);
 
   //!@name volume accessors
+  //! 1 scintillator, 2 homogenised tower, -1 absorber, 0 outside
   int IsInForwardEcal(G4VPhysicalVolume *) const;
 
+  //! visible fraction of the energy deposited at local (x, y) of a homogenised tower, 1 for other volumes
+  double GetSamplingFraction(G4LogicalVolume *logvol, const double x, const double y) const;
+  //! mean of the map of the tower (idx_j, idx_k), for hits without a local position,
+  //! 1 for towers which are not homogenised
+  double GetMeanSamplingFraction(const int idx_j, const int idx_k) const;
+
   void SetTowerDimensions(double dx, double dy, double dz, int type);
 
   void SetPlace(double place_in_x, double place_in_y, double place_in_z)
@@ -97,6 +106,9 @@ class PHG4ForwardEcalDetector : public PHG4Detector
 
   int get_Layer() const { return m_Layer; }
   int get_TowerType() const { return m_TowerType; }
+
+  //! parametrised EM showers, nullptr if not enabled
+  PHG4EMShowerModel *GetShowerModel() const { return m_ShowerModel; }
   
   PHG4ForwardEcalDisplayAction *GetDisplayAction() { return m_DisplayAction; }
 
@@ -104,6 +116,7 @@ class PHG4ForwardEcalDetector : public PHG4Detector
   G4LogicalVolume *ConstructTower(int type);
   G4LogicalVolume *ConstructTowerType2();
   G4LogicalVolume *ConstructTowerType3_4_5_6(int type);
+  void ConstructHomogeneousTower(G4LogicalVolume *tower, int type, int num_fibers_x, int num_fibers_y);
   int PlaceTower(G4LogicalVolume *envelope, G4LogicalVolume *tower[6]);
   int ParseParametersFromTable();
 
@@ -117,8 +130,19 @@ class PHG4ForwardEcalDetector : public PHG4Detector
     int idx_k;
   };
 
+  //! sampling fraction in nbins x nbins bins over the tower cross section
+  struct SamplingFractionMap
+  {
+    double dx = 0.;
+    double dy = 0.;
+    int nbins = 0;
+    double mean = 0.;
+    std::vector<double> sf;
+  };
+
   PHG4ForwardEcalDisplayAction *m_DisplayAction = nullptr;
   PHParameters *m_Params = nullptr;
+  PHG4EMShowerModel *m_ShowerModel = nullptr;
   //! registry for volumes that should not be exported, i.e. fibers
   PHG4GDMLConfig *m_GdmlConfig = nullptr;
 
@@ -153,6 +177,11 @@ class PHG4ForwardEcalDetector : public PHG4Detector
 
   std::set<G4LogicalVolume *> m_AbsorberLogicalVolSet;
   std::set<G4LogicalVolume *> m_ScintiLogicalVolSet;
+  std::map<G4LogicalVolume *, SamplingFractionMap> m_SamplingFractionMap;
+  //! tower type -> mean of its sampling fraction map
+  std::map<int, double> m_TypeSamplingFraction;
+  //! copy number (idx_j << 16) + idx_k of the homogenised towers -> mean of their map
+  std::map<int, double> m_TowerSamplingFraction;
 
  protected:
   const std::string TowerLogicNamePrefix() const { return m_TowerLogicNamePrefix; }
@@ -1,4 +1,5 @@
 #include "PHG4ForwardEcalSteppingAction.h"
+#include "PHG4EMShowerModel.h"
 #include "PHG4ForwardEcalDetector.h"
 
 #include <phparameter/PHParameters.h>
@@ -13,9 +14,11 @@
 
 #include <phool/getClass.h>
 
+#include <Geant4/G4AffineTransform.hh>
 #include <Geant4/G4IonisParamMat.hh>  // for G4IonisParamMat
 #include <Geant4/G4Material.hh>       // for G4Material
 #include <Geant4/G4MaterialCutsCouple.hh>
+#include <Geant4/G4NavigationHistory.hh>
 #include <Geant4/G4ParticleDefinition.hh>      // for G4ParticleDefinition
 #include <Geant4/G4ReferenceCountedHandle.hh>  // for G4ReferenceCountedHandle
 #include <Geant4/G4Step.hh>
@@ -62,15 +65,16 @@ PHG4ForwardEcalSteppingAction::~PHG4ForwardEcalSteppingAction()
 bool PHG4ForwardEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
 
-  // m_Detector->IsInForwardEcal(volume)
-  // returns
+  // GetTowerIndex returns
   //  0 is outside of Forward ECAL
   //  1 is inside scintillator
+  //  2 is inside a homogenised Pb/scintillator tower
   // -1 is inside absorber (dead material)
 
-  int whichactive = m_Detector->IsInForwardEcal(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
@@ -78,15 +82,9 @@ bool PHG4ForwardEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
   }
 
   int layer_id = m_Detector->get_Layer();
-  int towertype = m_Detector->get_TowerType();
-  unsigned int icopy = touch->GetVolume(2)->GetCopyNo();
-  if (towertype != 2)
-    icopy = touch->GetVolume(1)->GetCopyNo();
-  int idx_j = icopy >> 16;
-  int idx_k = icopy & 0xFFFF;
 
   if (Verbosity() > 2)
-    std::cout << "\t" << icopy << "\t idx_j =" << idx_j << ", idx_k =" << idx_k <<"\t id:" << icopy << "\t type: " << towertype <<  std::endl;
+    std::cout << "\t idx_j =" << idx_j << ", idx_k =" << idx_k << "\t type: " << m_Detector->get_TowerType() << std::endl;
 
   
   /* Get energy deposited by this step */
@@ -94,6 +92,17 @@ bool PHG4ForwardEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
   double eion = (aStep->GetTotalEnergyDeposit() - aStep->GetNonIonizingEnergyDeposit()) / GeV;
   double light_yield = 0;
 
+  // homogenised towers: only the sampling fraction of the deposit is visible
+  double sampling_fraction = 1.;
+  if (whichactive == 2)
+  {
+    const G4ThreeVector local = touch->GetHistory()->GetTopTransform().TransformPoint(
+        0.5 * (aStep->GetPreStepPoint()->GetPosition() + aStep->GetPostStepPoint()->GetPosition()));
+    sampling_fraction = m_Detector->GetSamplingFraction(touch->GetVolume()->GetLogicalVolume(), local.x(), local.y());
+    edep *= sampling_fraction;
+    eion *= sampling_fraction;
+  }
+
   /* Get pointer to associated Geant4 track */
   const G4Track* aTrack = aStep->GetTrack();
 
@@ -175,7 +184,7 @@ bool PHG4ForwardEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
 
     if (whichactive > 0)
     {
-      light_yield = GetVisibleEnergyDeposition(aStep);  // for scintillator only, calculate light yields
+      light_yield = GetVisibleEnergyDeposition(aStep) * sampling_fraction;  // for scintillator only, calculate light yields
       static bool once = true;
       if (once && edep > 0)
       {
@@ -276,6 +285,57 @@ bool PHG4ForwardEcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
   }
 }
 
+//____________________________________________________________________________..
+int PHG4ForwardEcalSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInForwardEcal(touch->GetVolume());
+  if (whichactive)
+  {
+    unsigned int icopy = touch->GetVolume(2)->GetCopyNo();
+    if (m_Detector->get_TowerType() != 2)
+      icopy = touch->GetVolume(1)->GetCopyNo();
+    idx_j = icopy >> 16;
+    idx_k = icopy & 0xFFFF;
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+void PHG4ForwardEcalSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_SignalHitContainer : m_AbsorberHitContainer;
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  if (whichactive == 2)
+  {
+    // the position inside the tower is lost by the summing,
+    // use the mean sampling fraction of the hit tower
+    const double sf = m_Detector->GetMeanSamplingFraction(hit->get_index_j(), hit->get_index_k());
+    hit->set_edep(hit->get_edep() * sf);
+    hit->set_eion(hit->get_eion() * sf);
+    hit->set_light_yield(hit->get_light_yield() * sf);
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_Layer(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4ForwardEcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -311,4 +371,8 @@ void PHG4ForwardEcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNod
       std::cout << "PHG4ForwardEcalSteppingAction::SetTopNode - unable to find " << absorbernodename << std::endl;
     }
   }
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
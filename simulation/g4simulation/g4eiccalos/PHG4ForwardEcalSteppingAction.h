@@ -3,11 +3,15 @@
 #ifndef G4DETECTORS_PHG4FORWARDECALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4FORWARDECALSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 //#include <Geant4/G4TouchableHandle.hh>
 
 class G4Step;
+class G4Track;
+class G4VTouchable;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4ForwardEcalDetector;
@@ -16,7 +20,7 @@ class PHG4HitContainer;
 class PHG4Shower;
 class PHParameters;
 
-class PHG4ForwardEcalSteppingAction : public PHG4SteppingAction
+class PHG4ForwardEcalSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -31,6 +35,12 @@ class PHG4ForwardEcalSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
+  //! tower index from the copy number, returns IsInForwardEcal() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! hits of the parametrised EM showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
  private:
   //! pointer to the detector
   PHG4ForwardEcalDetector* m_Detector = nullptr;
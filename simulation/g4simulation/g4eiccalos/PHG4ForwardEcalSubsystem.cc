@@ -4,6 +4,8 @@
 #include "PHG4ForwardEcalDisplayAction.h"
 #include "PHG4ForwardEcalSteppingAction.h"
 
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
@@ -42,6 +44,12 @@ PHG4ForwardEcalSubsystem::~PHG4ForwardEcalSubsystem()
 //_______________________________________________________________________
 int PHG4ForwardEcalSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
 {
+  // the parametrised EM shower model of the detector uses the fast simulation physics
+  if (GetParams()->get_int_param("fastshower"))
+  {
+    PHG4CalorimeterRegion::RegisterFastSimulationPhysics();
+  }
+
   PHNodeIterator iter(topNode);
   PHCompositeNode* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
 
@@ -144,6 +152,37 @@ void PHG4ForwardEcalSubsystem::SetDefaultParameters()
   mappingfilename << "/ForwardEcal/mapping/towerMap_FEMC_fsPHENIX_v004.txt";
   set_default_string_param("mapping_file", mappingfilename.str());
   set_default_string_param("mapping_file_md5", PHG4Utils::md5sum(mappingfilename.str()));
+
+  // range cuts (cm) of the REGION_<name> G4Region
+  for (const auto &par : PHG4CalorimeterRegion::DefaultParameters())
+  {
+    set_default_double_param(par.first, par.second);
+  }
+
+  // parametrised EM showers in the REGION_<name> region (off by default),
+  // e+, e- and gammas above fastshower_emin (GeV) are not tracked further.
+  // Shower medium (Pb/scintillator sampling towers): radiation length and Moliere radius (cm),
+  // critical energy (MeV), effective Z
+  set_default_int_param("fastshower", 0);
+  set_default_double_param("fastshower_emin", 1.);
+  set_default_double_param("fastshower_x0", 2.0);
+  set_default_double_param("fastshower_rm", 4.0);
+  set_default_double_param("fastshower_ec", 15.);
+  set_default_double_param("fastshower_z", 50.);
+  set_default_double_param("fastshower_spots_per_gev", 200.);
+
+  // E864 Pb-SciFi towers (types 3-6) as one homogenised Pb/scintillator box,
+  // the visible energy comes from a sampling fraction map with
+  // homogeneous_map_bins x homogeneous_map_bins bins per tower. The map is
+  // the scintillator area fraction of each bin weighted with the electron
+  // density (mip dE/dx), it is not calibrated for showers. Set
+  // homogeneous_sf_scale to the ratio of the scintillator energy of the fiber
+  // by fiber towers (homogeneous_towers 0) to the visible energy of the
+  // homogenised ones for the same electrons
+  set_default_int_param("homogeneous_towers", 0);
+  set_default_int_param("homogeneous_map_bins", 20);
+  set_default_double_param("homogeneous_sf_scale", 1.);
+
   return;
 }
 
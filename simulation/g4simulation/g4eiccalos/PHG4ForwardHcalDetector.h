@@ -15,6 +15,7 @@ class G4LogicalVolume;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4ForwardHcalDisplayAction;
+class PHG4ShowerLibraryModel;
 class PHG4Subsystem;
 class PHParameters;
 
@@ -44,6 +45,9 @@ class PHG4ForwardHcalDetector : public PHG4Detector
 
   int get_Layer() const { return m_Layer; }
 
+  //! frozen shower library, nullptr if not enabled
+  PHG4ShowerLibraryModel *GetShowerModel() const { return m_ShowerModel; }
+
  private:
   G4LogicalVolume *ConstructTower();
   int PlaceTower(G4LogicalVolume *envelope, G4LogicalVolume *tower);
@@ -60,6 +64,7 @@ class PHG4ForwardHcalDetector : public PHG4Detector
 
   PHG4ForwardHcalDisplayAction *m_DisplayAction = nullptr;
   PHParameters *m_Params = nullptr;
+  PHG4ShowerLibraryModel *m_ShowerModel = nullptr;
 
   int m_ActiveFlag = 1;
   int m_AbsorberActiveFlag = 0;
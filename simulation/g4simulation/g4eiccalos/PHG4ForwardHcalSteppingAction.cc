@@ -1,6 +1,9 @@
 #include "PHG4ForwardHcalSteppingAction.h"
 
 #include "PHG4ForwardHcalDetector.h"
+#include "PHG4ShowerLibraryModel.h"
+
+#include <g4eicutils/PHG4TrackKiller.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -45,6 +48,7 @@ PHG4ForwardHcalSteppingAction::PHG4ForwardHcalSteppingAction(PHG4ForwardHcalDete
   , m_AbsorberTruthFlag(parameters->get_int_param("absorberactive"))
   , m_SupportTruthFlag(parameters->get_int_param("supportactive"))
   , m_BlackHoleFlag(parameters->get_int_param("blackhole"))
+  , m_TrackKiller(new PHG4TrackKiller(parameters))
 {
 }
 
@@ -55,22 +59,24 @@ PHG4ForwardHcalSteppingAction::~PHG4ForwardHcalSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  m_TrackKiller->Print(GetName());
+  delete m_TrackKiller;
 }
 
 //____________________________________________________________________________..
 bool PHG4ForwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
 
-  // m_Detector->IsInForwardHcal(volume)
-  // returns
+  // GetTowerIndex returns
   //  0 is outside of Forward HCAL
   //  1 is inside scintillator
   // -1 is inside absorber (dead material)
   // -2 is inside the support (or other volume)
 
-  int whichactive = m_Detector->IsInForwardHcal(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
@@ -78,9 +84,6 @@ bool PHG4ForwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
   }
 
   int layer_id = m_Detector->get_Layer();
-  unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
-  int idx_j = icopy >> 16;
-  int idx_k = icopy & 0xFFFF;
   
   /* Get energy deposited by this step */
   double edep = aStep->GetTotalEnergyDeposit() / GeV;
@@ -96,6 +99,11 @@ bool PHG4ForwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
     G4Track* killtrack = const_cast<G4Track*>(aTrack);
     killtrack->SetTrackStatus(fStopAndKill);
   }
+  // slow neutrons etc. which are too late for the readout
+  else
+  {
+    m_TrackKiller->Apply(const_cast<G4Track*>(aTrack));
+  }
 
   /* Make sure we are in a volume */
   if (m_ActiveFlag)
@@ -278,6 +286,46 @@ bool PHG4ForwardHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool
   }
 }
 
+//____________________________________________________________________________..
+int PHG4ForwardHcalSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInForwardHcal(touch->GetVolume());
+  if (whichactive)
+  {
+    unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
+    idx_j = icopy >> 16;
+    idx_k = icopy & 0xFFFF;
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+void PHG4ForwardHcalSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_HitContainer : ((whichactive == -1) ? m_AbsorberHitContainer : m_SupportHitContainer);
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_Layer(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4ForwardHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -304,4 +352,8 @@ void PHG4ForwardHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNod
       std::cout << "PHG4ForwardHcalSteppingAction::SetTopNode - unable to find " << m_SupportNodeName << std::endl;
     }
   }
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
@@ -3,20 +3,25 @@
 #ifndef G4DETECTORS_PHG4FORWARDHCALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4FORWARDHCALSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 #include <Geant4/G4TouchableHandle.hh>
 
 class G4Step;
+class G4Track;
 class G4VPhysicalVolume;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4ForwardHcalDetector;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Shower;
+class PHG4TrackKiller;
 class PHParameters;
 
-class PHG4ForwardHcalSteppingAction : public PHG4SteppingAction
+class PHG4ForwardHcalSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -32,6 +37,12 @@ class PHG4ForwardHcalSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   void SetInterfacePointers(PHCompositeNode*) override;
 
+  //! tower index from the copy numbers, returns IsInForwardHcal() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! hits of the frozen showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
   void SetHitNodeName(const std::string& nam) { m_HitNodeName = nam; }
   void SetAbsorberNodeName(const std::string& nam) { m_AbsorberNodeName = nam; }
   void SetSupportNodeName(const std::string& nam) { m_SupportNodeName = nam; }
@@ -53,6 +64,8 @@ class PHG4ForwardHcalSteppingAction : public PHG4SteppingAction
   int m_SupportTruthFlag = 0;
   int m_BlackHoleFlag = 0;
 
+  PHG4TrackKiller* m_TrackKiller = nullptr;
+
   std::string m_HitNodeName;
   std::string m_AbsorberNodeName;
   std::string m_SupportNodeName;
@@ -4,6 +4,8 @@
 #include "PHG4ForwardHcalDisplayAction.h"
 #include "PHG4ForwardHcalSteppingAction.h"
 
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
@@ -42,6 +44,12 @@ PHG4ForwardHcalSubsystem::~PHG4ForwardHcalSubsystem()
 //_______________________________________________________________________
 int PHG4ForwardHcalSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
 {
+  // the shower library model of the detector uses the fast simulation physics
+  if (!GetParams()->get_string_param("showerlib_file").empty())
+  {
+    PHG4CalorimeterRegion::RegisterFastSimulationPhysics();
+  }
+
   PHNodeIterator iter(topNode);
   PHCompositeNode* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
 
@@ -166,6 +174,25 @@ void PHG4ForwardHcalSubsystem::SetDefaultParameters()
   set_default_string_param("absorber", "G4_Fe");
   set_default_string_param("support", "G4_Fe");
 
+  // range cuts (cm) of the REGION_<name> G4Region
+  for (const auto &par : PHG4CalorimeterRegion::DefaultParameters())
+  {
+    set_default_double_param(par.first, par.second);
+  }
+
+  // frozen shower library (PHG4ShowerLibraryBuilder) replacing the particles
+  // of the library between showerlib_emin and showerlib_emax (GeV) in the
+  // REGION_<name> region, an empty file name disables it
+  set_default_string_param("showerlib_file", "");
+  set_default_double_param("showerlib_emin", 0.1);
+  set_default_double_param("showerlib_emax", 2.);
+
+  // kill the particles in kill_particles (comma separated G4 names) after
+  // kill_time (ns) or below kill_ekin (GeV), values <= 0 disable the cut
+  set_default_string_param("kill_particles", "neutron");
+  set_default_double_param("kill_time", -1.);
+  set_default_double_param("kill_ekin", -1.);
+
   return;
 }
 
@@ -1,5 +1,8 @@
 #include "PHG4HybridHomogeneousCalorimeterDetector.h"
 #include "PHG4HybridHomogeneousCalorimeterDisplayAction.h"
+#include "PHG4EMShowerModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -15,6 +18,7 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4String.hh>          // for G4String
 #include <Geant4/G4SubtractionSolid.hh>
@@ -90,6 +94,14 @@ void PHG4HybridHomogeneousCalorimeterDetector::ConstructMe(G4LogicalVolume* logi
   /* Construct single calorimeter tower */
   G4LogicalVolume* singletower = ConstructTower();
 
+  /* towers are placed directly in the world, each of them is a root of the region */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(singletower);
+  if (m_Params->get_int_param("fastshower"))
+  {
+    m_ShowerModel = new PHG4EMShowerModel(GetName(), region, m_Params);
+  }
+
   /* Place calorimeter tower within envelope */
   //  PlaceTower(eemc_envelope_log, singletower);
   PlaceTower(logicWorld, singletower);
@@ -2,6 +2,7 @@
 
 #include "PHG4CrystalCalorimeterDefs.h"
 #include "PHG4HybridHomogeneousCalorimeterDetector.h"
+#include "PHG4EMShowerModel.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -59,15 +60,15 @@ PHG4HybridHomogeneousCalorimeterSteppingAction::~PHG4HybridHomogeneousCalorimete
 bool PHG4HybridHomogeneousCalorimeterSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
 
-  // m_Detector->IsInCrystalCalorimeter(volume)
-  // returns
+  // GetTowerIndex returns
   //  0 is outside of Crystal Calorimeter
   //  1 is inside scintillator scrystal
   // -1 is absorber (dead material)
 
-  int whichactive = m_Detector->IsInCrystalCalorimeter(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
@@ -75,33 +76,6 @@ bool PHG4HybridHomogeneousCalorimeterSteppingAction::UserSteppingAction(const G4
   }
 
   int layer_id = m_Detector->get_DetectorId();
-  int idx_j = -1;
-  int idx_k = -1;
-
-  if (whichactive > 0)  // in crystal
-  {
-    // Find indices of crystal containing this step. The indices are
-    // coded into the copy number of the physical volume and we extract them from there
-    if (whichactive == PHG4CrystalCalorimeterDefs::CaloType::projective)
-    {
-      int j[3];
-      int k[3];
-      for (int i = 0; i < 3; i++)
-      {
-        unsigned int icopy = touch->GetVolume(i)->GetCopyNo();
-        j[i] = icopy >> 16;
-        k[i] = icopy & 0xFFFF;
-      }
-      idx_j = j[0] + j[1] * 2 + j[2] * 4;
-      idx_k = k[0] + k[1] * 2 + k[2] * 4;
-    }
-    if (whichactive == PHG4CrystalCalorimeterDefs::CaloType::nonprojective)
-    {
-      unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
-      idx_j = icopy >> 16;
-      idx_k = icopy & 0xFFFF;
-    }
-  }
 
   /* Get energy deposited by this step */
   G4double edep = aStep->GetTotalEnergyDeposit() / GeV;
@@ -262,6 +236,65 @@ bool PHG4HybridHomogeneousCalorimeterSteppingAction::UserSteppingAction(const G4
   }
 }
 
+//____________________________________________________________________________..
+int PHG4HybridHomogeneousCalorimeterSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInCrystalCalorimeter(touch->GetVolume());
+
+  if (whichactive > 0)  // in crystal
+  {
+    // Find indices of crystal containing this step. The indices are
+    // coded into the copy number of the physical volume and we extract them from there
+    if (whichactive == PHG4CrystalCalorimeterDefs::CaloType::projective)
+    {
+      int j[3];
+      int k[3];
+      for (int i = 0; i < 3; i++)
+      {
+        unsigned int icopy = touch->GetVolume(i)->GetCopyNo();
+        j[i] = icopy >> 16;
+        k[i] = icopy & 0xFFFF;
+      }
+      idx_j = j[0] + j[1] * 2 + j[2] * 4;
+      idx_k = k[0] + k[1] * 2 + k[2] * 4;
+    }
+    if (whichactive == PHG4CrystalCalorimeterDefs::CaloType::nonprojective)
+    {
+      unsigned int icopy = touch->GetVolume(1)->GetCopyNo();
+      idx_j = icopy >> 16;
+      idx_k = icopy & 0xFFFF;
+    }
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+void PHG4HybridHomogeneousCalorimeterSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_HitContainer : m_AbsorberHitContainer;
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_DetectorId(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4HybridHomogeneousCalorimeterSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -296,4 +329,8 @@ void PHG4HybridHomogeneousCalorimeterSteppingAction::SetInterfacePointers(PHComp
       std::cout << "PHG4HybridHomogeneousCalorimeterSteppingAction::SetInterfacePointers - unable to find " << absorbernodename << std::endl;
     }
   }
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
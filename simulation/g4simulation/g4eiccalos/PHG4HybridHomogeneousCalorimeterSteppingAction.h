@@ -3,11 +3,14 @@
 #ifndef G4DETECTORS_PHG4HYBRIDHOMOGENEOUSCALORIMETERSTEPPINGACTION_H
 #define G4DETECTORS_PHG4HYBRIDHOMOGENEOUSCALORIMETERSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 #include <Geant4/G4TouchableHandle.hh>  // for G4TouchableHandle
 
 class G4Step;
+class G4Track;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4HybridHomogeneousCalorimeterDetector;
@@ -16,7 +19,7 @@ class PHG4HitContainer;
 class PHG4Shower;
 class PHParameters;
 
-class PHG4HybridHomogeneousCalorimeterSteppingAction : public PHG4SteppingAction
+class PHG4HybridHomogeneousCalorimeterSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -31,6 +34,12 @@ class PHG4HybridHomogeneousCalorimeterSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
+  //! crystal index from the copy numbers, returns IsInCrystalCalorimeter() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! hits of the parametrised EM showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
  private:
   //! pointer to the detector
   PHG4HybridHomogeneousCalorimeterDetector* m_Detector = nullptr;
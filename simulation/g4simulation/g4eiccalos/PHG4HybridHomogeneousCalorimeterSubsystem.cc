@@ -4,6 +4,8 @@
 #include "PHG4HybridHomogeneousCalorimeterSteppingAction.h"
 #include "PHG4ProjCrystalCalorimeterDetector.h"
 
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
 #include <phparameter/PHParameters.h>
 
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
@@ -41,6 +43,12 @@ PHG4HybridHomogeneousCalorimeterSubsystem::~PHG4HybridHomogeneousCalorimeterSubs
 //_______________________________________________________________________
 int PHG4HybridHomogeneousCalorimeterSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
 {
+  // the parametrised EM shower model of the detector uses the fast simulation physics
+  if (GetParams()->get_int_param("fastshower"))
+  {
+    PHG4CalorimeterRegion::RegisterFastSimulationPhysics();
+  }
+
   // create display settings before detector
   m_DisplayAction = new PHG4HybridHomogeneousCalorimeterDisplayAction(Name());
   // create detector
@@ -153,6 +161,25 @@ void PHG4HybridHomogeneousCalorimeterSubsystem::SetDefaultParameters()
   set_default_string_param("material", "G4_PbWO4");
   set_default_string_param("mappingtower", "");
   set_default_string_param("mapping4x4", "");
+
+  // range cuts (cm) of the REGION_<name> G4Region
+  for (const auto &par : PHG4CalorimeterRegion::DefaultParameters())
+  {
+    set_default_double_param(par.first, par.second);
+  }
+
+  // parametrised EM showers in the REGION_<name> region (off by default),
+  // e+, e- and gammas above fastshower_emin (GeV) are not tracked further.
+  // Shower medium (PbWO4): radiation length and Moliere radius (cm),
+  // critical energy (MeV), effective Z
+  set_default_int_param("fastshower", 0);
+  set_default_double_param("fastshower_emin", 1.);
+  set_default_double_param("fastshower_x0", 0.89);
+  set_default_double_param("fastshower_rm", 2.0);
+  set_default_double_param("fastshower_ec", 9.6);
+  set_default_double_param("fastshower_z", 68.);
+  set_default_double_param("fastshower_spots_per_gev", 200.);
+
   return;
 }
 
@@ -1,5 +1,8 @@
 #include "PHG4LFHcalDetector.h"
 #include "PHG4LFHcalDisplayAction.h"
+#include "PHG4ShowerLibraryModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -10,6 +13,7 @@
 #include <phool/recoConsts.h>
 
 #include <Geant4/G4Box.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4Trap.hh>
 #include <Geant4/G4Cons.hh>
 #include <Geant4/G4LogicalVolume.hh>
@@ -109,6 +113,14 @@ void PHG4LFHcalDetector::ConstructMe(G4LogicalVolume* logicWorld)
 
   m_DisplayAction->AddVolume(hcal_envelope_log, "LFHcalEnvelope");
 
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), m_Params);
+  region->AddRootLogicalVolume(hcal_envelope_log);
+  if (!m_Params->get_string_param("showerlib_file").empty())
+  {
+    m_ShowerModel = new PHG4ShowerLibraryModel(GetName(), region, m_Params);
+  }
+
   /* Define rotation attributes for envelope cone */
   G4RotationMatrix hcal_rotm;
   hcal_rotm.rotateX(m_Params->get_double_param("rot_x") * deg);
@@ -1,6 +1,9 @@
 #include "PHG4LFHcalSteppingAction.h"
 
 #include "PHG4LFHcalDetector.h"
+#include "PHG4ShowerLibraryModel.h"
+
+#include <g4eicutils/PHG4TrackKiller.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -45,6 +48,7 @@ PHG4LFHcalSteppingAction::PHG4LFHcalSteppingAction(PHG4LFHcalDetector* detector,
   , m_AbsorberTruthFlag(parameters->get_int_param("absorberactive"))
   , m_BlackHoleFlag(parameters->get_int_param("blackhole"))
   , m_NlayersPerTowerSeg(parameters->get_int_param("nlayerspertowerseg"))
+  , m_TrackKiller(new PHG4TrackKiller(parameters))
 {
 }
 
@@ -55,35 +59,34 @@ PHG4LFHcalSteppingAction::~PHG4LFHcalSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  m_TrackKiller->Print(GetName());
+  delete m_TrackKiller;
 }
 
 //____________________________________________________________________________..
 bool PHG4LFHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
 {
   G4TouchableHandle touch = aStep->GetPreStepPoint()->GetTouchableHandle();
-  G4VPhysicalVolume* volume = touch->GetVolume();
-  // m_Detector->IsInLFHcal(volume)
-  // returns
+
+  // GetTowerIndex returns
   //  0 is outside of Forward HCAL
   //  1 is inside scintillator
   // -1 is inside absorber (dead material)
 
-  int whichactive = m_Detector->IsInLFHcal(volume);
+  int idx_j = -1;
+  int idx_k = -1;
+  int whichactive = GetTowerIndex(touch(), idx_j, idx_k);
 
   if (!whichactive)
   {
     return false;
   }
+  int idx_l = GetTowerLayer(touch());
 
   int layer_id = m_Detector->get_Layer();
-  unsigned int icopy = touch->GetVolume(3)->GetCopyNo();
-  unsigned int layer = touch->GetVolume(1)->GetCopyNo();
-  int idx_j = icopy >> 16;
-  int idx_k = icopy & 0xFFFF;
-  int idx_l = (int)(layer / m_NlayersPerTowerSeg);
 
   if (Verbosity() > 2)
-    std::cout << "\t" << icopy << "\t idx_j =" << idx_j << ", idx_k =" << idx_k << ", idx_l =" << idx_l <<"\t id:" << icopy << "\t layer:" << layer << std::endl;
+    std::cout << "\t idx_j =" << idx_j << ", idx_k =" << idx_k << ", idx_l =" << idx_l << std::endl;
   
   /* Get energy deposited by this step */
   double edep = aStep->GetTotalEnergyDeposit() / GeV;
@@ -99,6 +102,11 @@ bool PHG4LFHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     G4Track* killtrack = const_cast<G4Track*>(aTrack);
     killtrack->SetTrackStatus(fStopAndKill);
   }
+  // slow neutrons etc. which are too late for the readout
+  else
+  {
+    m_TrackKiller->Apply(const_cast<G4Track*>(aTrack));
+  }
 
   /* Make sure we are in a volume */
   if (m_ActiveFlag)
@@ -273,6 +281,53 @@ bool PHG4LFHcalSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   }
 }
 
+//____________________________________________________________________________..
+int PHG4LFHcalSteppingAction::GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const
+{
+  int whichactive = m_Detector->IsInLFHcal(touch->GetVolume());
+  if (whichactive)
+  {
+    unsigned int icopy = touch->GetVolume(3)->GetCopyNo();
+    idx_j = icopy >> 16;
+    idx_k = icopy & 0xFFFF;
+  }
+  return whichactive;
+}
+
+//____________________________________________________________________________..
+int PHG4LFHcalSteppingAction::GetTowerLayer(const G4VTouchable* touch) const
+{
+  unsigned int layer = touch->GetVolume(1)->GetCopyNo();
+  return (int) (layer / m_NlayersPerTowerSeg);
+}
+
+//____________________________________________________________________________..
+void PHG4LFHcalSteppingAction::SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track)
+{
+  PHG4HitContainer* container = (whichactive > 0) ? m_HitContainer : m_AbsorberHitContainer;
+  if (!m_ActiveFlag || !container)
+  {
+    delete hit;
+    return;
+  }
+  PHG4Shower* shower = nullptr;
+  if (G4VUserTrackInformation* p = track->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      hit->set_trkid(pp->GetUserTrackId());
+      hit->set_shower_id(pp->GetShower()->get_id());
+      shower = pp->GetShower();
+      pp->SetKeep(1);  // we want to keep the track
+    }
+  }
+  container->AddHit(m_Detector->get_Layer(), hit);
+  if (shower)
+  {
+    shower->add_g4hit_id(container->GetID(), hit->get_hit_id());
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4LFHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -306,5 +361,8 @@ void PHG4LFHcalSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
       std::cout << "PHG4LFHcalSteppingAction::SetTopNode - unable to find " << absorbernodename << std::endl;
     }
   }
-    
+  if (m_Detector->GetShowerModel())
+  {
+    m_Detector->GetShowerModel()->SetHitHandler(this);
+  }
 }
@@ -3,20 +3,25 @@
 #ifndef G4DETECTORS_PHG4LFHCALSTEPPINGACTION_H
 #define G4DETECTORS_PHG4LFHCALSTEPPINGACTION_H
 
+#include "PHG4ShowerHitHandler.h"
+
 #include <g4main/PHG4SteppingAction.h>
 
 #include <Geant4/G4TouchableHandle.hh>
 
 class G4Step;
+class G4Track;
 class G4VPhysicalVolume;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4LFHcalDetector;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Shower;
+class PHG4TrackKiller;
 class PHParameters;
 
-class PHG4LFHcalSteppingAction : public PHG4SteppingAction
+class PHG4LFHcalSteppingAction : public PHG4SteppingAction, public PHG4ShowerHitHandler
 {
  public:
   //! constructor
@@ -31,6 +36,15 @@ class PHG4LFHcalSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
+  //! tower index from the copy numbers, returns IsInLFHcal() of the volume
+  int GetTowerIndex(const G4VTouchable* touch, int& idx_j, int& idx_k) const override;
+
+  //! longitudinal tower segment from the layer copy number
+  int GetTowerLayer(const G4VTouchable* touch) const override;
+
+  //! hits of the frozen showers
+  void SaveShowerHit(PHG4Hit* hit, const int whichactive, const G4Track* track) override;
+
  private:
   //! pointer to the detector
   PHG4LFHcalDetector* m_Detector = nullptr;
@@ -46,6 +60,8 @@ class PHG4LFHcalSteppingAction : public PHG4SteppingAction
   int m_AbsorberTruthFlag = 0;
   int m_BlackHoleFlag = 0;
   int m_NlayersPerTowerSeg = 10;
+
+  PHG4TrackKiller* m_TrackKiller = nullptr;
 };
 
 #endif  // G4DETECTORS_PHG4LFHCALSTEPPINGACTION_H
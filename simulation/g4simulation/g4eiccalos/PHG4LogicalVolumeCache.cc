@@ -0,0 +1,45 @@
+#include "PHG4LogicalVolumeCache.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+  const double dimension_quantum = 1e-6;
+}
+
+PHG4LogicalVolumeCache::Key PHG4LogicalVolumeCache::MakeKey(const std::string &kind, const G4Material *material, const std::vector<double> &dims)
+{
+  std::vector<long long> quantised;
+  quantised.reserve(dims.size());
+  for (double value : dims)
+  {
+    quantised.push_back(std::llround(value / dimension_quantum));
+  }
+  return Key(kind, material, quantised);
+}
+
+G4LogicalVolume *PHG4LogicalVolumeCache::Find(const std::string &kind, const G4Material *material, const std::vector<double> &dims)
+{
+  auto iter = m_Volumes.find(MakeKey(kind, material, dims));
+  if (iter == m_Volumes.end())
+  {
+    m_Misses++;
+    return nullptr;
+  }
+  m_Hits++;
+  return iter->second;
+}
+
+void PHG4LogicalVolumeCache::Add(const std::string &kind, const G4Material *material, const std::vector<double> &dims, G4LogicalVolume *logvol)
+{
+  m_Volumes[MakeKey(kind, material, dims)] = logvol;
+}
+
+void PHG4LogicalVolumeCache::Print(const std::string &name) const
+{
+  const unsigned int lookups = m_Hits + m_Misses;
+  std::cout << name << ": " << m_Volumes.size() << " distinct logical volumes for "
+            << lookups << " requests, cache hit rate "
+            << ((lookups) ? 100. * m_Hits / lookups : 0.) << "%" << std::endl;
+}
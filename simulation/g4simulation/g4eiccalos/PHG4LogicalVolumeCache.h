@@ -0,0 +1,46 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4LOGICALVOLUMECACHE_H
+#define G4DETECTORS_PHG4LOGICALVOLUMECACHE_H
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class G4LogicalVolume;
+class G4Material;
+
+/*!
+ * \brief logical volumes of a detector keyed on their kind, material and
+ * dimensions, so that towers of identical shape share one solid and logical
+ * volume and only differ in their placement
+ *
+ * The dimensions (G4 units) are quantised to 1e-6 (nm, urad) to absorb the
+ * rounding of values read from the mapping files.
+ */
+class PHG4LogicalVolumeCache
+{
+ public:
+  PHG4LogicalVolumeCache() = default;
+  ~PHG4LogicalVolumeCache() = default;
+
+  //! cached volume, nullptr if there is none yet
+  G4LogicalVolume *Find(const std::string &kind, const G4Material *material, const std::vector<double> &dims);
+
+  void Add(const std::string &kind, const G4Material *material, const std::vector<double> &dims, G4LogicalVolume *logvol);
+
+  //! number of volumes and hit rate
+  void Print(const std::string &name) const;
+
+ private:
+  typedef std::tuple<std::string, const G4Material *, std::vector<long long>> Key;
+
+  static Key MakeKey(const std::string &kind, const G4Material *material, const std::vector<double> &dims);
+
+  std::map<Key, G4LogicalVolume *> m_Volumes;
+  unsigned int m_Hits = 0;
+  unsigned int m_Misses = 0;
+};
+
+#endif
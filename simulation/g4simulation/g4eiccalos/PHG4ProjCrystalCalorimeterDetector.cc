@@ -2,6 +2,10 @@
 
 #include "PHG4CrystalCalorimeterDetector.h"
 #include "PHG4CrystalCalorimeterDisplayAction.h"
+#include "PHG4EMShowerModel.h"
+#include "PHG4LogicalVolumeCache.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -12,6 +16,7 @@
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4String.hh>          // for G4String
 #include <Geant4/G4SubtractionSolid.hh>
@@ -104,6 +109,14 @@ void PHG4ProjCrystalCalorimeterDetector::ConstructMe(G4LogicalVolume *logicWorld
 
   G4LogicalVolume *ecal_envelope_log = new G4LogicalVolume(ecal_envelope_cone, WorldMaterial, G4String("eEcal_envelope"), 0, 0, 0);
   GetDisplayAction()->AddVolume(ecal_envelope_log, "Envelope");
+
+  /* region with the production cuts of this calorimeter */
+  G4Region *region = PHG4CalorimeterRegion::Create(GetName(), GetParams());
+  region->AddRootLogicalVolume(ecal_envelope_log);
+  if (GetParams()->get_int_param("fastshower"))
+  {
+    m_ShowerModel = new PHG4EMShowerModel(GetName(), region, GetParams());
+  }
   /* Define rotation attributes for envelope cone */
   G4RotationMatrix ecal_rotm;
   ecal_rotm.rotateX(GetParams()->get_double_param("rot_x") * deg);
@@ -134,7 +147,7 @@ void PHG4ProjCrystalCalorimeterDetector::GetCarbonFiberSpacing(G4double &CF_widt
   Air_Cry = 0.60 * mm;   //Air gap between crystal and crystal
 }
 
-int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_logic)
+G4LogicalVolume *PHG4ProjCrystalCalorimeterDetector::GetTwoByTwoUnit()
 {
   //*************************************
   //**********Define Materials***********
@@ -163,6 +176,13 @@ int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_log
   G4double dy_back_small = (_dy_back - (2.0 * carbon_fiber_width) - (2.0 * air_gap_carbon_fiber) - air_gap_crystals) / 2.0;    //Full height of the back crystal face
   G4double dz = _dz_crystal;
 
+  const std::vector<G4double> dims = {dx_front_small, dy_front_small, dx_back_small, dy_back_small, dz};
+  G4LogicalVolume *Two_by_Two_logic = m_VolumeCache.Find("2_by_2_unit", material_crystal, dims);
+  if (Two_by_Two_logic)
+  {
+    return Two_by_Two_logic;
+  }
+
   //Vertices of the primary, irregularly shaped crystal put into a vector
   std::vector<G4TwoVector> vertices;
   vertices.push_back(G4TwoVector(0, 0));
@@ -203,13 +223,70 @@ int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_log
                                          TwoByTwo_dy2,  //Half length on the large face in y
                                          TwoByTwo_dz);  //Half length in z
 
-  G4LogicalVolume *Two_by_Two_logic = new G4LogicalVolume(Two_by_Two_solid,
-                                                          WorldMaterial,
-                                                          "2_by_2_unit",
-                                                          0, 0, 0);
+  Two_by_Two_logic = new G4LogicalVolume(Two_by_Two_solid,
+                                          WorldMaterial,
+                                          "2_by_2_unit",
+                                          0, 0, 0);
 
   GetDisplayAction()->AddVolume(Two_by_Two_logic, "TwoByTwo");
 
+  //**************************************************
+  //Place the single crystal in the 2x2 volume 4 times
+  //**************************************************
+
+  //The 2x2 block is given by the lines with mapping index 1 of the 4x4 mapping file
+  ifstream in(GetParams()->get_string_param("mapping4x4"));
+  if (!in.is_open())
+  {
+    cout << endl
+         << "*******************************************************************" << endl;
+    cout << "ERROR in 2 by 2 crystal mapping ";
+    cout << "Failed to open " << GetParams()->get_string_param("mapping4x4") << " --- Exiting program." << endl;
+    cout << "*******************************************************************" << endl
+         << endl;
+    gSystem->Exit(1);
+  }
+  const int NumberOfIndices = 9;  //Number of indices in mapping file for 4x4 block
+  double TwoByTwo[NumberOfIndices];
+  while (in >> TwoByTwo[0])
+  {
+    for (int k = 1; k < NumberOfIndices; k++)
+    {
+      in >> TwoByTwo[k];
+    }
+    G4int MappingIndex = TwoByTwo[8];
+    if (MappingIndex != 1)
+    {
+      continue;
+    }
+    G4int j_idx = TwoByTwo[0];
+    G4int k_idx = TwoByTwo[1];
+    G4ThreeVector Crystal_Center = G4ThreeVector(TwoByTwo[2] * mm, TwoByTwo[3] * mm, TwoByTwo[4] * mm);
+
+    G4RotationMatrix *Rot = new G4RotationMatrix();  //rotation matrix for the placement of each crystal
+    Rot->rotateZ(TwoByTwo[7] * rad);
+
+    string crystal_name = _crystallogicnameprefix + "_j_" + to_string(j_idx) + "_k_" + to_string(k_idx);
+    int copyno = (j_idx << 16) + k_idx;
+    G4VPhysicalVolume *physvol = new G4PVPlacement(Rot, Crystal_Center,
+                                                   crystal_logic_small,
+                                                   crystal_name,
+                                                   Two_by_Two_logic,
+                                                   0, copyno, OverlapCheck());
+    m_ActiveVolumeSet.insert(physvol);
+  }
+  in.close();
+
+  m_VolumeCache.Add("2_by_2_unit", material_crystal, dims, Two_by_Two_logic);
+  return Two_by_Two_logic;
+}
+
+int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_logic)
+{
+  //The filled 2 x 2 unit is identical in all units, it is built only once
+  G4LogicalVolume *Two_by_Two_logic = GetTwoByTwoUnit();
+  G4VSolid *Two_by_Two_solid = Two_by_Two_logic->GetSolid();
+
   //*************************************************************
   //Read in mapping file for a single 2 x 2 block and 4 x 4 block
   //*************************************************************
@@ -259,50 +336,10 @@ int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_log
   }
   in.close();
 
-  //**************************************************
-  //Place the single crystal in the 2x2 volume 4 times
-  //**************************************************
-
   G4int j_idx, k_idx;
   G4double x_cent, y_cent, z_cent, rot_x, rot_y, rot_z;
   G4int MappingIndex;
 
-  j = 0;
-  while (j_cry > j)
-  {
-    MappingIndex = TwoByTwo[j][8];
-    if (MappingIndex == 1)
-    {
-      j_idx = TwoByTwo[j][0];
-      k_idx = TwoByTwo[j][1];
-      x_cent = TwoByTwo[j][2];
-      y_cent = TwoByTwo[j][3];
-      z_cent = TwoByTwo[j][4];
-      //rot_x = TwoByTwo[j][5];
-      //rot_y = TwoByTwo[j][6];
-      rot_z = TwoByTwo[j][7];
-
-      G4ThreeVector Crystal_Center = G4ThreeVector(x_cent * mm, y_cent * mm, z_cent * mm);
-
-      G4RotationMatrix *Rot = new G4RotationMatrix();  //rotation matrix for the placement of each crystal
-      Rot->rotateX(0 * rad);
-      Rot->rotateY(0 * rad);
-      Rot->rotateZ(rot_z * rad);
-
-      string crystal_name = _crystallogicnameprefix + "_j_" + to_string(j_idx) + "_k_" + to_string(k_idx);
-      int copyno = (j_idx << 16) + k_idx;
-      G4VPhysicalVolume *physvol = new G4PVPlacement(Rot, Crystal_Center,
-                                                     crystal_logic_small,
-                                                     crystal_name,
-                                                     Two_by_Two_logic,
-                                                     0, copyno, OverlapCheck());
-      m_ActiveVolumeSet.insert(physvol);
-      j_idx = k_idx = 0;
-      x_cent = y_cent = z_cent = rot_x = rot_y = rot_z = 0.0;
-    }
-    j++;
-  }
-
   //*************************************************************
   //Place the 2x2 volume in the 4x4 volume 4 times, with rotation
   //*************************************************************
@@ -513,79 +550,9 @@ int PHG4ProjCrystalCalorimeterDetector::Fill4x4Unit(G4LogicalVolume *crystal_log
 
 int PHG4ProjCrystalCalorimeterDetector::FillSpecialUnit(G4LogicalVolume *crystal_logic, G4int ident)
 {
-  //*************************************
-  //**********Define Materials***********
-  //*************************************
-
-  //Crystal Material (Default is Lead Tungstate)
-  G4Material *material_crystal = G4Material::GetMaterial(GetParams()->get_string_param("material"));
-
-  recoConsts *rc = recoConsts::instance();
-  G4Material *WorldMaterial = G4Material::GetMaterial(rc->get_StringFlag("WorldMaterial"));
-
-  //*************************************
-  //**********Build First Crystal********
-  //*************************************
-
-  //Crystal Dimensions determined by the _dx_front, with various gaps and carbon fiber widths subtracted out
-
-  //Parameters of the spacing given by PANDA document arXiv:0810.1216v1 Fig. 7.25
-  G4double carbon_fiber_width, air_gap_carbon_fiber, air_gap_crystals;
-  GetCarbonFiberSpacing(carbon_fiber_width, air_gap_carbon_fiber, air_gap_crystals);
-
-  //Crystal Dimensions
-  G4double dx_front_small = (_dx_front - (2.0 * carbon_fiber_width) - (2.0 * air_gap_carbon_fiber) - air_gap_crystals) / 2.0;  //Full width of the front crystal face
-  G4double dy_front_small = (_dy_front - (2.0 * carbon_fiber_width) - (2.0 * air_gap_carbon_fiber) - air_gap_crystals) / 2.0;  //Full height of the front crystal face
-  G4double dx_back_small = (_dx_back - (2.0 * carbon_fiber_width) - (2.0 * air_gap_carbon_fiber) - air_gap_crystals) / 2.0;    //Full width of the back crystal face
-  G4double dy_back_small = (_dy_back - (2.0 * carbon_fiber_width) - (2.0 * air_gap_carbon_fiber) - air_gap_crystals) / 2.0;    //Full height of the back crystal face
-  G4double dz = _dz_crystal;
-
-  //Vertices of the primary, irregularly shaped crystal put into a vector
-  std::vector<G4TwoVector> vertices;
-  vertices.push_back(G4TwoVector(0, 0));
-  vertices.push_back(G4TwoVector(0, dy_front_small));
-  vertices.push_back(G4TwoVector(dx_front_small, dy_front_small));
-  vertices.push_back(G4TwoVector(dx_front_small, 0));
-  vertices.push_back(G4TwoVector(0, 0));
-  vertices.push_back(G4TwoVector(0, dy_back_small));
-  vertices.push_back(G4TwoVector(dx_back_small, dy_back_small));
-  vertices.push_back(G4TwoVector(dx_back_small, 0));
-
-  //Create the primary, irregularly shaped crystal
-  G4VSolid *crystal_solid_small = new G4GenericTrap(G4String("eEcal_crystal"),
-                                                    dz,
-                                                    vertices);
-
-  G4LogicalVolume *crystal_logic_small = new G4LogicalVolume(crystal_solid_small,
-                                                             material_crystal,
-                                                             "eEcal_crystal",
-                                                             0, 0, 0);
-
-  GetDisplayAction()->AddVolume(crystal_logic_small, "Crystal");
-
-  //****************************************************
-  //Build the solid/logical volume for the 2 x 2 crystal
-  //****************************************************
-
-  G4double TwoByTwo_dx1 = ((2.0 * dx_front_small) + (2.0 * air_gap_carbon_fiber) + air_gap_crystals) / 2.0;
-  G4double TwoByTwo_dx2 = ((2.0 * dx_back_small) + (2.0 * air_gap_carbon_fiber) + air_gap_crystals) / 2.0;
-  G4double TwoByTwo_dy1 = TwoByTwo_dx1;
-  G4double TwoByTwo_dy2 = TwoByTwo_dx2;
-  G4double TwoByTwo_dz = _dz_crystal;
-
-  G4VSolid *Two_by_Two_solid = new G4Trd(G4String("Two_by_Two_solid"),
-                                         TwoByTwo_dx1,  //Half length on the small face in x
-                                         TwoByTwo_dx2,  //Half length on the large face in x
-                                         TwoByTwo_dy1,  //Half length on the small face in y
-                                         TwoByTwo_dy2,  //Half length on the large face in y
-                                         TwoByTwo_dz);  //Half length in z
-
-  G4LogicalVolume *Two_by_Two_logic = new G4LogicalVolume(Two_by_Two_solid,
-                                                          WorldMaterial,
-                                                          "2_by_2_unit",
-                                                          0, 0, 0);
-
-  GetDisplayAction()->AddVolume(Two_by_Two_logic, "TwoByTwo");
+  //The filled 2 x 2 unit is identical in all units, it is built only once
+  G4LogicalVolume *Two_by_Two_logic = GetTwoByTwoUnit();
+  G4VSolid *Two_by_Two_solid = Two_by_Two_logic->GetSolid();
 
   //*************************************************************
   //Read in mapping file for a single 2 x 2 block and 4 x 4 block
@@ -635,52 +602,11 @@ int PHG4ProjCrystalCalorimeterDetector::FillSpecialUnit(G4LogicalVolume *crystal
     k = 0;
   }
   in.close();
-  //**************************************************
-  //Place the single crystal in the 2x2 volume 4 times
-  //**************************************************
 
   G4int j_idx, k_idx;
   G4double x_cent, y_cent, z_cent, rot_x, rot_y, rot_z;
   G4int MappingIndex;
 
-  j = 0;
-  while (j_cry > j)
-  {
-    MappingIndex = TwoByTwo[j][8];
-    if (MappingIndex == 1)
-    {
-      j_idx = TwoByTwo[j][0];
-      k_idx = TwoByTwo[j][1];
-      x_cent = TwoByTwo[j][2];
-      y_cent = TwoByTwo[j][3];
-      z_cent = TwoByTwo[j][4];
-      rot_x = TwoByTwo[j][5];
-      rot_y = TwoByTwo[j][6];
-      rot_z = TwoByTwo[j][7];
-
-      G4ThreeVector Crystal_Center = G4ThreeVector(x_cent * mm, y_cent * mm, z_cent * mm);
-
-      G4RotationMatrix *Rot = new G4RotationMatrix();  //rotation matrix for the placement of each crystal
-      Rot->rotateX(0 * rad);
-      Rot->rotateY(0 * rad);
-      Rot->rotateZ(rot_z * rad);
-
-      string crystal_name = _crystallogicnameprefix + "_j_" + to_string(j_idx) + "_k_" + to_string(k_idx);
-      int copyno = (j_idx << 16) + k_idx;
-
-      G4VPhysicalVolume *physvol = new G4PVPlacement(Rot, Crystal_Center,
-                                                     crystal_logic_small,
-                                                     crystal_name,
-                                                     Two_by_Two_logic,
-                                                     0, copyno, OverlapCheck());
-      m_ActiveVolumeSet.insert(physvol);
-
-      j_idx = k_idx = 0;
-      x_cent = y_cent = z_cent = rot_z = 0.0;
-    }
-    j++;
-  }
-
   //****************************
   //Place the 2x2 Crystal Blocks
   //****************************
@@ -1219,6 +1145,10 @@ int PHG4ProjCrystalCalorimeterDetector::ConstructProjectiveCrystals(G4LogicalVol
   FillSpecialUnit(twelve_logic, 12);
   FillSpecialUnit(twentytwo_logic, 22);
   FillSpecialUnit(thirtytwo_logic, 32);
+  if (Verbosity() > 0)
+  {
+    m_VolumeCache.Print("PHG4ProjCrystalCalorimeterDetector");
+  }
 
   ostringstream name;
 
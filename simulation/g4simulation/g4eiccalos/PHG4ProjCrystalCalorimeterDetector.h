@@ -6,6 +6,7 @@
 #include "PHG4CrystalCalorimeterDetector.h"
 
 #include "PHG4CrystalCalorimeterDefs.h"
+#include "PHG4LogicalVolumeCache.h"
 
 #include <Geant4/G4Types.hh>  // for G4double, G4int
 
@@ -68,6 +69,8 @@ class PHG4ProjCrystalCalorimeterDetector : public PHG4CrystalCalorimeterDetector
 
  private:
   int ConstructProjectiveCrystals(G4LogicalVolume* envelope);
+  //! crystal volume filled with 4 crystals, shared by all units
+  G4LogicalVolume* GetTwoByTwoUnit();
   int Fill4x4Unit(G4LogicalVolume* crystal_logic);
   int FillSpecialUnit(G4LogicalVolume* crystal_logic, G4int ident);
 
@@ -82,6 +85,7 @@ class PHG4ProjCrystalCalorimeterDetector : public PHG4CrystalCalorimeterDetector
 
   std::set<G4VPhysicalVolume*> m_ActiveVolumeSet;
   std::set<G4VPhysicalVolume*> m_PassiveVolumeSet;
+  PHG4LogicalVolumeCache m_VolumeCache;
   // since getting parameters is a map search we do not want to
   // do this in every step, the parameters used are cached
   // in the following variables
@@ -0,0 +1,32 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERHITHANDLER_H
+#define G4DETECTORS_PHG4SHOWERHITHANDLER_H
+
+class G4Track;
+class G4VTouchable;
+class PHG4Hit;
+
+/*!
+ * \brief interface of the calorimeter stepping actions towards the fast
+ * shower models, the models need the tower index encoding and the hit
+ * containers of the detector
+ */
+class PHG4ShowerHitHandler
+{
+ public:
+  virtual ~PHG4ShowerHitHandler() = default;
+
+  //! tower index of the volume at the bottom of the touchable, returns
+  //! 0 outside of the calorimeter, >0 in the active material, <0 in the absorber
+  virtual int GetTowerIndex(const G4VTouchable *touch, int &idx_j, int &idx_k) const = 0;
+
+  //! longitudinal segment of the tower for calorimeters which have them,
+  //! only called inside the calorimeter. -1 leaves index_l unset
+  virtual int GetTowerLayer(const G4VTouchable * /*touch*/) const { return -1; }
+
+  //! store a hit of the parametrised shower of track, takes ownership of hit
+  virtual void SaveShowerHit(PHG4Hit *hit, const int whichactive, const G4Track *track) = 0;
+};
+
+#endif
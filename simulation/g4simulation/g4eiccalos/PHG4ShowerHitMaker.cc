@@ -0,0 +1,123 @@
+#include "PHG4ShowerHitMaker.h"
+
+#include "PHG4ShowerHitHandler.h"
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4Hitv1.h>
+
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4Navigator.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4TouchableHistory.hh>
+#include <Geant4/G4TouchableHistoryHandle.hh>
+#include <Geant4/G4Track.hh>
+#include <Geant4/G4TransportationManager.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+
+#include <algorithm>
+
+PHG4ShowerHitMaker::~PHG4ShowerHitMaker()
+{
+  delete m_Navigator;
+}
+
+void PHG4ShowerHitMaker::StartShower(PHG4ShowerHitHandler *handler)
+{
+  m_HitHandler = handler;
+  m_Towers.clear();
+  if (!m_Navigator)
+  {
+    m_Navigator = new G4Navigator();
+    m_Navigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+  }
+  // the first search after a new shower start has to be a full one
+  m_RelativeSearch = false;
+}
+
+double PHG4ShowerHitMaker::AddSpot(const G4ThreeVector &pos, const double weight, const double time, const int whichactive)
+{
+  G4VPhysicalVolume *volume = m_Navigator->LocateGlobalPointAndSetup(pos, nullptr, m_RelativeSearch, true);
+  m_RelativeSearch = true;
+  if (!volume)
+  {
+    return 0.;
+  }
+  G4TouchableHistoryHandle touch = m_Navigator->CreateTouchableHistoryHandle();
+  int idx_j = -1;
+  int idx_k = -1;
+  int active = m_HitHandler->GetTowerIndex(touch(), idx_j, idx_k);
+  if (!active)
+  {
+    return 0.;
+  }
+  const int idx_l = m_HitHandler->GetTowerLayer(touch());
+  if (whichactive)
+  {
+    active = whichactive;
+  }
+  double w = weight;
+  // energy loss scales roughly with the electron density, this gives
+  // absorber and active layers of sampling calorimeters their share
+  if (m_DensityWeighting)
+  {
+    w *= volume->GetLogicalVolume()->GetMaterial()->GetElectronDensity();
+  }
+  TowerDeposit &tower = m_Towers[std::make_tuple(active, idx_j, idx_k, idx_l)];
+  if (tower.weight == 0)
+  {
+    tower.tmin = time;
+    tower.tmax = time;
+  }
+  tower.weight += w;
+  tower.pos += w * pos;
+  tower.tmin = std::min(tower.tmin, time);
+  tower.tmax = std::max(tower.tmax, time);
+  return w;
+}
+
+void PHG4ShowerHitMaker::EndShower(const G4Track *track, const double scale)
+{
+  for (auto &iter : m_Towers)
+  {
+    const TowerDeposit &tower = iter.second;
+    if (tower.weight <= 0)
+    {
+      continue;
+    }
+    int whichactive;
+    int idx_j;
+    int idx_k;
+    int idx_l;
+    std::tie(whichactive, idx_j, idx_k, idx_l) = iter.first;
+    const double edep = tower.weight * scale / GeV;
+    const G4ThreeVector pos = tower.pos / tower.weight;
+    PHG4Hit *hit = new PHG4Hitv1();
+    for (int i = 0; i < 2; i++)
+    {
+      hit->set_x(i, pos.x() / cm);
+      hit->set_y(i, pos.y() / cm);
+      hit->set_z(i, pos.z() / cm);
+    }
+    hit->set_t(0, tower.tmin / nanosecond);
+    hit->set_t(1, tower.tmax / nanosecond);
+    hit->set_trkid(track->GetTrackID());
+    hit->set_edep(edep);
+    if (idx_j >= 0)
+    {
+      hit->set_index_j(idx_j);
+      hit->set_index_k(idx_k);
+    }
+    if (idx_l >= 0)
+    {
+      hit->set_index_l(idx_l);
+    }
+    if (whichactive > 0)
+    {
+      hit->set_eion(edep);
+      hit->set_light_yield(edep);
+    }
+    m_HitHandler->SaveShowerHit(hit, whichactive, track);
+  }
+  m_Towers.clear();
+}
@@ -0,0 +1,62 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERHITMAKER_H
+#define G4DETECTORS_PHG4SHOWERHITMAKER_H
+
+#include <Geant4/G4ThreeVector.hh>
+
+#include <map>
+#include <tuple>
+
+class G4Navigator;
+class G4Track;
+class PHG4ShowerHitHandler;
+
+/*!
+ * \brief turns the energy spots of a fast shower model into tower hits
+ *
+ * Every spot is located in the geometry with a private navigator, the
+ * stepping action (PHG4ShowerHitHandler) decodes the tower index of the
+ * volume. Spots are summed per tower and one G4Hit per tower and shower
+ * is handed back to the stepping action.
+ */
+class PHG4ShowerHitMaker
+{
+ public:
+  PHG4ShowerHitMaker() = default;
+  ~PHG4ShowerHitMaker();
+
+  //! weight the spots with the electron density of the volume they end up in
+  void SetDensityWeighting(const bool b) { m_DensityWeighting = b; }
+
+  //! clear the towers of the previous shower
+  void StartShower(PHG4ShowerHitHandler *handler);
+
+  //! add a spot at global pos (G4 units), whichactive != 0 overrides the
+  //! active/absorber decision of the volume. Returns the weight which was
+  //! added, 0 if the spot is outside of the calorimeter
+  double AddSpot(const G4ThreeVector &pos, const double weight, const double time, const int whichactive = 0);
+
+  //! one hit per tower with energy weight sum * scale
+  void EndShower(const G4Track *track, const double scale);
+
+ private:
+  //! sum of the spot weights in one tower, position and time are weighted
+  struct TowerDeposit
+  {
+    double weight = 0.;
+    G4ThreeVector pos;
+    double tmin = 0.;
+    double tmax = 0.;
+  };
+
+  G4Navigator *m_Navigator = nullptr;
+  PHG4ShowerHitHandler *m_HitHandler = nullptr;
+  bool m_DensityWeighting = false;
+  bool m_RelativeSearch = false;
+
+  //! (whichactive, idx_j, idx_k, idx_l) -> deposit, reused for every shower
+  std::map<std::tuple<int, int, int, int>, TowerDeposit> m_Towers;
+};
+
+#endif
@@ -0,0 +1,178 @@
+#include "PHG4ShowerLibrary.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  const char library_magic[8] = {'P', 'H', 'G', '4', 'S', 'L', 'I', 'B'};
+  const uint32_t library_version = 1;
+
+  // size of the pdg block, padded to keep the following blocks aligned
+  size_t PdgBlockSize(const size_t nparticles)
+  {
+    return (nparticles * sizeof(int32_t) + 7) / 8 * 8;
+  }
+}  // namespace
+
+int PHG4ShowerLibrary::Binning::ParticleIndex(const int pdgcode) const
+{
+  auto iter = std::find(pdg.begin(), pdg.end(), pdgcode);
+  if (iter == pdg.end())
+  {
+    return -1;
+  }
+  return iter - pdg.begin();
+}
+
+int PHG4ShowerLibrary::Binning::BinIndex(const int particle, const double energy, const double costheta) const
+{
+  if (particle < 0 || energy < emin || energy >= emax)
+  {
+    return -1;
+  }
+  const int ebin = std::min(nenergy - 1, (int) (std::log(energy / emin) / std::log(emax / emin) * nenergy));
+  const double theta = std::acos(std::min(1., std::fabs(costheta)));
+  const int abin = std::min(nangle - 1, (int) (theta / M_PI_2 * nangle));
+  return (particle * nenergy + ebin) * nangle + abin;
+}
+
+PHG4ShowerLibrary::PHG4ShowerLibrary(const std::string &filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat filestat;
+  if (fd < 0 || fstat(fd, &filestat) != 0 || (size_t) filestat.st_size < sizeof(Header))
+  {
+    std::cout << PHWHERE << " cannot read shower library " << filename << std::endl;
+    exit(1);
+  }
+  m_MapSize = filestat.st_size;
+  m_Map = mmap(nullptr, m_MapSize, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after closing the file
+  close(fd);
+  if (m_Map == MAP_FAILED)
+  {
+    std::cout << PHWHERE << " cannot map shower library " << filename << std::endl;
+    exit(1);
+  }
+
+  const char *base = static_cast<const char *>(m_Map);
+  const Header *header = reinterpret_cast<const Header *>(base);
+  if (std::memcmp(header->magic, library_magic, sizeof(library_magic)) || header->version != library_version)
+  {
+    std::cout << PHWHERE << " " << filename << " is not a shower library of version " << library_version << std::endl;
+    exit(1);
+  }
+  const int32_t *pdg = reinterpret_cast<const int32_t *>(base + sizeof(Header));
+  m_Binning.pdg.assign(pdg, pdg + header->nparticles);
+  m_Binning.nenergy = header->nenergy;
+  m_Binning.nangle = header->nangle;
+  m_Binning.emin = header->emin;
+  m_Binning.emax = header->emax;
+
+  size_t offset = sizeof(Header) + PdgBlockSize(header->nparticles);
+  m_Bins = reinterpret_cast<const Bin *>(base + offset);
+  offset += m_Binning.NBins() * sizeof(Bin);
+  m_Showers = reinterpret_cast<const Shower *>(base + offset);
+  offset += header->nshowers * sizeof(Shower);
+  m_Spots = reinterpret_cast<const Spot *>(base + offset);
+  offset += header->nspots * sizeof(Spot);
+  if (offset != m_MapSize)
+  {
+    std::cout << PHWHERE << " shower library " << filename << " is truncated" << std::endl;
+    exit(1);
+  }
+}
+
+PHG4ShowerLibrary::~PHG4ShowerLibrary()
+{
+  munmap(m_Map, m_MapSize);
+}
+
+const PHG4ShowerLibrary::Shower *PHG4ShowerLibrary::Pick(const int bin, const double random) const
+{
+  if (bin < 0 || !m_Bins[bin].nshowers)
+  {
+    return nullptr;
+  }
+  const uint32_t ishower = std::min(m_Bins[bin].nshowers - 1, (uint32_t) (random * m_Bins[bin].nshowers));
+  return m_Showers + m_Bins[bin].first_shower + ishower;
+}
+
+bool PHG4ShowerLibrary::Write(const std::string &filename, const Binning &binning, const std::vector<std::vector<ShowerData>> &showers)
+{
+  std::ofstream fout(filename, std::ios::binary);
+  if (!fout.is_open())
+  {
+    std::cout << PHWHERE << " cannot open " << filename << std::endl;
+    return false;
+  }
+  Header header;
+  std::memcpy(header.magic, library_magic, sizeof(library_magic));
+  header.version = library_version;
+  header.nparticles = binning.pdg.size();
+  header.nenergy = binning.nenergy;
+  header.nangle = binning.nangle;
+  header.emin = binning.emin;
+  header.emax = binning.emax;
+  header.nshowers = 0;
+  header.nspots = 0;
+  for (const auto &bin : showers)
+  {
+    header.nshowers += bin.size();
+    for (const ShowerData &shower : bin)
+    {
+      header.nspots += shower.spots.size();
+    }
+  }
+  fout.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::vector<int32_t> pdg(PdgBlockSize(binning.pdg.size()) / sizeof(int32_t), 0);
+  std::copy(binning.pdg.begin(), binning.pdg.end(), pdg.begin());
+  fout.write(reinterpret_cast<const char *>(pdg.data()), pdg.size() * sizeof(int32_t));
+
+  uint64_t first_shower = 0;
+  for (int i = 0; i < binning.NBins(); i++)
+  {
+    Bin bin;
+    bin.first_shower = first_shower;
+    bin.nshowers = (i < (int) showers.size()) ? showers[i].size() : 0;
+    bin.padding = 0;
+    fout.write(reinterpret_cast<const char *>(&bin), sizeof(bin));
+    first_shower += bin.nshowers;
+  }
+
+  uint64_t first_spot = 0;
+  for (const auto &bin : showers)
+  {
+    for (const ShowerData &data : bin)
+    {
+      Shower shower;
+      shower.first_spot = first_spot;
+      shower.nspots = data.spots.size();
+      shower.energy = data.energy;
+      fout.write(reinterpret_cast<const char *>(&shower), sizeof(shower));
+      first_spot += shower.nspots;
+    }
+  }
+
+  for (const auto &bin : showers)
+  {
+    for (const ShowerData &data : bin)
+    {
+      fout.write(reinterpret_cast<const char *>(data.spots.data()), data.spots.size() * sizeof(Spot));
+    }
+  }
+  return fout.good();
+}
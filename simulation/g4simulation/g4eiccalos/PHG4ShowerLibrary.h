@@ -0,0 +1,122 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERLIBRARY_H
+#define G4DETECTORS_PHG4SHOWERLIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief library of frozen showers, binned in particle type, kinetic energy
+ * and angle of incidence
+ *
+ * The energy bins are logarithmic between emin and emax (GeV), the angle bins
+ * are uniform in the polar angle between the particle and the z axis (folded
+ * to 0-90 deg). Every shower is a list of spots in the frame of the incoming
+ * particle: depth along its direction and two transverse coordinates
+ * measured from the point where it entered the calorimeter (cm), time after
+ * entering (ns), the fraction of the kinetic energy deposited and if the spot
+ * was in the active material (+1) or in the absorber (-1).
+ *
+ * File layout (native byte order, all blocks 8 byte aligned):
+ *  - Header
+ *  - int32 pdg code of the particles, padded to 8 bytes
+ *  - Bin[nparticles * nenergy * nangle]
+ *  - Shower[nshowers]
+ *  - Spot[nspots]
+ * The file is memory mapped, only the pages of the showers which are used
+ * are read from disk.
+ */
+class PHG4ShowerLibrary
+{
+ public:
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nparticles;
+    uint32_t nenergy;
+    uint32_t nangle;
+    float emin;
+    float emax;
+    uint64_t nshowers;
+    uint64_t nspots;
+  };
+
+  struct Bin
+  {
+    uint64_t first_shower;
+    uint32_t nshowers;
+    uint32_t padding;
+  };
+
+  struct Shower
+  {
+    uint64_t first_spot;
+    uint32_t nspots;
+    //! kinetic energy (GeV) of the particle which made the shower
+    float energy;
+  };
+
+  struct Spot
+  {
+    float depth;
+    float u;
+    float v;
+    float time;
+    float efrac;
+    int32_t active;
+  };
+
+  //! a shower while the library is built
+  struct ShowerData
+  {
+    float energy = 0.;
+    std::vector<Spot> spots;
+  };
+
+  //! the binning of a library
+  struct Binning
+  {
+    std::vector<int> pdg;
+    int nenergy = 10;
+    int nangle = 6;
+    double emin = 0.1;
+    double emax = 10.;
+
+    //! index of the particle in pdg, -1 if it is not in the library
+    int ParticleIndex(const int pdgcode) const;
+    //! bin of particle index, kinetic energy (GeV) and cosine of the angle to the z axis, -1 if outside
+    int BinIndex(const int particle, const double energy, const double costheta) const;
+    int NBins() const { return pdg.size() * nenergy * nangle; }
+  };
+
+  //! map the library file, exits if it cannot be read
+  explicit PHG4ShowerLibrary(const std::string &filename);
+  ~PHG4ShowerLibrary();
+
+  const Binning &GetBinning() const { return m_Binning; }
+
+  //! shower of the bin for a random number in [0,1), nullptr for an empty bin
+  const Shower *Pick(const int bin, const double random) const;
+
+  //! the first spot of a shower
+  const Spot *GetSpots(const Shower *shower) const { return m_Spots + shower->first_spot; }
+
+  //! write a library, showers holds the showers of each bin of binning
+  static bool Write(const std::string &filename, const Binning &binning, const std::vector<std::vector<ShowerData>> &showers);
+
+ private:
+  Binning m_Binning;
+
+  void *m_Map = nullptr;
+  size_t m_MapSize = 0;
+
+  const Bin *m_Bins = nullptr;
+  const Shower *m_Showers = nullptr;
+  const Spot *m_Spots = nullptr;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "PHG4ShowerLibraryBuilder.h"
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <Geant4/G4ThreeVector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <limits>
+
+PHG4ShowerLibraryBuilder::PHG4ShowerLibraryBuilder(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+int PHG4ShowerLibraryBuilder::InitRun(PHCompositeNode * /*topNode*/)
+{
+  if (m_Binning.pdg.empty())
+  {
+    std::cout << PHWHERE << " no particles given for the shower library of " << m_Detector << std::endl;
+    exit(1);
+  }
+  m_Showers.resize(m_Binning.NBins());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibraryBuilder::process_event(PHCompositeNode *topNode)
+{
+  PHG4TruthInfoContainer *truth = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (!truth)
+  {
+    std::cout << PHWHERE << " Could not locate G4TruthInfo node" << std::endl;
+    exit(1);
+  }
+  const PHG4TruthInfoContainer::ConstRange primaries = truth->GetPrimaryParticleRange();
+  if (primaries.first == primaries.second)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  const PHG4Particle *primary = primaries.first->second;
+  const G4ThreeVector mom(primary->get_px(), primary->get_py(), primary->get_pz());
+  const double ekin = primary->get_e() - std::sqrt(std::max(0., primary->get_e() * primary->get_e() - mom.mag2()));
+  const G4ThreeVector dir = mom.unit();
+  const int bin = m_Binning.BinIndex(m_Binning.ParticleIndex(primary->get_pid()), ekin, dir.z());
+  if (bin < 0 || m_Showers[bin].size() >= m_MaxShowersPerBin)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  const std::string nodename[2] = {"G4HIT_" + m_Detector, "G4HIT_ABSORBER_" + m_Detector};
+  const int active[2] = {1, -1};
+  PHG4HitContainer *g4hits[2];
+  for (int i = 0; i < 2; i++)
+  {
+    g4hits[i] = findNode::getClass<PHG4HitContainer>(topNode, nodename[i]);
+    if (!g4hits[i])
+    {
+      std::cout << PHWHERE << " Could not locate g4 hit node " << nodename[i] << std::endl;
+      exit(1);
+    }
+  }
+
+  // the primary enters the calorimeter where the earliest hit starts
+  const PHG4Hit *first = nullptr;
+  double tmin = std::numeric_limits<double>::max();
+  for (PHG4HitContainer *container : g4hits)
+  {
+    PHG4HitContainer::ConstRange hit_begin_end = container->getHits();
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      if (hiter->second->get_edep() > 0 && hiter->second->get_t(0) < tmin)
+      {
+        first = hiter->second;
+        tmin = first->get_t(0);
+      }
+    }
+  }
+  if (!first)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  const G4ThreeVector entry(first->get_x(0), first->get_y(0), first->get_z(0));
+  const G4ThreeVector orth1 = dir.orthogonal().unit();
+  const G4ThreeVector orth2 = dir.cross(orth1);
+
+  PHG4ShowerLibrary::ShowerData shower;
+  shower.energy = ekin;
+  for (int i = 0; i < 2; i++)
+  {
+    PHG4HitContainer::ConstRange hit_begin_end = g4hits[i]->getHits();
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      const PHG4Hit *g4hit = hiter->second;
+      if (g4hit->get_edep() < m_SpotThreshold)
+      {
+        continue;
+      }
+      const G4ThreeVector pos(0.5 * (g4hit->get_x(0) + g4hit->get_x(1)),
+                              0.5 * (g4hit->get_y(0) + g4hit->get_y(1)),
+                              0.5 * (g4hit->get_z(0) + g4hit->get_z(1)));
+      const G4ThreeVector d = pos - entry;
+      PHG4ShowerLibrary::Spot spot;
+      spot.depth = d.dot(dir);
+      spot.u = d.dot(orth1);
+      spot.v = d.dot(orth2);
+      spot.time = 0.5 * (g4hit->get_t(0) + g4hit->get_t(1)) - tmin;
+      spot.efrac = g4hit->get_edep() / ekin;
+      spot.active = active[i];
+      shower.spots.push_back(spot);
+    }
+  }
+  m_Showers[bin].push_back(shower);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibraryBuilder::End(PHCompositeNode * /*topNode*/)
+{
+  size_t nshowers = 0;
+  size_t nempty = 0;
+  for (const auto &bin : m_Showers)
+  {
+    nshowers += bin.size();
+    nempty += bin.empty();
+  }
+  if (!PHG4ShowerLibrary::Write(m_OutputFile, m_Binning, m_Showers))
+  {
+    std::cout << PHWHERE << " writing " << m_OutputFile << " failed" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  std::cout << Name() << ": wrote " << nshowers << " showers to " << m_OutputFile
+            << ", " << nempty << " of " << m_Showers.size() << " bins are empty" << std::endl;
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,75 @@
+#ifndef G4CALO__PHG4SHOWERLIBRARYBUILDER_H
+#define G4CALO__PHG4SHOWERLIBRARYBUILDER_H
+
+#include "PHG4ShowerLibrary.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+/**
+ * \brief SubsysReco module building a frozen shower library (PHG4ShowerLibrary)
+ * for PHG4ShowerLibraryModel from single particle events
+ *
+ * Run it behind PHG4Reco with the full simulation of the calorimeter, its
+ * absorber hits enabled and one primary particle per event shot into the
+ * calorimeter. The G4Hits of the detector (G4HIT_ and G4HIT_ABSORBER_
+ * nodes) are stored as spots relative to the entry point of the primary,
+ * taken as the start of the earliest hit. The library is written in End().
+ */
+class PHG4ShowerLibraryBuilder : public SubsysReco
+{
+ public:
+  PHG4ShowerLibraryBuilder(const std::string &name = "PHG4ShowerLibraryBuilder");
+  ~PHG4ShowerLibraryBuilder() override {}
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  int End(PHCompositeNode *topNode) override;
+
+  /** Name of the detector node the G4Hits should be taken from.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  //! output file
+  void OutputFile(const std::string &f) { m_OutputFile = f; }
+
+  //! particle (pdg code) to be stored, showers of other primaries are dropped
+  void AddParticle(const int pdg) { m_Binning.pdg.push_back(pdg); }
+
+  //! nbins logarithmic bins of the kinetic energy between emin and emax (GeV)
+  void SetEnergyBins(const int nbins, const double emin, const double emax)
+  {
+    m_Binning.nenergy = nbins;
+    m_Binning.emin = emin;
+    m_Binning.emax = emax;
+  }
+
+  //! bins in the angle of incidence
+  void SetAngleBins(const int nbins) { m_Binning.nangle = nbins; }
+
+  //! bins with this many showers are full
+  void SetMaxShowersPerBin(const unsigned int n) { m_MaxShowersPerBin = n; }
+
+  //! spots with less energy (GeV) are dropped to keep the library compact
+  void SetSpotThreshold(const double e) { m_SpotThreshold = e; }
+
+ private:
+  PHG4ShowerLibrary::Binning m_Binning;
+
+  //! showers of each bin
+  std::vector<std::vector<PHG4ShowerLibrary::ShowerData>> m_Showers;
+
+  std::string m_Detector;
+  std::string m_OutputFile = "showerlib.bin";
+
+  unsigned int m_MaxShowersPerBin = 200;
+  double m_SpotThreshold = 1e-6;
+};
+
+#endif
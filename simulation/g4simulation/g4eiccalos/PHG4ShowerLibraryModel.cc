@@ -0,0 +1,100 @@
+#include "PHG4ShowerLibraryModel.h"
+
+#include "PHG4ShowerHitHandler.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/PHRandomSeed.h>
+
+#include <Geant4/G4FastStep.hh>
+#include <Geant4/G4FastTrack.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4ParticleTable.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Track.hh>
+
+#include <cmath>
+#include <vector>
+
+PHG4ShowerLibraryModel::PHG4ShowerLibraryModel(const std::string &name, G4Region *envelope, const PHParameters *params)
+  : G4VFastSimulationModel(name + "_ShowerLibraryModel", envelope)
+  , m_Emin(params->get_double_param("showerlib_emin") * GeV)
+  , m_Emax(params->get_double_param("showerlib_emax") * GeV)
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+  m_Library = new PHG4ShowerLibrary(params->get_string_param("showerlib_file"));
+
+  std::vector<G4ParticleDefinition *> particles;
+  for (int pdg : m_Library->GetBinning().pdg)
+  {
+    if (G4ParticleDefinition *particle = G4ParticleTable::GetParticleTable()->FindParticle(pdg))
+    {
+      particles.push_back(particle);
+    }
+  }
+  PHG4CalorimeterRegion::ActivateFastSimulation(particles);
+}
+
+PHG4ShowerLibraryModel::~PHG4ShowerLibraryModel()
+{
+  gsl_rng_free(m_RandomGenerator);
+  delete m_Library;
+}
+
+G4bool PHG4ShowerLibraryModel::IsApplicable(const G4ParticleDefinition &particle)
+{
+  return m_Library->GetBinning().ParticleIndex(particle.GetPDGEncoding()) >= 0;
+}
+
+G4bool PHG4ShowerLibraryModel::ModelTrigger(const G4FastTrack &fastTrack)
+{
+  m_Shower = nullptr;
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  const double energy = track->GetKineticEnergy();
+  if (!m_HitHandler || energy < m_Emin || energy >= m_Emax)
+  {
+    return false;
+  }
+  const PHG4ShowerLibrary::Binning &binning = m_Library->GetBinning();
+  const int bin = binning.BinIndex(binning.ParticleIndex(track->GetParticleDefinition()->GetPDGEncoding()),
+                                   energy / GeV, track->GetMomentumDirection().z());
+  // empty bins are left to the full simulation
+  m_Shower = m_Library->Pick(bin, gsl_rng_uniform(m_RandomGenerator));
+  return m_Shower != nullptr;
+}
+
+void PHG4ShowerLibraryModel::SetHitHandler(PHG4ShowerHitHandler *handler)
+{
+  m_HitHandler = handler;
+}
+
+void PHG4ShowerLibraryModel::DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep)
+{
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  const double energy = track->GetKineticEnergy();
+  fastStep.KillPrimaryTrack();
+  fastStep.ProposePrimaryTrackPathLength(0.);
+
+  // the library frame is only defined up to a rotation around the direction
+  const G4ThreeVector start = track->GetPosition();
+  const G4ThreeVector dir = track->GetMomentumDirection();
+  const G4ThreeVector orth1 = dir.orthogonal().unit();
+  const G4ThreeVector orth2 = dir.cross(orth1);
+  const double phi = 2. * M_PI * gsl_rng_uniform(m_RandomGenerator);
+  const G4ThreeVector axis_u = std::cos(phi) * orth1 + std::sin(phi) * orth2;
+  const G4ThreeVector axis_v = dir.cross(axis_u);
+  const double t0 = track->GetGlobalTime();
+
+  m_HitMaker.StartShower(m_HitHandler);
+  const PHG4ShowerLibrary::Spot *spot = m_Library->GetSpots(m_Shower);
+  for (uint32_t i = 0; i < m_Shower->nspots; i++, spot++)
+  {
+    const G4ThreeVector pos = start + (spot->depth * cm) * dir + (spot->u * cm) * axis_u + (spot->v * cm) * axis_v;
+    m_HitMaker.AddSpot(pos, spot->efrac * energy, t0 + spot->time * nanosecond, spot->active);
+  }
+  m_HitMaker.EndShower(track, 1.);
+}
@@ -0,0 +1,61 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4SHOWERLIBRARYMODEL_H
+#define G4DETECTORS_PHG4SHOWERLIBRARYMODEL_H
+
+#include "PHG4ShowerHitMaker.h"
+#include "PHG4ShowerLibrary.h"
+
+#include <Geant4/G4Types.hh>
+#include <Geant4/G4VFastSimulationModel.hh>
+
+#include <gsl/gsl_rng.h>
+
+#include <string>
+
+class G4FastStep;
+class G4FastTrack;
+class G4ParticleDefinition;
+class G4Region;
+class PHG4ShowerHitHandler;
+class PHParameters;
+
+/*!
+ * \brief frozen shower fast simulation for the hadron calorimeters
+ *
+ * Particles of the library (showerlib_file) with a kinetic energy between
+ * showerlib_emin and showerlib_emax (GeV) in the region of the calorimeter
+ * are killed and replaced by a shower of their (particle, energy, angle)
+ * bin. The spots of the shower are rotated by a random angle around the
+ * particle direction, scaled to its energy and turned into tower hits by
+ * PHG4ShowerHitMaker. The libraries are made with PHG4ShowerLibraryBuilder.
+ */
+class PHG4ShowerLibraryModel : public G4VFastSimulationModel
+{
+ public:
+  //! the particles of the library get the fast simulation process, the subsystem
+  //! has to call PHG4CalorimeterRegion::RegisterFastSimulationPhysics() first
+  PHG4ShowerLibraryModel(const std::string &name, G4Region *envelope, const PHParameters *params);
+  ~PHG4ShowerLibraryModel() override;
+
+  G4bool IsApplicable(const G4ParticleDefinition &particle) override;
+  G4bool ModelTrigger(const G4FastTrack &fastTrack) override;
+  void DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep) override;
+
+  //! set by the stepping action once the hit containers are known
+  void SetHitHandler(PHG4ShowerHitHandler *handler);
+
+ private:
+  gsl_rng *m_RandomGenerator = nullptr;
+  PHG4ShowerLibrary *m_Library = nullptr;
+  PHG4ShowerHitHandler *m_HitHandler = nullptr;
+  PHG4ShowerHitMaker m_HitMaker;
+
+  double m_Emin;
+  double m_Emax;
+
+  //! shower picked in ModelTrigger for DoIt
+  const PHG4ShowerLibrary::Shower *m_Shower = nullptr;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "G4EicDircBarGeom.h"
+
+#include <cmath>
+
+void G4EicDircBarGeom::Sector::LocalToGlobal(const double local[3], double global[3]) const
+{
+  LocalToGlobalDir(local, global);
+  for (int i = 0; i < 3; i++)
+  {
+    global[i] += center[i];
+  }
+}
+
+void G4EicDircBarGeom::Sector::GlobalToLocal(const double global[3], double local[3]) const
+{
+  const double shifted[3] = {global[0] - center[0], global[1] - center[1], global[2] - center[2]};
+  GlobalToLocalDir(shifted, local);
+}
+
+void G4EicDircBarGeom::Sector::LocalToGlobalDir(const double local[3], double global[3]) const
+{
+  for (int i = 0; i < 3; i++)
+  {
+    global[i] = 0;
+    for (int j = 0; j < 3; j++)
+    {
+      global[i] += rotation[i][j] * local[j];
+    }
+  }
+}
+
+void G4EicDircBarGeom::Sector::GlobalToLocalDir(const double global[3], double local[3]) const
+{
+  // the transpose is the inverse of the rotation
+  for (int i = 0; i < 3; i++)
+  {
+    local[i] = 0;
+    for (int j = 0; j < 3; j++)
+    {
+      local[i] += rotation[j][i] * global[j];
+    }
+  }
+}
+
+int G4EicDircBarGeom::FindSector(const double global[3]) const
+{
+  const double phi = std::atan2(global[1], global[0]);
+  int found = -1;
+  double mindphi = 2. * M_PI;
+  for (int i = 0; i < size(); i++)
+  {
+    const double dphi = std::abs(std::remainder(phi - std::atan2(m_Sectors[i].center[1], m_Sectors[i].center[0]), 2. * M_PI));
+    if (dphi < mindphi)
+    {
+      found = i;
+      mindphi = dphi;
+    }
+  }
+  return found;
+}
+
+int G4EicDircBarGeom::FindBar(const double y) const
+{
+  if (m_BarY.empty() || y < m_BarY.front() - 0.5 * m_BarWidth || y > m_BarY.back() + 0.5 * m_BarWidth)
+  {
+    return -1;
+  }
+  // tracks in the gaps between the bars go to the closest one
+  int found = 0;
+  for (int i = 1; i < nbars(); i++)
+  {
+    if (std::abs(y - m_BarY[i]) < std::abs(y - m_BarY[found]))
+    {
+      found = i;
+    }
+  }
+  return found;
+}
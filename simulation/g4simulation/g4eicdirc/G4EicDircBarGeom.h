@@ -0,0 +1,92 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICDIRCBARGEOM_H
+#define G4EICDIRCBARGEOM_H
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief placement of the DIRC bar boxes
+ *
+ * Filled by G4EicDircDetector when the geometry is built and put on the RUN
+ * node as BARGEOM_<superdetector> for the lookup table reconstruction. All
+ * lengths are in cm. In the sector frame the bars run along z with the
+ * readout (prism) at -z and the mirror at +z, the thickness of the bars is
+ * along x (pointing outwards) and the bars are side by side in y. Every
+ * sector is built from the same parameters, so the bars are only stored once.
+ */
+class G4EicDircBarGeom
+{
+ public:
+  struct Sector
+  {
+    //! local to global rotation
+    double rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double center[3] = {0, 0, 0};
+
+    void LocalToGlobal(const double local[3], double global[3]) const;
+    void GlobalToLocal(const double global[3], double local[3]) const;
+    //! same for directions
+    void LocalToGlobalDir(const double local[3], double global[3]) const;
+    void GlobalToLocalDir(const double global[3], double local[3]) const;
+  };
+
+  G4EicDircBarGeom() = default;
+  ~G4EicDircBarGeom() = default;
+
+  //! sectors are stored in the order of the imprints
+  void AddSector(const Sector &sector) { m_Sectors.push_back(sector); }
+  const Sector &GetSector(const int index) const { return m_Sectors[index]; }
+  int size() const { return m_Sectors.size(); }
+
+  //! sector whose azimuth is closest to the point, -1 if there are none
+  int FindSector(const double global[3]) const;
+
+  void AddBar(const double y) { m_BarY.push_back(y); }
+  double GetBarY(const int index) const { return m_BarY[index]; }
+  int nbars() const { return m_BarY.size(); }
+
+  //! bar with the closest center in y (bars are stored with increasing y), -1 outside the bar box
+  int FindBar(const double y) const;
+
+  void set_bar_size(const double thickness, const double width)
+  {
+    m_BarThickness = thickness;
+    m_BarWidth = width;
+  }
+  double get_bar_thickness() const { return m_BarThickness; }
+  double get_bar_width() const { return m_BarWidth; }
+
+  //! readout and mirror end of the bars (glue included)
+  void set_bar_z(const double readout, const double mirror)
+  {
+    m_BarZ[0] = readout;
+    m_BarZ[1] = mirror;
+  }
+  double get_bar_z(const int i) const { return m_BarZ[i]; }
+
+  void set_readout(const int nmcp, const int npixel)
+  {
+    m_NMcp = nmcp;
+    m_NPixel = npixel;
+  }
+  int get_nmcp() const { return m_NMcp; }
+  //! pixels per MCP
+  int get_npixel() const { return m_NPixel; }
+
+  //! name of the geometry node of this detector
+  static std::string NodeName(const std::string &detector) { return "BARGEOM_" + detector; }
+
+ private:
+  std::vector<Sector> m_Sectors;
+  //! center of every bar of a sector
+  std::vector<double> m_BarY;
+  double m_BarThickness = 0;
+  double m_BarWidth = 0;
+  double m_BarZ[2] = {0, 0};
+  int m_NMcp = 0;
+  int m_NPixel = 0;
+};
+
+#endif  // G4EICDIRCBARGEOM_H
@@ -1,5 +1,6 @@
 #include "G4EicDircDetector.h"
 
+#include "G4EicDircBarGeom.h"
 #include "G4EicDircDisplayAction.h"
 
 #include <phparameter/PHParameters.h>
@@ -8,6 +9,14 @@
 #include <g4main/PHG4DisplayAction.h>  // for PHG4DisplayAction
 #include <g4main/PHG4Subsystem.h>
 
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TSystem.h>
+
 #include <Geant4/G4AssemblyVolume.hh>
 #include <Geant4/G4Box.hh>
 #include <Geant4/G4Colour.hh>
@@ -33,6 +42,7 @@
 #include <Geant4/G4Tubs.hh>
 #include <Geant4/G4UImanager.hh>
 #include <Geant4/G4UnionSolid.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
 #include <Geant4/G4VUserDetectorConstruction.hh>
 #include <Geant4/G4VisAttributes.hh>
 
@@ -40,7 +50,6 @@
 #include <iostream>  // for operator<<, endl, bas...
 
 class G4VSolid;
-class PHCompositeNode;
 
 G4EicDircDetector::G4EicDircDetector(PHG4Subsystem* subsys,
                                      PHCompositeNode* Node,
@@ -72,8 +81,51 @@ int G4EicDircDetector::IsInDetector(G4VPhysicalVolume* volume) const
   return 0;
 }
 
+//_______________________________________________________________
+
+const G4LogicalVolume* G4EicDircDetector::GetLensVolume(int i) const
+{
+  switch (i)
+  {
+  case 1:
+    return lLens1;
+  case 2:
+    return lLens2;
+  case 3:
+    return lLens3;
+  default:
+    return nullptr;
+  }
+}
+
+int G4EicDircDetector::GetPixelId(const G4ThreeVector& localpos, const G4ThreeVector& localdir) const
+{
+  // the photons pass the MCP (same material as the prism) in a straight
+  // line, with placed pixels they are detected on the face of the thin
+  // pixel slab in the middle of the MCP. Move the point there first.
+  G4ThreeVector pos = localpos;
+  if (localdir.z() != 0)
+  {
+    const double zpixel = (localdir.z() > 0) ? -fMcpActive[2] / 16. : fMcpActive[2] / 16.;
+    pos += ((zpixel - localpos.z()) / localdir.z()) * localdir;
+  }
+  // same indexing as the wPixel placements: i along x, j along y,
+  // copy number fNpix2 * i + j
+  const double pitchx = fMcpActive[0] / fNpix1;
+  const double pitchy = fMcpActive[1] / fNpix2;
+  const int i = static_cast<int>(std::floor((pos.x() + 0.5 * fMcpActive[0]) / pitchx));
+  const int j = static_cast<int>(std::floor((pos.y() + 0.5 * fMcpActive[1]) / pitchy));
+  if (i < 0 || i >= fNpix2 || j < 0 || j >= fNpix1)
+  {
+    return -1;  // outside of the active area
+  }
+  return fNpix2 * i + j;
+}
+
 void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
 {
+  m_MotherVolume = logicWorld;
+
   // ---------- DIRC supoort stucture ---------------
 
   //G4Material *Air = G4Material::GetMaterial("G4_AIR");
@@ -698,14 +750,21 @@ void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
   G4Box* gPixel = new G4Box("gPixel", 0.5 * fMcpActive[0] / fNpix1, 0.5 * fMcpActive[1] / fNpix2, fMcpActive[2] / 16.);
   lPixel = new G4LogicalVolume(gPixel, BarMaterial, "lPixel", 0, 0, 0);
   m_LogicalVolumes_active[lPixel] = 11;
-/*
-  for (int i = 0; i < fNpix2; i++)
+
+  // MCP_readout 0: one placement per pixel (fNpix1 x fNpix2 daughters per MCP)
+  // MCP_readout 1: the MCP is a single sensitive volume, the stepping action
+  //                gets the pixel from the local hit position (GetPixelId)
+  fMcpReadout = m_Params->get_int_param("MCP_readout");
+  if (fMcpReadout == 0)
   {
-    for (int j = 0; j < fNpix1; j++)
+    for (int i = 0; i < fNpix2; i++)
     {
-      double shiftx = i * (fMcpActive[0] / fNpix1) - fMcpActive[0] / 2. + 0.5 * fMcpActive[0] / fNpix1;
-      double shifty = j * (fMcpActive[1] / fNpix2) - fMcpActive[1] / 2. + 0.5 * fMcpActive[1] / fNpix2;
-      G4VPhysicalVolume* phy1 = new G4PVPlacement(0, G4ThreeVector(shiftx, shifty, 0), lPixel, "wPixel", lMcp, false, fNpix2 * i + j, OverlapCheck());
+      for (int j = 0; j < fNpix1; j++)
+      {
+        double shiftx = i * (fMcpActive[0] / fNpix1) - fMcpActive[0] / 2. + 0.5 * fMcpActive[0] / fNpix1;
+        double shifty = j * (fMcpActive[1] / fNpix2) - fMcpActive[1] / 2. + 0.5 * fMcpActive[1] / fNpix2;
+        new G4PVPlacement(0, G4ThreeVector(shiftx, shifty, 0), lPixel, "wPixel", lMcp, false, fNpix2 * i + j, OverlapCheck());
+      }
     }
   }
 
@@ -718,13 +777,10 @@ void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
     {
       double shiftx = i * (fMcpTotal[0] + gapx) - 0.5 * (fFd[1] - fMcpTotal[0]) + gapx;
       double shifty = j * (fMcpTotal[1] + gapy) - 0.5 * (fBoxWidth - fMcpTotal[1]) + gapy;
-      //phy = new G4PVPlacement(0,G4ThreeVector(shiftx,shifty,0),lMcp,"wMcp", lFd,false,mcpId++);
-      G4VPhysicalVolume* phy2 = new G4PVPlacement(0, G4ThreeVector(shiftx, shifty, 0), lMcp, "wMcp", lFd, false, mcpId, OverlapCheck());
-      //m_PhysicalVolumes_active[phy] = 10;
+      new G4PVPlacement(0, G4ThreeVector(shiftx, shifty, 0), lMcp, "wMcp", lFd, false, mcpId, OverlapCheck());
       mcpId++;
     }
   }
-*/
   {
     const int num = 36;
     double WaveLength[num];
@@ -799,7 +855,8 @@ void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
 
     // // assignment to pad
     // if(hamamatsu8500)
-    new G4LogicalSkinSurface("HamamatsuPMTSurface", lPixel, HamamatsuPMTOpSurface);
+    // without pixel placements the photocathode is the MCP itself
+    new G4LogicalSkinSurface("HamamatsuPMTSurface", (fMcpReadout == 0) ? lPixel : lMcp, HamamatsuPMTOpSurface);
 
     // Mirror
     G4OpticalSurface* MirrorOpSurface =
@@ -821,6 +878,11 @@ void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
 
   SetVisualization();
 
+  if (m_Params->get_int_param("active"))
+  {
+    AddBarGeom(logicWorld, dirclength);
+  }
+
   /*PrtOpBoundaryProcess *fBoundaryProcess = new PrtOpBoundaryProcess();
   G4ProcessManager *pmanager = G4OpticalPhoton::OpticalPhoton()->GetProcessManager();
   pmanager->AddDiscreteProcess(fBoundaryProcess);
@@ -828,6 +890,52 @@ void G4EicDircDetector::ConstructMe(G4LogicalVolume* logicWorld)
   */
 }
 
+void G4EicDircDetector::AddBarGeom(G4LogicalVolume* logicWorld, const double dirclength)
+{
+  G4EicDircBarGeom* geom = new G4EicDircBarGeom();
+  geom->set_bar_size(fBar[0] / cm, fBar[1] / cm);
+  geom->set_bar_z(-0.5 * dirclength / cm, 0.5 * dirclength / cm);
+  geom->set_readout(fNCol * fNRow, fNpix1 * fNpix2);
+  for (int i = 0; i < fNBar; i++)
+  {
+    geom->AddBar((i * (fBar[1] + fBarsGap) - 0.5 * fBoxWidth + fBar[1] / 2.) / cm);
+  }
+
+  // the mirror is placed once by every imprint of the sector, the sector
+  // transformation follows from its position in the sector
+  const G4ThreeVector mirrorpos(0, 0, 0.5 * dirclength + fMirror[2] / 2.);
+  const G4int ndaughters = logicWorld->GetNoDaughters();
+  for (G4int i = 0; i < ndaughters; i++)
+  {
+    G4VPhysicalVolume* physvol = logicWorld->GetDaughter(i);
+    if (physvol->GetLogicalVolume() != lMirror) continue;
+
+    G4EicDircBarGeom::Sector sector;
+    const G4RotationMatrix rot = physvol->GetObjectRotationValue();
+    const G4ThreeVector center = physvol->GetObjectTranslation() - rot * mirrorpos;
+    for (int j = 0; j < 3; j++)
+    {
+      sector.center[j] = center[j] / cm;
+      for (int k = 0; k < 3; k++)
+      {
+        sector.rotation[j][k] = rot[j][k];
+      }
+    }
+    geom->AddSector(sector);
+  }
+  if (Verbosity()) std::cout << "bar geometry of " << geom->size() << " sectors" << std::endl;
+
+  PHNodeIterator iter(topNode());
+  PHCompositeNode* runNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "RUN"));
+  const std::string geonode = G4EicDircBarGeom::NodeName(SuperDetector());
+  if (findNode::getClass<G4EicDircBarGeom>(runNode, geonode))
+  {
+    std::cout << PHWHERE << " " << geonode << " exists already" << std::endl;
+    gSystem->Exit(1);
+  }
+  runNode->addNode(new PHDataNode<G4EicDircBarGeom>(geom, geonode));
+}
+
 void G4EicDircDetector::DefineMaterials()
 {
   G4String symbol;       //a=mass of a mole;
@@ -40,6 +40,19 @@ class G4EicDircDetector : public PHG4Detector
   //!@name volume accessors
   //@{
   int IsInDetector(G4VPhysicalVolume*) const;
+
+  //! lens volumes (i = 1, 2, 3), nullptr if not built for the chosen Lens_id
+  const G4LogicalVolume* GetLensVolume(int i) const;
+
+  //! MCP readout mode (0: pixel placements, 1: pixel from local position)
+  int GetMcpReadout() const { return fMcpReadout; }
+
+  //! pixel id for a photon at localpos with direction localdir on the surface
+  //! of an MCP (local frame), -1 outside the active area
+  int GetPixelId(const G4ThreeVector& localpos, const G4ThreeVector& localdir) const;
+
+  //! volume the DIRC sectors are placed in
+  const G4LogicalVolume* GetMotherVolume() const { return m_MotherVolume; }
   //@}
 
   void SuperDetector(const std::string& name) { m_SuperDetector = name; }
@@ -60,9 +73,9 @@ class G4EicDircDetector : public PHG4Detector
   G4LogicalVolume *lBarL, *lBarS;
   G4LogicalVolume* lGlue;
   G4LogicalVolume* lMirror;
-  G4LogicalVolume* lLens1;
-  G4LogicalVolume* lLens2;
-  G4LogicalVolume* lLens3;
+  G4LogicalVolume* lLens1 = nullptr;
+  G4LogicalVolume* lLens2 = nullptr;
+  G4LogicalVolume* lLens3 = nullptr;
   G4LogicalVolume* lPrizm;
   G4LogicalVolume* lMcp;
   G4LogicalVolume* lPixel;
@@ -89,6 +102,7 @@ class G4EicDircDetector : public PHG4Detector
   G4double fBoxWidth;
   G4int fGeomType;
   G4int fMcpLayout;
+  G4int fMcpReadout = 0;
   G4int fLensId;
   G4double fNBar;
   G4double fBar[3];
@@ -109,6 +123,8 @@ class G4EicDircDetector : public PHG4Detector
 
  protected:
   void DefineMaterials();
+  //! puts the placement of the bar boxes on the RUN node for the reconstruction
+  void AddBarGeom(G4LogicalVolume* logicWorld, const double dirclength);
   PHParameters* m_Params;
 
   G4EicDircDisplayAction* m_DisplayAction;
@@ -117,6 +133,8 @@ class G4EicDircDetector : public PHG4Detector
   //std::map<G4VPhysicalVolume *, int> m_PhysicalVolumes_active;
   std::map<G4LogicalVolume*, int> m_LogicalVolumes_active;
 
+  G4LogicalVolume* m_MotherVolume = nullptr;
+
   std::string m_SuperDetector;
 };
 
@@ -0,0 +1,120 @@
+#include "G4EicDircLUT.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  const char lut_magic[8] = "DIRCLUT";
+  const uint32_t lut_version = 1;
+}  // namespace
+
+G4EicDircLUT::~G4EicDircLUT()
+{
+  Close();
+}
+
+bool G4EicDircLUT::Open(const std::string &filename)
+{
+  Close();
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << PHWHERE << " could not open " << filename << std::endl;
+    return false;
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) < 0 || filestat.st_size < static_cast<off_t>(sizeof(Header)))
+  {
+    std::cout << PHWHERE << " " << filename << " is too short for a DIRC lookup table" << std::endl;
+    close(fd);
+    return false;
+  }
+  void *map = mmap(nullptr, filestat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping keeps its own reference to the file
+  close(fd);
+  if (map == MAP_FAILED)
+  {
+    std::cout << PHWHERE << " could not map " << filename << std::endl;
+    return false;
+  }
+  m_Map = map;
+  m_MapSize = filestat.st_size;
+
+  const Header *header = static_cast<const Header *>(m_Map);
+  const size_t nentries = static_cast<size_t>(header->nbars) * header->nmcp * header->npixel * header->nentries;
+  if (std::memcmp(header->magic, lut_magic, sizeof(lut_magic)) || header->version != lut_version ||
+      m_MapSize != sizeof(Header) + nentries * sizeof(Entry))
+  {
+    std::cout << PHWHERE << " " << filename << " is not a DIRC lookup table of version " << lut_version << std::endl;
+    Close();
+    return false;
+  }
+  m_Header = header;
+  m_Entries = reinterpret_cast<const Entry *>(static_cast<const char *>(m_Map) + sizeof(Header));
+  return true;
+}
+
+void G4EicDircLUT::Close()
+{
+  if (m_Map)
+  {
+    munmap(m_Map, m_MapSize);
+  }
+  m_Map = nullptr;
+  m_MapSize = 0;
+  m_Header = nullptr;
+  m_Entries = nullptr;
+}
+
+const G4EicDircLUT::Entry *G4EicDircLUT::GetNode(const int bar, const int mcp, const int pixel) const
+{
+  if (!m_Header ||
+      bar < 0 || bar >= static_cast<int>(m_Header->nbars) ||
+      mcp < 0 || mcp >= static_cast<int>(m_Header->nmcp) ||
+      pixel < 0 || pixel >= static_cast<int>(m_Header->npixel))
+  {
+    return nullptr;
+  }
+  const size_t node = (static_cast<size_t>(bar) * m_Header->nmcp + mcp) * m_Header->npixel + pixel;
+  return m_Entries + node * m_Header->nentries;
+}
+
+bool G4EicDircLUT::Write(const std::string &filename, const Header &header, const std::vector<Entry> &entries)
+{
+  if (entries.size() != static_cast<size_t>(header.nbars) * header.nmcp * header.npixel * header.nentries)
+  {
+    std::cout << PHWHERE << " number of entries does not match the header" << std::endl;
+    return false;
+  }
+  std::ofstream fout(filename, std::ios::binary);
+  fout.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+  fout.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Entry));
+  if (!fout)
+  {
+    std::cout << PHWHERE << " could not write " << filename << std::endl;
+    return false;
+  }
+  return true;
+}
+
+G4EicDircLUT::Header G4EicDircLUT::MakeHeader(const int nbars, const int nmcp, const int npixel, const int nentries)
+{
+  Header header;
+  std::memcpy(header.magic, lut_magic, sizeof(lut_magic));
+  header.version = lut_version;
+  header.nbars = nbars;
+  header.nmcp = nmcp;
+  header.npixel = npixel;
+  header.nentries = nentries;
+  header.unused = 0;
+  return header;
+}
@@ -0,0 +1,74 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICDIRCLUT_H
+#define G4EICDIRCLUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief photon direction lookup table of the DIRC
+ *
+ * For every bar of a sector, MCP and pixel the table holds up to nentries
+ * photon directions at the readout end of the bar (sector frame, pointing
+ * to -z) and the mean time from the bar end to the pixel. Pixels which are
+ * reached by several paths through the prism have several entries, unused
+ * entries have nphotons = 0 and follow the used ones.
+ *
+ * The file is a header followed by the flat array of the entries, so Open()
+ * maps it read-only into memory and GetNode() is pointer arithmetic. Pages
+ * are only read from disk when a pixel is hit.
+ */
+class G4EicDircLUT
+{
+ public:
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nbars;
+    uint32_t nmcp;
+    uint32_t npixel;
+    uint32_t nentries;
+    uint32_t unused;
+  };
+
+  struct Entry
+  {
+    float dir[3];
+    //! ns from the end of the bar to the pixel
+    float time;
+    uint32_t nphotons;
+  };
+
+  G4EicDircLUT() = default;
+  ~G4EicDircLUT();
+
+  G4EicDircLUT(const G4EicDircLUT &) = delete;
+  G4EicDircLUT &operator=(const G4EicDircLUT &) = delete;
+
+  //! maps the file, false if it cannot be read or is not a DIRC lookup table
+  bool Open(const std::string &filename);
+  void Close();
+
+  const Header *GetHeader() const { return m_Header; }
+
+  //! first of the nentries entries of a pixel, nullptr if the ids are out of range
+  const Entry *GetNode(const int bar, const int mcp, const int pixel) const;
+
+  //! writes a table, entries are ordered as in GetNode
+  static bool Write(const std::string &filename, const Header &header, const std::vector<Entry> &entries);
+
+  //! header with the magic and version of this class
+  static Header MakeHeader(const int nbars, const int nmcp, const int npixel, const int nentries);
+
+ private:
+  void *m_Map = nullptr;
+  size_t m_MapSize = 0;
+  const Header *m_Header = nullptr;
+  const Entry *m_Entries = nullptr;
+};
+
+#endif  // G4EICDIRCLUT_H
@@ -0,0 +1,235 @@
+#include "G4EicDircLUTMaker.h"
+
+#include "G4EicDircBarGeom.h"
+#include "G4EicDircLUT.h"
+#include "PrtHit.h"
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4Particle.h>
+#include <g4main/PHG4TruthInfoContainer.h>
+#include <g4main/PHG4VtxPoint.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+
+namespace
+{
+  // cm/ns
+  const double speed_of_light = 29.9792458;
+
+  //! sign of the direction after the reflections off the walls at +-width/2
+  double ReflectionSign(const double x, const double dx, const double width)
+  {
+    const long nwalls = std::lround(std::floor((x + dx + 0.5 * width) / width));
+    return (nwalls % 2) ? -1. : 1.;
+  }
+}  // namespace
+
+G4EicDircLUTMaker::G4EicDircLUTMaker(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+int G4EicDircLUTMaker::InitRun(PHCompositeNode *topNode)
+{
+  const std::string geonodename = G4EicDircBarGeom::NodeName(m_Detector);
+  m_Geom = findNode::getClass<G4EicDircBarGeom>(topNode, geonodename);
+  if (!m_Geom)
+  {
+    std::cout << PHWHERE << " Could not locate bar geometry node " << geonodename << std::endl;
+    exit(1);
+  }
+  if (m_NEntries < 1)
+  {
+    std::cout << PHWHERE << " the lookup table needs at least one entry per pixel" << std::endl;
+    exit(1);
+  }
+  m_Nodes.assign(static_cast<size_t>(m_Geom->nbars()) * m_Geom->get_nmcp() * m_Geom->get_npixel() * m_NEntries, Accumulator());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int G4EicDircLUTMaker::process_event(PHCompositeNode *topNode)
+{
+  const std::string hitnodename = "G4HIT_" + m_Detector;
+  PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, hitnodename);
+  if (!hits)
+  {
+    std::cout << PHWHERE << " Could not locate g4 hit node " << hitnodename << std::endl;
+    exit(1);
+  }
+  PHG4TruthInfoContainer *truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
+  if (!truthinfo)
+  {
+    std::cout << PHWHERE << " Could not locate G4TruthInfo node" << std::endl;
+    exit(1);
+  }
+
+  PHG4HitContainer::ConstRange range = hits->getHits();
+  for (PHG4HitContainer::ConstIterator hititer = range.first; hititer != range.second; ++hititer)
+  {
+    PrtHit *hit = dynamic_cast<PrtHit *>(hititer->second);
+    if (!hit || hit->GetMcpId() < 0 || hit->GetPixelId() < 0)
+    {
+      continue;
+    }
+    m_NPhotons++;
+    const PHG4Particle *photon = truthinfo->GetParticle(hit->get_trkid());
+    if (!photon)
+    {
+      continue;
+    }
+    const PHG4VtxPoint *vtx = truthinfo->GetVtx(photon->get_vtx_id());
+    if (!vtx)
+    {
+      continue;
+    }
+    const double hitpos[3] = {hit->get_x(0), hit->get_y(0), hit->get_z(0)};
+    const int isector = m_Geom->FindSector(hitpos);
+    if (isector < 0)
+    {
+      continue;
+    }
+    const G4EicDircBarGeom::Sector &sector = m_Geom->GetSector(isector);
+    const double vtxpos[3] = {vtx->get_x(), vtx->get_y(), vtx->get_z()};
+    const double mom[3] = {photon->get_px(), photon->get_py(), photon->get_pz()};
+    double pos[3];
+    double dir[3];
+    sector.GlobalToLocal(vtxpos, pos);
+    sector.GlobalToLocalDir(mom, dir);
+    const double norm = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+    if (!(norm > 0))
+    {
+      continue;
+    }
+    for (double &d : dir)
+    {
+      d /= norm;
+    }
+
+    int bar;
+    double exitdir[3];
+    double path;
+    if (!UnfoldBar(pos, dir, bar, exitdir, path))
+    {
+      continue;
+    }
+    const double time = hit->get_t(0) - vtx->get_t() - path * m_GroupIndex / speed_of_light;
+    Fill(bar, hit->GetMcpId(), hit->GetPixelId(), exitdir, time);
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int G4EicDircLUTMaker::End(PHCompositeNode * /*topNode*/)
+{
+  if (m_Nodes.empty())
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  std::vector<G4EicDircLUT::Entry> entries(m_Nodes.size(), G4EicDircLUT::Entry());
+  unsigned long nused = 0;
+  for (size_t node = 0; node < m_Nodes.size(); node += m_NEntries)
+  {
+    // the most frequent paths go first
+    std::vector<Accumulator> pixel(m_Nodes.begin() + node, m_Nodes.begin() + node + m_NEntries);
+    std::sort(pixel.begin(), pixel.end(), [](const Accumulator &a, const Accumulator &b) { return a.nphotons > b.nphotons; });
+    size_t ientry = node;
+    for (const Accumulator &acc : pixel)
+    {
+      if (acc.nphotons < std::max(m_MinPhotons, 1))
+      {
+        break;
+      }
+      const double norm = std::sqrt(acc.dir[0] * acc.dir[0] + acc.dir[1] * acc.dir[1] + acc.dir[2] * acc.dir[2]);
+      G4EicDircLUT::Entry &entry = entries[ientry++];
+      for (int i = 0; i < 3; i++)
+      {
+        entry.dir[i] = acc.dir[i] / norm;
+      }
+      entry.time = acc.time / acc.nphotons;
+      entry.nphotons = acc.nphotons;
+      nused++;
+    }
+  }
+
+  const G4EicDircLUT::Header header = G4EicDircLUT::MakeHeader(m_Geom->nbars(), m_Geom->get_nmcp(), m_Geom->get_npixel(), m_NEntries);
+  if (!G4EicDircLUT::Write(m_FileName, header, entries))
+  {
+    exit(1);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << m_NFilled << " of " << m_NPhotons << " photons in "
+              << nused << " directions written to " << m_FileName << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+bool G4EicDircLUTMaker::UnfoldBar(const double pos[3], const double dir[3], int &bar, double exitdir[3], double &path) const
+{
+  const double thickness = m_Geom->get_bar_thickness();
+  const double width = m_Geom->get_bar_width();
+  const double zreadout = m_Geom->get_bar_z(0);
+  const double zmirror = m_Geom->get_bar_z(1);
+  if (std::abs(pos[0]) > 0.5 * thickness || pos[2] < zreadout || pos[2] > zmirror || dir[2] == 0)
+  {
+    return false;
+  }
+  bar = m_Geom->FindBar(pos[1]);
+  if (bar < 0)
+  {
+    return false;
+  }
+  const double y = pos[1] - m_Geom->GetBarY(bar);
+  if (std::abs(y) > 0.5 * width)
+  {
+    return false;
+  }
+
+  // photons going to +z come back from the mirror
+  const double zpath = (dir[2] < 0) ? pos[2] - zreadout : 2. * zmirror - pos[2] - zreadout;
+  path = zpath / std::abs(dir[2]);
+  exitdir[0] = ReflectionSign(pos[0], dir[0] * path, thickness) * dir[0];
+  exitdir[1] = ReflectionSign(y, dir[1] * path, width) * dir[1];
+  exitdir[2] = -std::abs(dir[2]);
+  return true;
+}
+
+void G4EicDircLUTMaker::Fill(const int bar, const int mcp, const int pixel, const double dir[3], const double time)
+{
+  if (mcp >= m_Geom->get_nmcp() || pixel >= m_Geom->get_npixel())
+  {
+    return;
+  }
+  const size_t node = ((static_cast<size_t>(bar) * m_Geom->get_nmcp() + mcp) * m_Geom->get_npixel() + pixel) * m_NEntries;
+  const double mincos = std::cos(m_ClusterAngle);
+  for (int i = 0; i < m_NEntries; i++)
+  {
+    Accumulator &acc = m_Nodes[node + i];
+    if (acc.nphotons > 0)
+    {
+      const double norm = std::sqrt(acc.dir[0] * acc.dir[0] + acc.dir[1] * acc.dir[1] + acc.dir[2] * acc.dir[2]);
+      if ((acc.dir[0] * dir[0] + acc.dir[1] * dir[1] + acc.dir[2] * dir[2]) < mincos * norm)
+      {
+        continue;
+      }
+    }
+    for (int j = 0; j < 3; j++)
+    {
+      acc.dir[j] += dir[j];
+    }
+    acc.time += time;
+    acc.nphotons++;
+    m_NFilled++;
+    return;
+  }
+  // all entries of the pixel are taken by other paths, the photon is dropped
+}
@@ -0,0 +1,91 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICDIRCLUTMAKER_H
+#define G4EICDIRCLUTMAKER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class G4EicDircBarGeom;
+class PHCompositeNode;
+
+/**
+ * \brief generates the DIRC lookup table from simulated photons
+ *
+ * Every detected photon (a hit with MCP and pixel id) which was created in
+ * a bar is traced back with its truth vertex and momentum: the reflections
+ * off the sides of the bar (and the mirror) are unfolded analytically to
+ * get the direction at the readout end of the bar and the time spent in
+ * the bar. Directions within the cluster angle are averaged per bar, MCP
+ * and pixel, together with the remaining time to the pixel. All sectors
+ * are identical, so they all fill the same table. The photons are only
+ * in the truth container because the stepping action keeps the tracks of
+ * the hits, any sample of charged tracks through the bars (or of optical
+ * photons started at the bar ends) will do.
+ *
+ * The table is written to the file at End, see G4EicDircLUT.
+ */
+class G4EicDircLUTMaker : public SubsysReco
+{
+ public:
+  G4EicDircLUTMaker(const std::string &name = "G4EicDircLUTMaker");
+  ~G4EicDircLUTMaker() override {}
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  //! writes the table
+  int End(PHCompositeNode *topNode) override;
+
+  /** Name of the detector, used for the hit and geometry nodes.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+  void set_filename(const std::string &name) { m_FileName = name; }
+
+  //! group refractive index of the bars, for the time spent in the bar
+  void set_group_index(const double n) { m_GroupIndex = n; }
+  //! photons within this angle (rad) go to the same direction of a pixel
+  void set_cluster_angle(const double a) { m_ClusterAngle = a; }
+  //! directions per pixel, directions with less photons are dropped at the end
+  void set_entries(const int nentries, const int minphotons)
+  {
+    m_NEntries = nentries;
+    m_MinPhotons = minphotons;
+  }
+
+ private:
+  struct Accumulator
+  {
+    double dir[3];
+    double time;
+    int nphotons;
+  };
+
+  /*!
+   * bar, direction at the readout end and path length in the bar (cm) of a
+   * photon created at pos with the direction dir (sector frame), false if
+   * it was not created in a bar
+   */
+  bool UnfoldBar(const double pos[3], const double dir[3], int &bar, double exitdir[3], double &path) const;
+
+  void Fill(const int bar, const int mcp, const int pixel, const double dir[3], const double time);
+
+  const G4EicDircBarGeom *m_Geom = nullptr;
+
+  std::string m_Detector = "DIRC";
+  std::string m_FileName = "dirc_lut.bin";
+
+  double m_GroupIndex = 1.5;
+  double m_ClusterAngle = 0.01;
+  int m_NEntries = 8;
+  int m_MinPhotons = 3;
+
+  std::vector<Accumulator> m_Nodes;
+  unsigned long m_NPhotons = 0;
+  unsigned long m_NFilled = 0;
+};
+
+#endif  // G4EICDIRCLUTMAKER_H
@@ -0,0 +1,317 @@
+#include "G4EicDircLUTReco.h"
+
+#include "G4EicDircBarGeom.h"
+#include "PrtHit.h"
+
+#include <eicpidbase/EICPIDDefs.h>
+#include <eicpidbase/EICPIDParticle.h>
+#include <eicpidbase/EICPIDParticleContainer.h>
+
+#include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackState.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <limits>
+
+namespace
+{
+  struct Hypothesis
+  {
+    EICPIDDefs::PIDCandidate candidate;
+    double mass;  // GeV
+  };
+
+  const Hypothesis hypotheses[] = {
+      {EICPIDDefs::ElectronCandiate, 0.000511},
+      {EICPIDDefs::PionCandiate, 0.13957},
+      {EICPIDDefs::KaonCandiate, 0.493677},
+      {EICPIDDefs::ProtonCandiate, 0.938272}};
+
+  // cm/ns
+  const double speed_of_light = 29.9792458;
+}  // namespace
+
+G4EicDircLUTReco::G4EicDircLUTReco(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+int G4EicDircLUTReco::InitRun(PHCompositeNode *topNode)
+{
+  const std::string geonodename = G4EicDircBarGeom::NodeName(m_Detector);
+  m_Geom = findNode::getClass<G4EicDircBarGeom>(topNode, geonodename);
+  if (!m_Geom)
+  {
+    std::cout << PHWHERE << " Could not locate bar geometry node " << geonodename << std::endl;
+    exit(1);
+  }
+  if (!m_LUT.Open(m_LUTFileName))
+  {
+    exit(1);
+  }
+  const G4EicDircLUT::Header *header = m_LUT.GetHeader();
+  if (static_cast<int>(header->nbars) != m_Geom->nbars() ||
+      static_cast<int>(header->nmcp) != m_Geom->get_nmcp() ||
+      static_cast<int>(header->npixel) != m_Geom->get_npixel())
+  {
+    std::cout << PHWHERE << " lookup table " << m_LUTFileName << " with " << header->nbars << " bars, "
+              << header->nmcp << " MCPs and " << header->npixel << " pixels does not match the geometry" << std::endl;
+    exit(1);
+  }
+
+  m_PIDContainer = findNode::getClass<EICPIDParticleContainer>(topNode, "EICPIDParticleMap");
+  if (!m_PIDContainer)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+      exit(1);
+    }
+    m_PIDContainer = new EICPIDParticleContainer();
+    dstNode->addNode(new PHIODataNode<PHObject>(m_PIDContainer, "EICPIDParticleMap", "PHObject"));
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int G4EicDircLUTReco::process_event(PHCompositeNode *topNode)
+{
+  const std::string hitnodename = "G4HIT_" + m_Detector;
+  m_Hits = findNode::getClass<PHG4HitContainer>(topNode, hitnodename);
+  if (!m_Hits)
+  {
+    std::cout << PHWHERE << " Could not locate g4 hit node " << hitnodename << std::endl;
+    exit(1);
+  }
+  m_TrackMap = findNode::getClass<SvtxTrackMap>(topNode, m_TrackMapName);
+  if (!m_TrackMap)
+  {
+    std::cout << PHWHERE << " Could not locate track node " << m_TrackMapName << std::endl;
+    exit(1);
+  }
+
+  // the pixel hits are sorted into the sectors once for all tracks
+  std::vector<std::vector<PixelHit>> sector_hits(m_Geom->size());
+  PHG4HitContainer::ConstRange range = m_Hits->getHits();
+  for (PHG4HitContainer::ConstIterator hititer = range.first; hititer != range.second; ++hititer)
+  {
+    PrtHit *hit = dynamic_cast<PrtHit *>(hititer->second);
+    if (!hit || hit->GetMcpId() < 0 || hit->GetPixelId() < 0)
+    {
+      continue;
+    }
+    const double global[3] = {hit->get_x(0), hit->get_y(0), hit->get_z(0)};
+    const int isector = m_Geom->FindSector(global);
+    if (isector >= 0)
+    {
+      sector_hits[isector].push_back({hit->GetMcpId(), hit->GetPixelId(), hit->get_t(0)});
+    }
+  }
+
+  std::vector<Candidate> candidates;
+  for (SvtxTrackMap::ConstIter iter = m_TrackMap->begin(); iter != m_TrackMap->end(); ++iter)
+  {
+    const SvtxTrack *track = iter->second;
+    int bar;
+    double local_pos[3];
+    double local_dir[3];
+    double mom;
+    double path;
+    const int isector = FindBar(track, bar, local_pos, local_dir, mom, path);
+    if (isector < 0)
+    {
+      continue;
+    }
+    const std::vector<PixelHit> &pixelhits = sector_hits[isector];
+    candidates.clear();
+    GetCandidates(bar, local_pos, local_dir, pixelhits, candidates);
+
+    EICPIDParticle *pidparticle = m_PIDContainer->findOrAddPIDParticle(track->get_id())->second;
+    for (const Hypothesis &hypo : hypotheses)
+    {
+      const double loglikelihood = LogLikelihood(local_dir, mom, path, hypo.mass, pixelhits.size(), candidates);
+      pidparticle->set_LogLikelyhood(hypo.candidate, EICPIDDefs::DIRC, loglikelihood);
+    }
+    if (Verbosity() > 1)
+    {
+      std::cout << Name() << ": track " << track->get_id() << " p = " << mom
+                << " GeV in sector " << isector << " bar " << bar
+                << " with " << pixelhits.size() << " hits, " << candidates.size() << " candidates" << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int G4EicDircLUTReco::FindBar(const SvtxTrack *track, int &bar, double local_pos[3], double local_dir[3], double &mom, double &path) const
+{
+  double pos[3] = {track->get_x(), track->get_y(), track->get_z()};
+  double dir[3] = {track->get_px(), track->get_py(), track->get_pz()};
+  double pathlength = 0;
+  for (SvtxTrack::ConstStateIter iter = track->begin_states(); iter != track->end_states(); ++iter)
+  {
+    const SvtxTrackState *state = iter->second;
+    if (state->get_name() == m_ProjectionName)
+    {
+      pos[0] = state->get_x();
+      pos[1] = state->get_y();
+      pos[2] = state->get_z();
+      dir[0] = state->get_px();
+      dir[1] = state->get_py();
+      dir[2] = state->get_pz();
+      pathlength = state->get_pathlength();
+      break;
+    }
+  }
+  mom = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+  if (!(mom > 0))
+  {
+    return -1;
+  }
+  for (double &d : dir)
+  {
+    d /= mom;
+  }
+
+  // sector closest along the track whose bars are crossed
+  int found = -1;
+  double mindist = std::numeric_limits<double>::max();
+  for (int i = 0; i < m_Geom->size(); i++)
+  {
+    const G4EicDircBarGeom::Sector &sector = m_Geom->GetSector(i);
+    double lpos[3];
+    double ldir[3];
+    sector.GlobalToLocal(pos, lpos);
+    sector.GlobalToLocalDir(dir, ldir);
+    if (ldir[0] == 0)
+    {
+      continue;
+    }
+    const double t = -lpos[0] / ldir[0];
+    const double y = lpos[1] + t * ldir[1];
+    const double z = lpos[2] + t * ldir[2];
+    // no intersections behind the vertex
+    if (pathlength + t < 0 || z < m_Geom->get_bar_z(0) || z > m_Geom->get_bar_z(1) || std::abs(t) >= mindist)
+    {
+      continue;
+    }
+    const int ibar = m_Geom->FindBar(y);
+    if (ibar < 0)
+    {
+      continue;
+    }
+    found = i;
+    bar = ibar;
+    mindist = std::abs(t);
+    path = pathlength + t;
+    local_pos[0] = 0;
+    local_pos[1] = y;
+    local_pos[2] = z;
+    for (int j = 0; j < 3; j++)
+    {
+      local_dir[j] = ldir[j];
+    }
+  }
+  return found;
+}
+
+void G4EicDircLUTReco::GetCandidates(const int bar, const double local_pos[3], const double local_dir[3],
+                                     const std::vector<PixelHit> &pixelhits, std::vector<Candidate> &candidates) const
+{
+  const double zreadout = m_Geom->get_bar_z(0);
+  const double zmirror = m_Geom->get_bar_z(1);
+  const unsigned int nentries = m_LUT.GetHeader()->nentries;
+  for (unsigned int ihit = 0; ihit < pixelhits.size(); ihit++)
+  {
+    const PixelHit &hit = pixelhits[ihit];
+    const G4EicDircLUT::Entry *node = m_LUT.GetNode(bar, hit.mcp, hit.pixel);
+    if (!node)
+    {
+      continue;
+    }
+    for (unsigned int ientry = 0; ientry < nentries && node[ientry].nphotons > 0; ientry++)
+    {
+      const G4EicDircLUT::Entry &entry = node[ientry];
+      const double dz = std::abs(entry.dir[2]);
+      if (!(dz > 0))
+      {
+        continue;
+      }
+      // bits 0 and 1: odd number of reflections off the sides in x and y,
+      // bit 2: the photon was emitted towards the mirror
+      for (int reflection = 0; reflection < 8; reflection++)
+      {
+        const double dir[3] = {(reflection & 1) ? -entry.dir[0] : entry.dir[0],
+                               (reflection & 2) ? -entry.dir[1] : entry.dir[1],
+                               (reflection & 4) ? dz : -dz};
+        const double cosangle = dir[0] * local_dir[0] + dir[1] * local_dir[1] + dir[2] * local_dir[2];
+        const double zpath = (reflection & 4) ? 2. * zmirror - local_pos[2] - zreadout : local_pos[2] - zreadout;
+        const double propagation = zpath / dz * m_GroupIndex / speed_of_light + entry.time;
+        candidates.push_back({ihit, std::acos(std::max(-1., std::min(1., cosangle))), hit.t - propagation});
+      }
+    }
+  }
+}
+
+double G4EicDircLUTReco::LogLikelihood(const double local_dir[3], const double mom, const double path, const double mass,
+                                       const unsigned int nhits, const std::vector<Candidate> &candidates) const
+{
+  const double beta = mom / std::sqrt(mom * mom + mass * mass);
+  const double cos_theta = 1. / (m_RefractiveIndex * beta);
+  double theta = 0;
+  double signal = 0;
+  if (cos_theta < 1.)
+  {
+    theta = std::acos(cos_theta);
+    signal = m_PhotonYield * m_Geom->get_bar_thickness() / std::abs(local_dir[0]) * (1. - cos_theta * cos_theta);
+  }
+  const double flighttime = path / (beta * speed_of_light);
+
+  // extended likelihood: Poisson term of the expected number of hits and
+  // the density of every hit, the best candidate of a hit is smeared with
+  // a Gaussian in angle and time on top of a background which is flat in
+  // the angle (0, pi/2) and the time window
+  const double normalization = 1. / (2. * M_PI * m_AngleResolution * m_TimeResolution);
+  const double background = m_Background / (0.5 * M_PI * 2. * m_TimeWindow);
+  double loglikelihood = -(signal + m_Background);
+  unsigned int nmatched = 0;
+  size_t icand = 0;
+  while (icand < candidates.size())
+  {
+    const unsigned int hit = candidates[icand].hit;
+    double best = 0;
+    for (; icand < candidates.size() && candidates[icand].hit == hit; ++icand)
+    {
+      const double dt = candidates[icand].time - flighttime;
+      if (std::abs(dt) > m_TimeWindow)
+      {
+        continue;
+      }
+      const double dtheta = (candidates[icand].angle - theta) / m_AngleResolution;
+      best = std::max(best, std::exp(-0.5 * (dtheta * dtheta + dt * dt / (m_TimeResolution * m_TimeResolution))));
+    }
+    loglikelihood += std::log(signal * normalization * best + background);
+    nmatched++;
+  }
+  // hits without a path through the bar only see the background
+  loglikelihood += (nhits - nmatched) * std::log(background);
+  return loglikelihood;
+}
@@ -0,0 +1,122 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICDIRCLUTRECO_H
+#define G4EICDIRCLUTRECO_H
+
+#include "G4EicDircLUT.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class EICPIDParticleContainer;
+class G4EicDircBarGeom;
+class PHCompositeNode;
+class PHG4HitContainer;
+class SvtxTrack;
+class SvtxTrackMap;
+
+/**
+ * \brief DIRC particle identification with the photon direction lookup table
+ *
+ * Every track is extended as a straight line from its projection onto the
+ * DIRC (or from the vertex if there is none) to the middle plane of the bar
+ * it crosses. For every hit pixel of the sector the directions of the
+ * lookup table (see G4EicDircLUTMaker) are unfolded back into the bar: the
+ * four reflections off the sides and the mirror give eight candidate
+ * photon directions. Each candidate has a Cherenkov angle with respect to
+ * the track and a time of propagation from the path in the bar and the
+ * time from the bar end to the pixel of the table.
+ *
+ * Per mass hypothesis the candidate closest in angle and time residual is
+ * taken, the photon density is a Gaussian in both on top of a flat
+ * background and the extended log-likelihood of the hits of the sector goes
+ * to EICPIDParticleMap. The table is memory mapped and only the nodes of
+ * the hit pixels are read, so the cost is linear in the number of hits.
+ */
+class G4EicDircLUTReco : public SubsysReco
+{
+ public:
+  G4EicDircLUTReco(const std::string &name = "G4EicDircLUTReco");
+  ~G4EicDircLUTReco() override {}
+
+  //! maps the lookup table
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  /** Name of the detector, used for the hit and geometry nodes.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+  void set_lut_filename(const std::string &name) { m_LUTFileName = name; }
+  void set_trackmap_name(const std::string &name) { m_TrackMapName = name; }
+  //! name of the track state at the DIRC
+  void set_projection_name(const std::string &name) { m_ProjectionName = name; }
+
+  //! phase (Cherenkov angle) and group (time of propagation) refractive index of the bars
+  void set_refractive_index(const double n, const double ngroup)
+  {
+    m_RefractiveIndex = n;
+    m_GroupIndex = ngroup;
+  }
+  //! photoelectrons per cm of bar at sin^2(theta_c) = 1
+  void set_photon_yield(const double n) { m_PhotonYield = n; }
+  //! expected number of noise hits per track, > 0 keeps the likelihood of stray hits finite
+  void set_background(const double b) { m_Background = b; }
+  //! single photon resolution of the Cherenkov angle (rad) and the time of propagation (ns)
+  void set_resolution(const double angle, const double time)
+  {
+    m_AngleResolution = angle;
+    m_TimeResolution = time;
+  }
+  //! candidates with a larger time residual (ns) are ignored, it is also the range of the background
+  void set_time_window(const double t) { m_TimeWindow = t; }
+
+ private:
+  struct PixelHit
+  {
+    int mcp;
+    int pixel;
+    double t;
+  };
+
+  struct Candidate
+  {
+    //! index of the hit in the sector
+    unsigned int hit;
+    double angle;
+    //! hit time minus the propagation time of the photon
+    double time;
+  };
+
+  //! sector and bar index, point on the middle plane of the bar and direction (sector frame), -1 if the track misses the DIRC
+  int FindBar(const SvtxTrack *track, int &bar, double local_pos[3], double local_dir[3], double &mom, double &path) const;
+
+  void GetCandidates(const int bar, const double local_pos[3], const double local_dir[3],
+                     const std::vector<PixelHit> &pixelhits, std::vector<Candidate> &candidates) const;
+
+  double LogLikelihood(const double local_dir[3], const double mom, const double path, const double mass,
+                       const unsigned int nhits, const std::vector<Candidate> &candidates) const;
+
+  G4EicDircLUT m_LUT;
+  const G4EicDircBarGeom *m_Geom = nullptr;
+  PHG4HitContainer *m_Hits = nullptr;
+  SvtxTrackMap *m_TrackMap = nullptr;
+  EICPIDParticleContainer *m_PIDContainer = nullptr;
+
+  std::string m_Detector = "DIRC";
+  std::string m_LUTFileName = "dirc_lut.bin";
+  std::string m_TrackMapName = "TrackMap";
+  std::string m_ProjectionName = "DIRC";
+
+  double m_RefractiveIndex = 1.473;
+  double m_GroupIndex = 1.5;
+  double m_PhotonYield = 30.;
+  double m_Background = 1.;
+  double m_AngleResolution = 0.01;
+  double m_TimeResolution = 0.5;
+  double m_TimeWindow = 2.;
+};
+
+#endif  // G4EICDIRCLUTRECO_H
@@ -1,11 +1,40 @@
 #include "G4EicDircOpBoundaryProcess.h"
 
+#include "G4EicDircDetector.h"
+
+#include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Step.hh>
 #include <Geant4/G4TouchableHistory.hh>
 #include <Geant4/G4Track.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
 
 #include <set>
 
+void G4EicDircOpBoundaryProcess::ResolveVolumes()
+{
+  if (m_Detector)
+  {
+    m_Lens1 = m_Detector->GetLensVolume(1);
+    m_Lens2 = m_Detector->GetLensVolume(2);
+    m_Lens3 = m_Detector->GetLensVolume(3);
+    m_Mother = m_Detector->GetMotherVolume();
+  }
+  m_VolumesResolved = true;
+}
+
+G4EicDircOpBoundaryProcess::VolumeRole G4EicDircOpBoundaryProcess::GetRole(const G4VPhysicalVolume* volume) const
+{
+  // the sectors are assembly imprints, all placements of a lens share
+  // its logical volume, so a pointer comparison is sufficient
+  const G4LogicalVolume* logvol = volume ? volume->GetLogicalVolume() : nullptr;
+  if (!logvol) return kOther;
+  if (logvol == m_Lens1) return kLens1;
+  if (logvol == m_Lens2) return kLens2;
+  if (logvol == m_Lens3) return kLens3;
+  if (logvol == m_Mother) return kMother;
+  return kOther;
+}
+
 G4VParticleChange* G4EicDircOpBoundaryProcess::PostStepDoIt(const G4Track& aTrack, const G4Step& aStep)
 {
   G4StepPoint* pPreStepPoint = aStep.GetPreStepPoint();
@@ -59,19 +88,26 @@ G4VParticleChange* G4EicDircOpBoundaryProcess::PostStepDoIt(const G4Track& aTrac
     pParticleChange->ProposeTrackStatus(fStopAndKill);
     }*/
 
-  if (aStep.GetPreStepPoint()->GetPhysicalVolume()->GetName() == "wLens3" && pPostStepPoint->GetPosition().z() > pPreStepPoint->GetPosition().z())
+  if (!m_VolumesResolved)
+  {
+    ResolveVolumes();
+  }
+  VolumeRole preRole = GetRole(pPreStepPoint->GetPhysicalVolume());
+  VolumeRole postRole = GetRole(pPostStepPoint->GetPhysicalVolume());
+
+  if (preRole == kLens3 && pPostStepPoint->GetPosition().z() > pPreStepPoint->GetPosition().z())
   {
     pParticleChange->ProposeTrackStatus(fStopAndKill);
   }
 
   // kill photons outside bar and prizm
 
-  if (GetStatus() == FresnelRefraction && aStep.GetPostStepPoint()->GetPhysicalVolume()->GetName() == "wDirc")
+  if (GetStatus() == FresnelRefraction && postRole == kMother)
   {
     pParticleChange->ProposeTrackStatus(fStopAndKill);
   }
 
-  if ((aStep.GetPreStepPoint()->GetPhysicalVolume()->GetName() == "wLens1" || aStep.GetPreStepPoint()->GetPhysicalVolume()->GetName() == "wLens2") && aStep.GetPostStepPoint()->GetPhysicalVolume()->GetName() == "wDirc")
+  if ((preRole == kLens1 || preRole == kLens2) && postRole == kMother)
   {
     pParticleChange->ProposeTrackStatus(fStopAndKill);
   }
@@ -84,11 +120,11 @@ G4VParticleChange* G4EicDircOpBoundaryProcess::PostStepDoIt(const G4Track& aTrac
   //   pParticleChange->ProposeTrackStatus(fStopAndKill);
   // }
 
-  if (aStep.GetPreStepPoint()->GetPhysicalVolume()->GetName() == "wLens1" && aStep.GetPostStepPoint()->GetPhysicalVolume()->GetName() == "wLens1")
+  if (preRole == kLens1 && postRole == kLens1)
   {
     pParticleChange->ProposeTrackStatus(fStopAndKill);
   }
-  if (aStep.GetPreStepPoint()->GetPhysicalVolume()->GetName() == "wLens2" && aStep.GetPostStepPoint()->GetPhysicalVolume()->GetName() == "wLens2")
+  if (preRole == kLens2 && postRole == kLens2)
   {
     pParticleChange->ProposeTrackStatus(fStopAndKill);
   }
@@ -5,6 +5,10 @@
 #include <Geant4/G4OpticalPhoton.hh>
 #include <Geant4/G4VParticleChange.hh>
 
+class G4EicDircDetector;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
 class G4EicDircOpBoundaryProcess : public G4OpBoundaryProcess
 {
  public:
@@ -20,7 +24,31 @@ class G4EicDircOpBoundaryProcess : public G4OpBoundaryProcess
 
   G4VParticleChange* PostStepDoIt(const G4Track& aTrack, const G4Step& aStep) override;
 
+  //! detector providing the lens and mother volumes, they are resolved
+  //! on the first boundary step, i.e. after the geometry is constructed
+  void SetDetector(const G4EicDircDetector* detector) { m_Detector = detector; }
+
  private:
+  //! role of a volume in the boundary checks, replaces the comparisons of
+  //! the physical volume names (wLens1, wLens2, wLens3, wDirc)
+  enum VolumeRole
+  {
+    kOther = 0,
+    kLens1,
+    kLens2,
+    kLens3,
+    kMother
+  };
+
+  VolumeRole GetRole(const G4VPhysicalVolume* volume) const;
+  void ResolveVolumes();
+
+  const G4EicDircDetector* m_Detector = nullptr;
+  bool m_VolumesResolved = false;
+  const G4LogicalVolume* m_Lens1 = nullptr;
+  const G4LogicalVolume* m_Lens2 = nullptr;
+  const G4LogicalVolume* m_Lens3 = nullptr;
+  const G4LogicalVolume* m_Mother = nullptr;
 };
 
 inline G4bool G4EicDircOpBoundaryProcess::IsApplicable(const G4ParticleDefinition&
@@ -18,6 +18,7 @@
 #include <TSystem.h>
 #include <TVector3.h>
 
+#include <Geant4/G4AffineTransform.hh>
 #include <Geant4/G4NavigationHistory.hh>
 #include <Geant4/G4ParticleDefinition.hh>      // for G4ParticleDefinition
 #include <Geant4/G4ReferenceCountedHandle.hh>  // for G4ReferenceCountedHandle
@@ -137,7 +138,7 @@ bool G4EicDircSteppingAction::UserSteppingAction(const G4Step* aStep,
       }
       if (!m_Hit)
       {
-        m_Hit = new PHG4Hitv1();
+        m_Hit = new PrtHit();
       }
       //here we set the entrance values in cm
       m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
@@ -252,6 +253,11 @@ bool G4EicDircSteppingAction::UserSteppingAction(const G4Step* aStep,
       // save only hits with energy deposit (or -1 for geantino)
       if (m_Hit->get_edep())
       {
+        // optical photons are detected on the boundary of the
+        // photocathode, so the post step point decides the pixel
+        SetReadoutIds(prePoint);
+        SetReadoutIds(postPoint);
+
         m_HitContainer->AddHit(0, m_Hit);
         // ownership has been transferred to container, set to null
         // so we will create a new hit for the next track
@@ -274,6 +280,36 @@ bool G4EicDircSteppingAction::UserSteppingAction(const G4Step* aStep,
   }
 }
 
+//____________________________________________________________________________..
+void G4EicDircSteppingAction::SetReadoutIds(const G4StepPoint* point)
+{
+  const G4TouchableHandle& touch = point->GetTouchableHandle();
+  G4VPhysicalVolume* volume = touch->GetVolume();
+  if (!volume)
+  {
+    return;
+  }
+  switch (m_Detector->IsInDetector(volume))
+  {
+  case 11:  // wPixel inside wMcp
+    m_Hit->SetPixelId(touch->GetCopyNumber(0));
+    m_Hit->SetMcpId(touch->GetCopyNumber(1));
+    break;
+  case 10:  // wMcp
+    m_Hit->SetMcpId(touch->GetCopyNumber(0));
+    if (m_Detector->GetMcpReadout() == 1)
+    {
+      const G4AffineTransform& transform = touch->GetHistory()->GetTopTransform();
+      G4ThreeVector localpos = transform.TransformPoint(point->GetPosition());
+      G4ThreeVector localdir = transform.TransformAxis(point->GetMomentumDirection());
+      m_Hit->SetPixelId(m_Detector->GetPixelId(localpos, localdir));
+    }
+    break;
+  default:
+    break;
+  }
+}
+
 //____________________________________________________________________________..
 void G4EicDircSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -9,6 +9,7 @@
 #include <vector>
 
 class G4Step;
+class G4StepPoint;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class G4EicDircDetector;
@@ -46,6 +47,9 @@ class G4EicDircSteppingAction : public PHG4SteppingAction
   //std::vector<TVector3> vector_hit_pos_bar;
 
  private:
+  //! set MCP and pixel id of the current hit if the step point is in an MCP or pixel
+  void SetReadoutIds(const G4StepPoint* point);
+
   //! pointer to the detector
   G4EicDircDetector* m_Detector = nullptr;
   const PHParameters* m_Params;
@@ -53,8 +57,7 @@ class G4EicDircSteppingAction : public PHG4SteppingAction
   PHG4HitContainer* m_HitContainer = nullptr;
   PHG4HitContainer* m_AbsorberHitContainer = nullptr;
   PHG4HitContainer* m_SupportHitContainer = nullptr;
-  PHG4Hit* m_Hit = nullptr;
-  //  PrtHit* m_Hit = nullptr;
+  PrtHit* m_Hit = nullptr;
   //PHG4HitContainer* m_SaveHitContainer = nullptr;
 
   G4VPhysicalVolume* m_SaveVolPre = nullptr;
@@ -50,6 +50,7 @@ int G4EicDircSubsystem::InitRunSubsystem(PHCompositeNode *topNode)
   PHNodeIterator iter(topNode);
   PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
   //DircBoundary = new G4EicDircOpBoundaryProcess();
+  //DircBoundary->SetDetector(m_Detector); // after m_Detector is created below
   // G4EicDircDisplayAction *disp_action = new G4EicDircDisplayAction(Name(), GetParams());
   // if (isfinite(m_ColorArray[0]) &&
   //     isfinite(m_ColorArray[1]) &&
@@ -195,6 +196,7 @@ void G4EicDircSubsystem::SetDefaultParameters()
   set_default_int_param("MCP_columns", 4);
   set_default_int_param("NBoxes", 12);
   set_default_int_param("Bar_pieces", 4);
+  set_default_int_param("MCP_readout", 1);  // 0-pixel placements, 1-pixel from local hit position
 
   set_default_int_param("disable_photon_sim", 0);  // if true, disable photon simulations
 
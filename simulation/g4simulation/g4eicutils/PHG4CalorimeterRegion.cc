@@ -0,0 +1,108 @@
+#include "PHG4CalorimeterRegion.h"
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <Geant4/G4ApplicationState.hh>
+#include <Geant4/G4FastSimulationPhysics.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4ProductionCuts.hh>
+#include <Geant4/G4Region.hh>
+#include <Geant4/G4RegionStore.hh>
+#include <Geant4/G4RunManagerKernel.hh>
+#include <Geant4/G4StateManager.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4VModularPhysicsList.hh>
+
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <set>
+#include <utility>  // for pair
+
+namespace
+{
+  const char *fastsim_physics_name = "PHG4CalorimeterFastSim";
+
+  G4FastSimulationPhysics *fastsim_physics = nullptr;
+
+  const std::pair<std::string, G4ProductionCutsIndex> cutnames[] = {
+      {"region_cut_gamma", idxG4GammaCut},
+      {"region_cut_electron", idxG4ElectronCut},
+      {"region_cut_positron", idxG4PositronCut},
+      {"region_cut_proton", idxG4ProtonCut}};
+}  // namespace
+
+G4Region *PHG4CalorimeterRegion::Create(const std::string &name, const PHParameters *params)
+{
+  G4Region *region = new G4Region("REGION_" + name);
+  // without own production cuts G4 gives the region the world default ones,
+  // so only create them if something is overridden
+  G4ProductionCuts *gcuts = nullptr;
+  for (const auto &cut : cutnames)
+  {
+    const double value = params->get_double_param(cut.first);
+    if (value <= 0)
+    {
+      continue;
+    }
+    if (!gcuts)
+    {
+      const G4RegionStore *theRegionStore = G4RegionStore::GetInstance();
+      gcuts = new G4ProductionCuts(*(theRegionStore->GetRegion("DefaultRegionForTheWorld")->GetProductionCuts()));
+      region->SetProductionCuts(gcuts);
+    }
+    gcuts->SetProductionCut(value * cm, cut.second);
+  }
+  return region;
+}
+
+const std::map<std::string, double> &PHG4CalorimeterRegion::DefaultParameters()
+{
+  static std::map<std::string, double> defaults;
+  if (defaults.empty())
+  {
+    for (const auto &cut : cutnames)
+    {
+      defaults[cut.first] = -1.;
+    }
+  }
+  return defaults;
+}
+
+void PHG4CalorimeterRegion::RegisterFastSimulationPhysics()
+{
+  if (fastsim_physics)
+  {
+    return;
+  }
+  G4RunManagerKernel *kernel = G4RunManagerKernel::GetRunManagerKernel();
+  G4VModularPhysicsList *physicslist = kernel ? dynamic_cast<G4VModularPhysicsList *>(kernel->GetPhysicsList()) : nullptr;
+  if (!physicslist || G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit)
+  {
+    std::cout << PHWHERE << " the fast simulation has to be added to a modular physics list before the run manager is initialized" << std::endl;
+    exit(1);
+  }
+  fastsim_physics = new G4FastSimulationPhysics(fastsim_physics_name);
+  physicslist->RegisterPhysics(fastsim_physics);
+}
+
+void PHG4CalorimeterRegion::ActivateFastSimulation(const std::vector<G4ParticleDefinition *> &particles)
+{
+  const G4ApplicationState state = G4StateManager::GetStateManager()->GetCurrentState();
+  if (!fastsim_physics || (state != G4State_PreInit && state != G4State_Init))
+  {
+    std::cout << PHWHERE << " fast simulation requested after the physics was constructed"
+              << " or without PHG4CalorimeterRegion::RegisterFastSimulationPhysics()" << std::endl;
+    exit(1);
+  }
+  // G4FastSimulationPhysics does not check for particles which were already added
+  static std::set<std::string> activated;
+  for (G4ParticleDefinition *particle : particles)
+  {
+    if (activated.insert(particle->GetParticleName()).second)
+    {
+      fastsim_physics->ActivateFastSimulation(particle->GetParticleName());
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef G4EICUTILS_PHG4CALORIMETERREGION_H
+#define G4EICUTILS_PHG4CALORIMETERREGION_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+class G4ParticleDefinition;
+class G4Region;
+class PHParameters;
+
+namespace PHG4CalorimeterRegion
+{
+  //! create the G4Region "REGION_<name>" of a calorimeter. The range cuts are
+  //! taken from the double parameters region_cut_gamma, region_cut_electron,
+  //! region_cut_positron and region_cut_proton (cm), values <= 0 keep the
+  //! world default. The caller adds the root logical volume(s)
+  G4Region *Create(const std::string &name, const PHParameters *params);
+
+  //! defaults of the parameters read by Create, for SetDefaultParameters() of
+  //! the subsystems (the range cuts are -1, i.e. the world default)
+  const std::map<std::string, double> &DefaultParameters();
+
+  //! add G4FastSimulationPhysics to the physics list, it is shared by all
+  //! regions and only registered once. The physics list only takes new
+  //! constructors before the run manager is initialized, i.e. call it from
+  //! InitRunSubsystem() of a subsystem whose detector creates a fast model
+  void RegisterFastSimulationPhysics();
+
+  //! set up the fast simulation process for the given particles together
+  //! with the rest of the physics. Called by the fast models when they are
+  //! created in ConstructMe(), after RegisterFastSimulationPhysics() and
+  //! before the physics is constructed
+  void ActivateFastSimulation(const std::vector<G4ParticleDefinition *> &particles);
+}  // namespace PHG4CalorimeterRegion
+
+#endif
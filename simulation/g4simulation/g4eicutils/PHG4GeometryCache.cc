@@ -0,0 +1,845 @@
+#include "PHG4GeometryCache.h"
+
+#include <Geant4/G4AffineTransform.hh>
+#include <Geant4/G4BooleanSolid.hh>
+#include <Geant4/G4Box.hh>
+#include <Geant4/G4Cons.hh>
+#include <Geant4/G4DisplacedSolid.hh>
+#include <Geant4/G4Element.hh>
+#include <Geant4/G4EllipticalTube.hh>
+#include <Geant4/G4IntersectionSolid.hh>
+#include <Geant4/G4IonisParamMat.hh>
+#include <Geant4/G4Isotope.hh>
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Polycone.hh>
+#include <Geant4/G4Polyhedra.hh>
+#include <Geant4/G4RotationMatrix.hh>
+#include <Geant4/G4Sphere.hh>
+#include <Geant4/G4SubtractionSolid.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Torus.hh>
+#include <Geant4/G4Transform3D.hh>
+#include <Geant4/G4Trap.hh>
+#include <Geant4/G4Trd.hh>
+#include <Geant4/G4Tubs.hh>
+#include <Geant4/G4UnionSolid.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+#include <Geant4/G4VSolid.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>  // for std::rename
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <regex>
+#include <set>
+
+namespace
+{
+  const char cache_magic[8] = {'P', 'H', 'G', '4', 'G', 'E', 'O', 'C'};
+  const uint32_t cache_version = 1;
+
+  // generic records, the meaning of the numbers depends on the type
+  struct Record
+  {
+    std::string type;
+    std::string name;
+    std::vector<double> par;
+    std::vector<int> ref;
+  };
+
+  struct Daughter
+  {
+    std::string name;
+    int copy = 0;
+    int logvol = 0;
+    double rot[9] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    double pos[3] = {0, 0, 0};
+    int tag = 0;
+  };
+
+  struct LogicalRecord
+  {
+    std::string name;
+    int solid = 0;
+    int material = 0;
+    std::vector<Daughter> daughters;
+  };
+
+  struct Tables
+  {
+    std::vector<Record> isotopes;
+    std::vector<Record> elements;
+    std::vector<Record> materials;
+    std::vector<Record> solids;
+    std::vector<LogicalRecord> logvols;
+    std::vector<Daughter> top;
+  };
+
+  //_______________________________________________________________
+  class Writer
+  {
+   public:
+    explicit Writer(std::ostream &out)
+      : m_Out(out)
+    {
+    }
+    template <class T>
+    void Value(const T &value)
+    {
+      m_Out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+    void String(const std::string &s)
+    {
+      Value<uint32_t>(s.size());
+      m_Out.write(s.data(), s.size());
+    }
+    template <class T>
+    void Vector(const std::vector<T> &v)
+    {
+      Value<uint32_t>(v.size());
+      for (const T &value : v)
+      {
+        Value(value);
+      }
+    }
+    void Records(const std::vector<Record> &records)
+    {
+      Value<uint32_t>(records.size());
+      for (const Record &r : records)
+      {
+        String(r.type);
+        String(r.name);
+        Vector(r.par);
+        Vector(r.ref);
+      }
+    }
+    void Daughters(const std::vector<Daughter> &daughters)
+    {
+      Value<uint32_t>(daughters.size());
+      for (const Daughter &d : daughters)
+      {
+        String(d.name);
+        Value(d.copy);
+        Value(d.logvol);
+        Value(d.rot);
+        Value(d.pos);
+        Value(d.tag);
+      }
+    }
+
+   private:
+    std::ostream &m_Out;
+  };
+
+  //_______________________________________________________________
+  class Reader
+  {
+   public:
+    explicit Reader(std::istream &in)
+      : m_In(in)
+    {
+    }
+    template <class T>
+    void Value(T &value)
+    {
+      m_In.read(reinterpret_cast<char *>(&value), sizeof(T));
+    }
+    // sizes are checked against a sane maximum to survive a corrupt file
+    bool Size(uint32_t &size)
+    {
+      Value(size);
+      return m_In.good() && size < 100000000;
+    }
+    bool String(std::string &s)
+    {
+      uint32_t size;
+      if (!Size(size))
+      {
+        return false;
+      }
+      s.resize(size);
+      m_In.read(&s[0], size);
+      return m_In.good();
+    }
+    template <class T>
+    bool Vector(std::vector<T> &v)
+    {
+      uint32_t size;
+      if (!Size(size))
+      {
+        return false;
+      }
+      v.resize(size);
+      for (T &value : v)
+      {
+        Value(value);
+      }
+      return m_In.good();
+    }
+    bool Records(std::vector<Record> &records)
+    {
+      uint32_t size;
+      if (!Size(size))
+      {
+        return false;
+      }
+      records.resize(size);
+      for (Record &r : records)
+      {
+        if (!String(r.type) || !String(r.name) || !Vector(r.par) || !Vector(r.ref))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    bool Daughters(std::vector<Daughter> &daughters)
+    {
+      uint32_t size;
+      if (!Size(size))
+      {
+        return false;
+      }
+      daughters.resize(size);
+      for (Daughter &d : daughters)
+      {
+        if (!String(d.name))
+        {
+          return false;
+        }
+        Value(d.copy);
+        Value(d.logvol);
+        Value(d.rot);
+        Value(d.pos);
+        Value(d.tag);
+      }
+      return m_In.good();
+    }
+
+   private:
+    std::istream &m_In;
+  };
+
+  //_______________________________________________________________
+  // flattens the volume trees into tables, everything is added after the
+  // objects it refers to so the tables can be rebuilt front to back
+  class Flattener
+  {
+   public:
+    explicit Flattener(Tables &tables)
+      : m_Tables(tables)
+    {
+    }
+
+    void Top(const G4VPhysicalVolume *physvol, const int tag)
+    {
+      Daughter d;
+      if (MakeDaughter(physvol, d))
+      {
+        d.tag = tag;
+        m_Tables.top.push_back(d);
+      }
+    }
+
+    std::string error;
+
+   private:
+    bool MakeDaughter(const G4VPhysicalVolume *physvol, Daughter &d)
+    {
+      if (!dynamic_cast<const G4PVPlacement *>(physvol) || physvol->IsReplicated())
+      {
+        error = "physical volume " + physvol->GetName() + " is not a simple placement";
+        return false;
+      }
+      d.name = physvol->GetName();
+      d.copy = physvol->GetCopyNo();
+      d.logvol = AddLogical(physvol->GetLogicalVolume());
+      const G4RotationMatrix rot = physvol->GetObjectRotationValue();
+      const G4ThreeVector pos = physvol->GetObjectTranslation();
+      const double rotval[9] = {rot.xx(), rot.xy(), rot.xz(), rot.yx(), rot.yy(), rot.yz(), rot.zx(), rot.zy(), rot.zz()};
+      std::copy(rotval, rotval + 9, d.rot);
+      for (int i = 0; i < 3; i++)
+      {
+        d.pos[i] = pos[i];
+      }
+      return d.logvol >= 0;
+    }
+
+    int AddLogical(G4LogicalVolume *logvol)
+    {
+      auto iter = m_Logical.find(logvol);
+      if (iter != m_Logical.end())
+      {
+        return iter->second;
+      }
+      LogicalRecord lr;
+      lr.name = logvol->GetName();
+      lr.solid = AddSolid(logvol->GetSolid());
+      lr.material = AddMaterial(logvol->GetMaterial());
+      if (lr.solid < 0 || lr.material < 0)
+      {
+        return -1;
+      }
+      for (int i = 0; i < (int) logvol->GetNoDaughters(); i++)
+      {
+        Daughter d;
+        if (!MakeDaughter(logvol->GetDaughter(i), d))
+        {
+          return -1;
+        }
+        lr.daughters.push_back(d);
+      }
+      m_Tables.logvols.push_back(lr);
+      return m_Logical[logvol] = m_Tables.logvols.size() - 1;
+    }
+
+    int AddSolid(const G4VSolid *solid)
+    {
+      auto iter = m_Solid.find(solid);
+      if (iter != m_Solid.end())
+      {
+        return iter->second;
+      }
+      Record r;
+      r.type = solid->GetEntityType();
+      r.name = solid->GetName();
+      if (const G4Box *box = dynamic_cast<const G4Box *>(solid))
+      {
+        r.par = {box->GetXHalfLength(), box->GetYHalfLength(), box->GetZHalfLength()};
+      }
+      else if (const G4Tubs *tubs = dynamic_cast<const G4Tubs *>(solid))
+      {
+        r.par = {tubs->GetInnerRadius(), tubs->GetOuterRadius(), tubs->GetZHalfLength(),
+                 tubs->GetStartPhiAngle(), tubs->GetDeltaPhiAngle()};
+      }
+      else if (const G4Cons *cons = dynamic_cast<const G4Cons *>(solid))
+      {
+        r.par = {cons->GetInnerRadiusMinusZ(), cons->GetOuterRadiusMinusZ(),
+                 cons->GetInnerRadiusPlusZ(), cons->GetOuterRadiusPlusZ(),
+                 cons->GetZHalfLength(), cons->GetStartPhiAngle(), cons->GetDeltaPhiAngle()};
+      }
+      else if (const G4Trd *trd = dynamic_cast<const G4Trd *>(solid))
+      {
+        r.par = {trd->GetXHalfLength1(), trd->GetXHalfLength2(), trd->GetYHalfLength1(),
+                 trd->GetYHalfLength2(), trd->GetZHalfLength()};
+      }
+      else if (const G4Trap *trap = dynamic_cast<const G4Trap *>(solid))
+      {
+        const G4ThreeVector axis = trap->GetSymAxis();
+        r.par = {trap->GetZHalfLength(), axis.theta(), axis.phi(),
+                 trap->GetYHalfLength1(), trap->GetXHalfLength1(), trap->GetXHalfLength2(), std::atan(trap->GetTanAlpha1()),
+                 trap->GetYHalfLength2(), trap->GetXHalfLength3(), trap->GetXHalfLength4(), std::atan(trap->GetTanAlpha2())};
+      }
+      else if (const G4Sphere *sphere = dynamic_cast<const G4Sphere *>(solid))
+      {
+        r.par = {sphere->GetInnerRadius(), sphere->GetOuterRadius(),
+                 sphere->GetStartPhiAngle(), sphere->GetDeltaPhiAngle(),
+                 sphere->GetStartThetaAngle(), sphere->GetDeltaThetaAngle()};
+      }
+      else if (const G4Torus *torus = dynamic_cast<const G4Torus *>(solid))
+      {
+        r.par = {torus->GetRmin(), torus->GetRmax(), torus->GetRtor(), torus->GetSPhi(), torus->GetDPhi()};
+      }
+      else if (const G4EllipticalTube *etube = dynamic_cast<const G4EllipticalTube *>(solid))
+      {
+        r.par = {etube->GetDx(), etube->GetDy(), etube->GetDz()};
+      }
+      else if (const G4Polycone *pcon = dynamic_cast<const G4Polycone *>(solid))
+      {
+        const G4PolyconeHistorical *h = pcon->GetOriginalParameters();
+        r.par = {h->Start_angle, h->Opening_angle};
+        for (int i = 0; i < h->Num_z_planes; i++)
+        {
+          r.par.insert(r.par.end(), {h->Z_values[i], h->Rmin[i], h->Rmax[i]});
+        }
+      }
+      else if (const G4Polyhedra *phed = dynamic_cast<const G4Polyhedra *>(solid))
+      {
+        const G4PolyhedraHistorical *h = phed->GetOriginalParameters();
+        // the original radii are stored at the corners, the constructor wants
+        // them at the middle of the sides
+        const double convert = std::cos(0.5 * h->Opening_angle / h->numSide);
+        r.par = {h->Start_angle, h->Opening_angle, (double) h->numSide};
+        for (int i = 0; i < h->Num_z_planes; i++)
+        {
+          r.par.insert(r.par.end(), {h->Z_values[i], h->Rmin[i] * convert, h->Rmax[i] * convert});
+        }
+      }
+      else if (const G4DisplacedSolid *disp = dynamic_cast<const G4DisplacedSolid *>(solid))
+      {
+        const G4AffineTransform transform = disp->GetDirectTransform();
+        const G4RotationMatrix rot = transform.NetRotation();
+        const G4ThreeVector pos = transform.NetTranslation();
+        r.par = {rot.xx(), rot.xy(), rot.xz(), rot.yx(), rot.yy(), rot.yz(), rot.zx(), rot.zy(), rot.zz(),
+                 pos.x(), pos.y(), pos.z()};
+        r.ref = {AddSolid(disp->GetConstituentMovedSolid())};
+      }
+      else if (const G4BooleanSolid *boolean = dynamic_cast<const G4BooleanSolid *>(solid))
+      {
+        r.ref = {AddSolid(boolean->GetConstituentSolid(0)), AddSolid(boolean->GetConstituentSolid(1))};
+      }
+      else
+      {
+        error = "solid " + r.name + " of type " + r.type + " is not supported";
+        return -1;
+      }
+      // exact type match, derived classes of the supported solids are not
+      static const std::set<std::string> supported = {"G4Box", "G4Tubs", "G4Cons", "G4Trd", "G4Trap", "G4Sphere", "G4Torus",
+                                                      "G4EllipticalTube", "G4Polycone", "G4Polyhedra", "G4DisplacedSolid",
+                                                      "G4UnionSolid", "G4SubtractionSolid", "G4IntersectionSolid"};
+      if (!supported.count(r.type))
+      {
+        error = "solid " + r.name + " of type " + r.type + " is not supported";
+        return -1;
+      }
+      for (int ref : r.ref)
+      {
+        if (ref < 0)
+        {
+          return -1;
+        }
+      }
+      m_Tables.solids.push_back(r);
+      return m_Solid[solid] = m_Tables.solids.size() - 1;
+    }
+
+    int AddMaterial(const G4Material *material)
+    {
+      auto iter = m_Material.find(material);
+      if (iter != m_Material.end())
+      {
+        return iter->second;
+      }
+      if (material->GetMaterialPropertiesTable())
+      {
+        error = "material " + material->GetName() + " has optical properties";
+        return -1;
+      }
+      Record r;
+      r.type = "G4Material";
+      r.name = material->GetName();
+      r.par = {material->GetDensity(), (double) material->GetState(), material->GetTemperature(),
+               material->GetPressure(), material->GetIonisation()->GetMeanExcitationEnergy()};
+      const double *fractions = material->GetFractionVector();
+      for (int i = 0; i < (int) material->GetNumberOfElements(); i++)
+      {
+        r.ref.push_back(AddElement(material->GetElement(i)));
+        r.par.push_back(fractions[i]);
+      }
+      m_Tables.materials.push_back(r);
+      return m_Material[material] = m_Tables.materials.size() - 1;
+    }
+
+    int AddElement(const G4Element *element)
+    {
+      auto iter = m_Element.find(element);
+      if (iter != m_Element.end())
+      {
+        return iter->second;
+      }
+      Record r;
+      r.type = element->GetSymbol();
+      r.name = element->GetName();
+      const double *abundances = element->GetRelativeAbundanceVector();
+      for (int i = 0; i < (int) element->GetNumberOfIsotopes(); i++)
+      {
+        r.ref.push_back(AddIsotope(element->GetIsotope(i)));
+        r.par.push_back(abundances[i]);
+      }
+      m_Tables.elements.push_back(r);
+      return m_Element[element] = m_Tables.elements.size() - 1;
+    }
+
+    int AddIsotope(const G4Isotope *isotope)
+    {
+      auto iter = m_Isotope.find(isotope);
+      if (iter != m_Isotope.end())
+      {
+        return iter->second;
+      }
+      Record r;
+      r.type = "G4Isotope";
+      r.name = isotope->GetName();
+      r.par = {(double) isotope->GetZ(), (double) isotope->GetN(), isotope->GetA(), (double) isotope->Getm()};
+      m_Tables.isotopes.push_back(r);
+      return m_Isotope[isotope] = m_Tables.isotopes.size() - 1;
+    }
+
+    Tables &m_Tables;
+    std::map<const G4LogicalVolume *, int> m_Logical;
+    std::map<const G4VSolid *, int> m_Solid;
+    std::map<const G4Material *, int> m_Material;
+    std::map<const G4Element *, int> m_Element;
+    std::map<const G4Isotope *, int> m_Isotope;
+  };
+
+  //_______________________________________________________________
+  G4Transform3D MakeTransform(const double rot[9], const double pos[3])
+  {
+    CLHEP::HepRep3x3 rep(rot[0], rot[1], rot[2], rot[3], rot[4], rot[5], rot[6], rot[7], rot[8]);
+    return G4Transform3D(G4RotationMatrix(rep), G4ThreeVector(pos[0], pos[1], pos[2]));
+  }
+
+  G4VSolid *MakeSolid(const Record &r, const std::vector<G4VSolid *> &solids)
+  {
+    const std::vector<double> &p = r.par;
+    if (r.type == "G4Box")
+    {
+      return new G4Box(r.name, p[0], p[1], p[2]);
+    }
+    if (r.type == "G4Tubs")
+    {
+      return new G4Tubs(r.name, p[0], p[1], p[2], p[3], p[4]);
+    }
+    if (r.type == "G4Cons")
+    {
+      return new G4Cons(r.name, p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+    }
+    if (r.type == "G4Trd")
+    {
+      return new G4Trd(r.name, p[0], p[1], p[2], p[3], p[4]);
+    }
+    if (r.type == "G4Trap")
+    {
+      return new G4Trap(r.name, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10]);
+    }
+    if (r.type == "G4Sphere")
+    {
+      return new G4Sphere(r.name, p[0], p[1], p[2], p[3], p[4], p[5]);
+    }
+    if (r.type == "G4Torus")
+    {
+      return new G4Torus(r.name, p[0], p[1], p[2], p[3], p[4]);
+    }
+    if (r.type == "G4EllipticalTube")
+    {
+      return new G4EllipticalTube(r.name, p[0], p[1], p[2]);
+    }
+    if (r.type == "G4Polycone" || r.type == "G4Polyhedra")
+    {
+      const int first = (r.type == "G4Polycone") ? 2 : 3;
+      const int nz = (p.size() - first) / 3;
+      std::vector<double> z(nz), rmin(nz), rmax(nz);
+      for (int i = 0; i < nz; i++)
+      {
+        z[i] = p[first + 3 * i];
+        rmin[i] = p[first + 3 * i + 1];
+        rmax[i] = p[first + 3 * i + 2];
+      }
+      if (first == 2)
+      {
+        return new G4Polycone(r.name, p[0], p[1], nz, z.data(), rmin.data(), rmax.data());
+      }
+      return new G4Polyhedra(r.name, p[0], p[1], std::lround(p[2]), nz, z.data(), rmin.data(), rmax.data());
+    }
+    if (r.type == "G4DisplacedSolid")
+    {
+      const G4Transform3D transform = MakeTransform(&p[0], &p[9]);
+      return new G4DisplacedSolid(r.name, solids[r.ref[0]], G4AffineTransform(transform.getRotation(), transform.getTranslation()));
+    }
+    if (r.type == "G4UnionSolid")
+    {
+      return new G4UnionSolid(r.name, solids[r.ref[0]], solids[r.ref[1]]);
+    }
+    if (r.type == "G4SubtractionSolid")
+    {
+      return new G4SubtractionSolid(r.name, solids[r.ref[0]], solids[r.ref[1]]);
+    }
+    if (r.type == "G4IntersectionSolid")
+    {
+      return new G4IntersectionSolid(r.name, solids[r.ref[0]], solids[r.ref[1]]);
+    }
+    return nullptr;
+  }
+
+  // references must point to entries which are already built
+  bool CheckRefs(const std::vector<Record> &records, const size_t nref, const bool self)
+  {
+    for (size_t i = 0; i < records.size(); i++)
+    {
+      for (int ref : records[i].ref)
+      {
+        if (ref < 0 || (size_t) ref >= (self ? i : nref))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /*!
+   * files read by the parsers together with filename:
+   *  - GDML external entities <!ENTITY name SYSTEM "file">, relative to
+   *    the including file
+   *  - GDML modules <file name="file"/>, relative to the working directory
+   *  - G4tgb includes :INCL file, relative to the working directory
+   */
+  void IncludedFiles(const std::string &filename, const std::string &contents, std::vector<std::string> &files)
+  {
+    static const std::regex entity("<!ENTITY\\s+(?:%\\s+)?[^\\s]+\\s+SYSTEM\\s+[\"']([^\"']+)[\"']");
+    static const std::regex module("<file\\s+name\\s*=\\s*[\"']([^\"']+)[\"']");
+    static const std::regex include("(?:^|\\n)[ \\t]*:INCL[A-Z]*[ \\t]+[\"']?([^\\s\"']+)");
+    const size_t slash = filename.rfind('/');
+    const std::string dir = (slash == std::string::npos) ? std::string() : filename.substr(0, slash + 1);
+    for (std::sregex_iterator iter(contents.begin(), contents.end(), entity); iter != std::sregex_iterator(); ++iter)
+    {
+      const std::string file = (*iter)[1];
+      files.push_back(file[0] == '/' ? file : dir + file);
+    }
+    for (const std::regex *re : {&module, &include})
+    {
+      for (std::sregex_iterator iter(contents.begin(), contents.end(), *re); iter != std::sregex_iterator(); ++iter)
+      {
+        files.push_back((*iter)[1]);
+      }
+    }
+  }
+}  // namespace
+
+//_______________________________________________________________
+PHG4GeometryCache::PHG4GeometryCache(const std::string &cachefile)
+  : m_CacheFile(cachefile)
+  // FNV-1a offset basis
+  , m_Hash(14695981039346656037ULL)
+{
+  Hash(reinterpret_cast<const char *>(&cache_version), sizeof(cache_version));
+}
+
+//_______________________________________________________________
+void PHG4GeometryCache::Hash(const char *data, const size_t size)
+{
+  for (size_t i = 0; i < size; i++)
+  {
+    m_Hash ^= (unsigned char) data[i];
+    m_Hash *= 1099511628211ULL;
+  }
+}
+
+//_______________________________________________________________
+void PHG4GeometryCache::AddSourceFile(const std::string &filename)
+{
+  // the file and everything it pulls in, every file is hashed once
+  std::set<std::string> visited;
+  std::vector<std::string> files(1, filename);
+  while (!files.empty())
+  {
+    const std::string file = files.back();
+    files.pop_back();
+    if (!visited.insert(file).second)
+    {
+      continue;
+    }
+    AddKey(file);
+    std::ifstream in(file, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Hash(contents.data(), contents.size());
+    IncludedFiles(file, contents, files);
+  }
+}
+
+//_______________________________________________________________
+void PHG4GeometryCache::AddKey(const std::string &key)
+{
+  // include the terminating 0 so that "ab"+"c" differs from "a"+"bc"
+  Hash(key.c_str(), key.size() + 1);
+}
+
+//_______________________________________________________________
+bool PHG4GeometryCache::Load(G4LogicalVolume *mother, std::vector<Placement> &placed)
+{
+  std::ifstream in(m_CacheFile, std::ios::binary);
+  if (!in.is_open())
+  {
+    return false;
+  }
+  Reader reader(in);
+  char magic[8];
+  uint32_t version = 0;
+  uint64_t hash = 0;
+  reader.Value(magic);
+  reader.Value(version);
+  reader.Value(hash);
+  if (!in.good() || !std::equal(magic, magic + 8, cache_magic) || version != cache_version || hash != m_Hash)
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << "PHG4GeometryCache: " << m_CacheFile << " is outdated" << std::endl;
+    }
+    return false;
+  }
+
+  // read and check everything before anything gets built
+  Tables t;
+  bool ok = reader.Records(t.isotopes) && reader.Records(t.elements) && reader.Records(t.materials) && reader.Records(t.solids);
+  uint32_t nlogvols = 0;
+  ok = ok && reader.Size(nlogvols);
+  if (ok)
+  {
+    t.logvols.resize(nlogvols);
+    for (LogicalRecord &lr : t.logvols)
+    {
+      reader.Value(lr.solid);
+      reader.Value(lr.material);
+      ok = ok && reader.String(lr.name) && reader.Daughters(lr.daughters);
+    }
+  }
+  ok = ok && reader.Daughters(t.top);
+  ok = ok && CheckRefs(t.elements, t.isotopes.size(), false) && CheckRefs(t.materials, t.elements.size(), false) && CheckRefs(t.solids, 0, true);
+  for (size_t i = 0; ok && i < t.logvols.size(); i++)
+  {
+    const LogicalRecord &lr = t.logvols[i];
+    ok = lr.solid >= 0 && lr.solid < (int) t.solids.size() && lr.material >= 0 && lr.material < (int) t.materials.size();
+    for (const Daughter &d : lr.daughters)
+    {
+      ok = ok && d.logvol >= 0 && d.logvol < (int) i;
+    }
+  }
+  for (const Daughter &d : t.top)
+  {
+    ok = ok && d.logvol >= 0 && d.logvol < (int) t.logvols.size();
+  }
+  if (!ok)
+  {
+    std::cout << "PHG4GeometryCache: " << m_CacheFile << " is corrupt, ignoring it" << std::endl;
+    return false;
+  }
+
+  // isotopes, elements and materials which exist already (NIST, other
+  // subsystems) are used as they are, like the parsers do
+  std::vector<G4Isotope *> isotopes;
+  for (const Record &r : t.isotopes)
+  {
+    G4Isotope *isotope = G4Isotope::GetIsotope(r.name, false);
+    if (!isotope)
+    {
+      isotope = new G4Isotope(r.name, std::lround(r.par[0]), std::lround(r.par[1]), r.par[2], std::lround(r.par[3]));
+    }
+    isotopes.push_back(isotope);
+  }
+  std::vector<G4Element *> elements;
+  for (const Record &r : t.elements)
+  {
+    G4Element *element = G4Element::GetElement(r.name, false);
+    if (!element)
+    {
+      element = new G4Element(r.name, r.type, r.ref.size());
+      for (size_t i = 0; i < r.ref.size(); i++)
+      {
+        element->AddIsotope(isotopes[r.ref[i]], r.par[i]);
+      }
+    }
+    elements.push_back(element);
+  }
+  std::vector<G4Material *> materials;
+  for (const Record &r : t.materials)
+  {
+    G4Material *material = G4Material::GetMaterial(r.name, false);
+    if (!material)
+    {
+      material = new G4Material(r.name, r.par[0], r.ref.size(), (G4State) std::lround(r.par[1]), r.par[2], r.par[3]);
+      for (size_t i = 0; i < r.ref.size(); i++)
+      {
+        material->AddElement(elements[r.ref[i]], r.par[5 + i]);
+      }
+      material->GetIonisation()->SetMeanExcitationEnergy(r.par[4]);
+    }
+    materials.push_back(material);
+  }
+  std::vector<G4VSolid *> solids;
+  for (const Record &r : t.solids)
+  {
+    solids.push_back(MakeSolid(r, solids));
+  }
+  std::vector<G4LogicalVolume *> logvols;
+  for (const LogicalRecord &lr : t.logvols)
+  {
+    G4LogicalVolume *logvol = new G4LogicalVolume(solids[lr.solid], materials[lr.material], lr.name);
+    for (const Daughter &d : lr.daughters)
+    {
+      new G4PVPlacement(MakeTransform(d.rot, d.pos), logvols[d.logvol], d.name, logvol, false, d.copy, false);
+    }
+    logvols.push_back(logvol);
+  }
+  for (const Daughter &d : t.top)
+  {
+    G4VPhysicalVolume *physvol = new G4PVPlacement(MakeTransform(d.rot, d.pos), logvols[d.logvol], d.name, mother, false, d.copy, false);
+    placed.push_back(std::make_pair(physvol, d.tag));
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "PHG4GeometryCache: rebuilt " << logvols.size() << " logical volumes, "
+              << solids.size() << " solids and " << materials.size() << " materials from "
+              << m_CacheFile << std::endl;
+  }
+  return true;
+}
+
+//_______________________________________________________________
+bool PHG4GeometryCache::Save(const std::vector<Placement> &placed) const
+{
+  Tables t;
+  Flattener flattener(t);
+  for (const Placement &p : placed)
+  {
+    flattener.Top(p.first, p.second);
+    if (!flattener.error.empty())
+    {
+      std::cout << "PHG4GeometryCache: cannot cache the geometry, " << flattener.error << std::endl;
+      return false;
+    }
+  }
+
+  // write to a temporary file first, a job which dies while writing must not
+  // leave a truncated cache behind
+  const std::string tmpfile = m_CacheFile + ".tmp";
+  {
+    std::ofstream out(tmpfile, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+      std::cout << "PHG4GeometryCache: cannot open " << tmpfile << std::endl;
+      return false;
+    }
+    Writer writer(out);
+    writer.Value(cache_magic);
+    writer.Value(cache_version);
+    writer.Value(m_Hash);
+    writer.Records(t.isotopes);
+    writer.Records(t.elements);
+    writer.Records(t.materials);
+    writer.Records(t.solids);
+    writer.Value<uint32_t>(t.logvols.size());
+    for (const LogicalRecord &lr : t.logvols)
+    {
+      writer.Value(lr.solid);
+      writer.Value(lr.material);
+      writer.String(lr.name);
+      writer.Daughters(lr.daughters);
+    }
+    writer.Daughters(t.top);
+    if (!out.good())
+    {
+      std::cout << "PHG4GeometryCache: error writing " << tmpfile << std::endl;
+      std::remove(tmpfile.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpfile.c_str(), m_CacheFile.c_str()))
+  {
+    std::cout << "PHG4GeometryCache: cannot rename " << tmpfile << " to " << m_CacheFile << std::endl;
+    std::remove(tmpfile.c_str());
+    return false;
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "PHG4GeometryCache: wrote " << t.logvols.size() << " logical volumes, "
+              << t.solids.size() << " solids and " << t.materials.size() << " materials to "
+              << m_CacheFile << std::endl;
+  }
+  return true;
+}
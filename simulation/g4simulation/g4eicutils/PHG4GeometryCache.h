@@ -0,0 +1,61 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICUTILS_PHG4GEOMETRYCACHE_H
+#define G4EICUTILS_PHG4GEOMETRYCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+/*!
+ * \brief binary cache of a volume tree built from a geometry file
+ * (GDML, G4tgb text files)
+ *
+ * The cache file holds the isotopes, elements, materials, solids, logical
+ * volumes and placements below a list of top level placements, each with an
+ * integer tag the detector can use to remember how the volume was made. It
+ * is only used if it was written for the same contents of the source files
+ * and the same keys (e.g. placement parameters). Volume names and copy
+ * numbers are kept, detectors which decide on their active volumes by name
+ * can walk the rebuilt tree like the one from the parser.
+ *
+ * Only G4PVPlacements and the common CSG solids (box, tubs, cons, trd, trap,
+ * sphere, torus, elliptical tube, polycone, polyhedra, boolean and
+ * displaced solids) are supported; materials with optical properties are
+ * not. Save() refuses to write a cache for anything else and the geometry
+ * has to be parsed again on the next run.
+ */
+class PHG4GeometryCache
+{
+ public:
+  //! top level placement and its tag
+  typedef std::pair<G4VPhysicalVolume *, int> Placement;
+
+  explicit PHG4GeometryCache(const std::string &cachefile);
+  ~PHG4GeometryCache() = default;
+
+  //! the cache is invalidated if the contents of this file or of the files it includes change
+  void AddSourceFile(const std::string &filename);
+  //! the cache is invalidated if this key changes
+  void AddKey(const std::string &key);
+
+  //! rebuild the cached volumes inside mother, false if there is no valid cache
+  bool Load(G4LogicalVolume *mother, std::vector<Placement> &placed);
+  //! write the volume trees below the top level placements
+  bool Save(const std::vector<Placement> &placed) const;
+
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+ private:
+  void Hash(const char *data, const size_t size);
+
+  std::string m_CacheFile;
+  uint64_t m_Hash;
+  int m_Verbosity = 0;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include "PHG4TrackKiller.h"
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4ParticleTable.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4Track.hh>
+#include <Geant4/G4TrackStatus.hh>
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <sstream>
+
+PHG4TrackKiller::PHG4TrackKiller(const PHParameters *params)
+  : m_ParticleNames(params->get_string_param("kill_particles"))
+  , m_TimeCut(params->get_double_param("kill_time") * nanosecond)
+  , m_EkinCut(params->get_double_param("kill_ekin") * GeV)
+{
+}
+
+void PHG4TrackKiller::ResolveParticles()
+{
+  std::istringstream names(m_ParticleNames);
+  std::string name;
+  while (std::getline(names, name, ','))
+  {
+    name.erase(0, name.find_first_not_of(' '));
+    name.erase(name.find_last_not_of(' ') + 1);
+    if (name.empty())
+    {
+      continue;
+    }
+    G4ParticleDefinition *particle = G4ParticleTable::GetParticleTable()->FindParticle(name);
+    if (!particle)
+    {
+      std::cout << PHWHERE << " unknown particle " << name << " in kill_particles" << std::endl;
+      exit(1);
+    }
+    m_Pdg.push_back(particle->GetPDGEncoding());
+  }
+  m_Resolved = true;
+}
+
+bool PHG4TrackKiller::ApplyConditions(G4Track *track)
+{
+  if (!m_Resolved)
+  {
+    ResolveParticles();
+  }
+  if (std::find(m_Pdg.begin(), m_Pdg.end(), track->GetParticleDefinition()->GetPDGEncoding()) == m_Pdg.end())
+  {
+    return false;
+  }
+  int condition;
+  if (m_TimeCut > 0 && track->GetGlobalTime() > m_TimeCut)
+  {
+    condition = kTime;
+  }
+  else if (m_EkinCut > 0 && track->GetKineticEnergy() < m_EkinCut)
+  {
+    condition = kEkin;
+  }
+  else
+  {
+    return false;
+  }
+  m_NKilled[condition]++;
+  m_EKilled[condition] += track->GetKineticEnergy() / GeV;
+  track->SetTrackStatus(fStopAndKill);
+  return true;
+}
+
+void PHG4TrackKiller::Print(const std::string &name) const
+{
+  if (m_TimeCut <= 0 && m_EkinCut <= 0)
+  {
+    return;
+  }
+  std::cout << name << ": killed " << m_ParticleNames << std::endl;
+  if (m_TimeCut > 0)
+  {
+    std::cout << "  after " << m_TimeCut / nanosecond << " ns: " << m_NKilled[kTime]
+              << " tracks, " << m_EKilled[kTime] << " GeV" << std::endl;
+  }
+  if (m_EkinCut > 0)
+  {
+    std::cout << "  below " << m_EkinCut / GeV << " GeV: " << m_NKilled[kEkin]
+              << " tracks, " << m_EKilled[kEkin] << " GeV" << std::endl;
+  }
+}
@@ -0,0 +1,62 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4EICUTILS_PHG4TRACKKILLER_H
+#define G4EICUTILS_PHG4TRACKKILLER_H
+
+#include <string>
+#include <vector>
+
+class G4Track;
+class PHParameters;
+
+/*!
+ * \brief kills tracks of selected particle species which are too late or too
+ * slow to contribute to the readout
+ *
+ * Used by the stepping actions for the steps inside their detector. The
+ * conditions are taken from the parameters of the subsystem:
+ *  - kill_particles: comma separated G4 particle names (e.g. "neutron")
+ *  - kill_time: global time (ns) after which they are killed
+ *  - kill_ekin: kinetic energy (GeV) below which they are killed
+ * Values <= 0 disable a condition. The number of killed tracks and their
+ * kinetic energy are counted per condition and printed by Print().
+ */
+class PHG4TrackKiller
+{
+ public:
+  explicit PHG4TrackKiller(const PHParameters *params);
+
+  //! kill the track if one of the conditions is met, returns true if it was killed
+  bool Apply(G4Track *track)
+  {
+    return (m_TimeCut > 0 || m_EkinCut > 0) && ApplyConditions(track);
+  }
+
+  void Print(const std::string &name) const;
+
+ private:
+  enum
+  {
+    kTime = 0,
+    kEkin = 1,
+    kNConditions = 2
+  };
+
+  bool ApplyConditions(G4Track *track);
+
+  //! the particle table is only filled once the physics is constructed,
+  //! the names are looked up at the first step
+  void ResolveParticles();
+
+  std::string m_ParticleNames;
+  std::vector<int> m_Pdg;
+  bool m_Resolved = false;
+
+  double m_TimeCut;
+  double m_EkinCut;
+
+  unsigned long m_NKilled[kNConditions] = {0, 0};
+  double m_EKilled[kNConditions] = {0., 0.};
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "G4JLeicBeamLineMagnetDetector.h"
 #include "G4JLeicBeamLineMagnetDisplayAction.h"
+#include "G4JLeicBeamLineTransportModel.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -20,6 +21,7 @@
 #include <Geant4/G4PVPlacement.hh>
 #include <Geant4/G4PhysicalConstants.hh>
 #include <Geant4/G4QuadrupoleMagField.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>
 #include <Geant4/G4String.hh>  // for G4String
 #include <Geant4/G4SystemOfUnits.hh>
@@ -66,6 +68,17 @@ int G4JLeicBeamLineMagnetDetector::IsInBeamLineMagnet(const G4VPhysicalVolume *v
   return false;
 }
 
+//_______________________________________________________________
+G4ThreeVector G4JLeicBeamLineMagnetDetector::DipoleField() const
+{
+  G4ThreeVector field(params->get_double_param("field_x") * tesla,
+                      params->get_double_param("field_y") * tesla,
+                      params->get_double_param("field_z") * tesla);
+  // magnets can be rotated in y
+  field.rotateY(params->get_double_param("rot_y") * deg);
+  return field;
+}
+
 //_______________________________________________________________
 void G4JLeicBeamLineMagnetDetector::ConstructMe(G4LogicalVolume *logicMother)
 {
@@ -87,11 +100,7 @@ void G4JLeicBeamLineMagnetDetector::ConstructMe(G4LogicalVolume *logicMother)
   string magnettype = params->get_string_param("magtype");
   if (magnettype == "DIPOLE")
   {
-    G4ThreeVector field(params->get_double_param("field_x") * tesla,
-			params->get_double_param("field_y") * tesla,
-			params->get_double_param("field_z") * tesla);
-// magnets can be rotated in y
-    field.rotateY(params->get_double_param("rot_y") * deg);
+    G4ThreeVector field = DipoleField();
     magField = new G4UniformMagField(field);
     if (Verbosity() > 0)
     {
@@ -166,6 +175,25 @@ void G4JLeicBeamLineMagnetDetector::ConstructMe(G4LogicalVolume *logicMother)
   }
   m_DisplayAction->AddVolume(magnet_logic,"FIELDVOLUME");
 
+  /* fast transport through the field volume */
+  if (params->get_int_param("fast_transport"))
+  {
+    G4Region *region = new G4Region("REGION_" + GetName());
+    region->AddRootLogicalVolume(magnet_logic);
+    m_TransportModel = new G4JLeicBeamLineTransportModel(GetName(), region,
+                                                         params->get_double_param("length") * cm,
+                                                         params->get_double_param("inner_radius") * cm);
+    if (magnettype == "DIPOLE")
+    {
+      // the model works in the frame of the magnet
+      m_TransportModel->SetDipoleField(rotm->inverse() * DipoleField());
+    }
+    else if (magnettype == "QUADRUPOLE")
+    {
+      m_TransportModel->SetQuadrupoleGradient(params->get_double_param("fieldgradient") * tesla / meter);
+    }
+  }
+
   /* create magnet physical volume */
 
   magnet_physi = new G4PVPlacement(nullptr, G4ThreeVector(0, 0, 0),
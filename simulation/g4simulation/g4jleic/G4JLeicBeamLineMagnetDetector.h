@@ -5,9 +5,12 @@
 
 #include <g4main/PHG4Detector.h>
 
+#include <Geant4/G4ThreeVector.hh>
+
 #include <string>
 
 class G4JLeicBeamLineMagnetDisplayAction;
+class G4JLeicBeamLineTransportModel;
 class G4LogicalVolume;
 class G4VPhysicalVolume;
 class PHCompositeNode;
@@ -32,13 +35,19 @@ class G4JLeicBeamLineMagnetDetector : public PHG4Detector
   void SuperDetector(const std::string &name) { superdetector = name; }
   const std::string SuperDetector() const { return superdetector; }
   int get_Layer() const { return layer; }
+  //! fast transport through the field volume, nullptr if fast_transport is not set
+  G4JLeicBeamLineTransportModel *GetTransportModel() const { return m_TransportModel; }
 
  private:
+  //! uniform field of a DIPOLE in the global frame, used by the field and the fast transport
+  G4ThreeVector DipoleField() const;
+
   PHParameters *params;
 
   G4VPhysicalVolume *magnet_physi;
   G4VPhysicalVolume *magnet_iron_physi;
   G4JLeicBeamLineMagnetDisplayAction *m_DisplayAction;
+  G4JLeicBeamLineTransportModel *m_TransportModel = nullptr;
 
   int layer;
   std::string superdetector;
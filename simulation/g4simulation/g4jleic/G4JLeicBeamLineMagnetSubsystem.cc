@@ -2,6 +2,9 @@
 #include "G4JLeicBeamLineMagnetDetector.h"
 #include "G4JLeicBeamLineMagnetDisplayAction.h"
 #include "G4JLeicBeamLineMagnetSteppingAction.h"
+#include "G4JLeicBeamLineTransportModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
 
 #include <phparameter/PHParameters.h>
 
@@ -43,6 +46,12 @@ G4JLeicBeamLineMagnetSubsystem::~G4JLeicBeamLineMagnetSubsystem()
 //_______________________________________________________________________
 int G4JLeicBeamLineMagnetSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
 {
+  // the fast transport model of the detector uses the fast simulation physics
+  if (GetParams()->get_int_param("fast_transport"))
+  {
+    PHG4CalorimeterRegion::RegisterFastSimulationPhysics();
+  }
+
     PHNodeIterator iter(topNode);
     PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
     PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
@@ -162,6 +171,9 @@ void G4JLeicBeamLineMagnetSubsystem::SetDefaultParameters()
   set_default_double_param("rot_z", 0.);
   set_default_double_param("inner_radius", 4);
   set_default_double_param("outer_radius", 100);
+
+  // move particles through the field volume with transfer maps
+  set_default_int_param("fast_transport", 0);
 }
 
 void G4JLeicBeamLineMagnetSubsystem::Print(const string& what) const
@@ -179,5 +191,9 @@ void G4JLeicBeamLineMagnetSubsystem::Print(const string& what) const
     return;
   }
   GetParams()->Print();
+  if (m_Detector->GetTransportModel())
+  {
+    m_Detector->GetTransportModel()->Print(Name());
+  }
   return;
 }
@@ -0,0 +1,219 @@
+#include "G4JLeicBeamLineTransportModel.h"
+
+#include <g4eicutils/PHG4CalorimeterRegion.h>
+
+#include <Geant4/G4DynamicParticle.hh>
+#include <Geant4/G4FastStep.hh>
+#include <Geant4/G4FastTrack.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4ParticleTable.hh>
+#include <Geant4/G4PhysicalConstants.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4Track.hh>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  // particles living shorter than this (c*tau) decay on the beamline
+  const double min_decay_length = 1 * km;
+  // entry face tolerance, the fast simulation is triggered at the boundary
+  const double face_tolerance = 1 * micrometer;
+  // points along the trajectory which are checked against the aperture
+  const int aperture_samples = 20;
+
+  // solution of u'' = -k u: u(t) = u0 * c + u0' * s with c' = -k s, s' = c
+  void CosSin(const double k, const double t, double &c, double &s)
+  {
+    if (k > 0)
+    {
+      const double a = std::sqrt(k);
+      c = std::cos(a * t);
+      s = std::sin(a * t) / a;
+    }
+    else if (k < 0)
+    {
+      const double a = std::sqrt(-k);
+      c = std::cosh(a * t);
+      s = std::sinh(a * t) / a;
+    }
+    else
+    {
+      c = 1;
+      s = t;
+    }
+  }
+}  // namespace
+
+G4JLeicBeamLineTransportModel::G4JLeicBeamLineTransportModel(const std::string &name, G4Region *envelope, const G4double length, const G4double radius)
+  : G4VFastSimulationModel(name + "_TransportModel", envelope)
+  , m_HalfLength(length / 2.)
+  , m_Radius(radius)
+{
+  std::vector<G4ParticleDefinition *> particles;
+  G4ParticleTable::G4PTblDicIterator *iter = G4ParticleTable::GetParticleTable()->GetIterator();
+  iter->reset();
+  while ((*iter)())
+  {
+    G4ParticleDefinition *particle = iter->value();
+    if (IsApplicable(*particle))
+    {
+      particles.push_back(particle);
+    }
+  }
+  PHG4CalorimeterRegion::ActivateFastSimulation(particles);
+}
+
+G4bool G4JLeicBeamLineTransportModel::IsApplicable(const G4ParticleDefinition &particle)
+{
+  return particle.GetPDGStable() || particle.GetPDGLifeTime() * c_light > min_decay_length;
+}
+
+G4bool G4JLeicBeamLineTransportModel::ModelTrigger(const G4FastTrack &fastTrack)
+{
+  const G4ThreeVector pos = fastTrack.GetPrimaryTrackLocalPosition();
+  const G4ThreeVector dir = fastTrack.GetPrimaryTrackLocalDirection();
+  if (dir.z() == 0)
+  {
+    return false;
+  }
+  // only particles coming in through an end face, not the ones
+  // produced inside or crossing the aperture
+  const double zentry = (dir.z() > 0) ? -m_HalfLength : m_HalfLength;
+  if (std::fabs(pos.z() - zentry) > face_tolerance)
+  {
+    return false;
+  }
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  const double charge = track->GetDynamicParticle()->GetCharge();
+  const double momentum = track->GetMomentum().mag();
+  bool inside;
+  if (charge == 0 || momentum <= 0)
+  {
+    inside = TransportQuadrupole(pos, dir, 0., -zentry);
+  }
+  else if (m_DipoleField.mag2() > 0)
+  {
+    inside = TransportDipole(pos, dir, charge * c_light * m_DipoleField.mag() / momentum, -zentry);
+  }
+  else
+  {
+    // x'' = -k x with the derivative along z, the sign of pz enters here
+    inside = TransportQuadrupole(pos, dir, charge * c_light * m_Gradient / (momentum * dir.z()), -zentry);
+  }
+  if (!inside)
+  {
+    m_NOutOfAperture++;
+  }
+  return inside;
+}
+
+bool G4JLeicBeamLineTransportModel::TransportDipole(const G4ThreeVector &pos, const G4ThreeVector &dir, const G4double kappa, const G4double zexit)
+{
+  // du/ds = kappa u x b: the component along the field is constant,
+  // the perpendicular one rotates with the path length s
+  const G4ThreeVector b = m_DipoleField.unit();
+  const G4ThreeVector upar = dir.dot(b) * b;
+  const G4ThreeVector uperp = dir - upar;
+  const G4ThreeVector w = uperp.cross(b);
+  auto position = [&](const double s) {
+    const double phi = kappa * s;
+    if (std::fabs(phi) < 1e-9)
+    {
+      return pos + dir * s + w * (phi * s / 2.);
+    }
+    return pos + upar * s + uperp * (std::sin(phi) / kappa) + w * ((1 - std::cos(phi)) / kappa);
+  };
+  auto direction = [&](const double s) {
+    const double phi = kappa * s;
+    return upar + uperp * std::cos(phi) + w * std::sin(phi);
+  };
+
+  // newton iteration for the path length to the exit face
+  double s = (zexit - pos.z()) / dir.z();
+  bool converged = false;
+  for (int i = 0; i < 20; i++)
+  {
+    const double dz = position(s).z() - zexit;
+    if (std::fabs(dz) < 1e-6 * mm)
+    {
+      converged = true;
+      break;
+    }
+    const double uz = direction(s).z();
+    // turns around inside the magnet
+    if (uz * dir.z() <= 0)
+    {
+      return false;
+    }
+    s -= dz / uz;
+  }
+  if (!converged || s <= 0)
+  {
+    return false;
+  }
+  for (int i = 1; i <= aperture_samples; i++)
+  {
+    if (position(s * i / aperture_samples).perp() > m_Radius)
+    {
+      return false;
+    }
+  }
+  m_ExitPosition = position(s);
+  m_ExitPosition.setZ(zexit);
+  m_ExitDirection = direction(s).unit();
+  m_PathLength = s;
+  return true;
+}
+
+bool G4JLeicBeamLineTransportModel::TransportQuadrupole(const G4ThreeVector &pos, const G4ThreeVector &dir, const G4double k, const G4double zexit)
+{
+  // G4QuadrupoleMagField: Bx = G y, By = G x, focusing in x for k > 0
+  const double xp = dir.x() / dir.z();
+  const double yp = dir.y() / dir.z();
+  const double length = zexit - pos.z();
+  G4ThreeVector last = pos;
+  m_PathLength = 0;
+  double cx, sx, cy, sy;
+  for (int i = 1; i <= aperture_samples; i++)
+  {
+    const double t = length * i / aperture_samples;
+    CosSin(k, t, cx, sx);
+    CosSin(-k, t, cy, sy);
+    const G4ThreeVector point(pos.x() * cx + xp * sx, pos.y() * cy + yp * sy, pos.z() + t);
+    if (point.perp() > m_Radius)
+    {
+      return false;
+    }
+    m_PathLength += (point - last).mag();
+    last = point;
+  }
+  m_ExitPosition = last;
+  m_ExitPosition.setZ(zexit);
+  // cx, sx, cy, sy are at the exit face now
+  const double xp_exit = -k * pos.x() * sx + xp * cx;
+  const double yp_exit = k * pos.y() * sy + yp * cy;
+  m_ExitDirection = G4ThreeVector(xp_exit, yp_exit, 1).unit() * ((dir.z() > 0) ? 1 : -1);
+  return true;
+}
+
+void G4JLeicBeamLineTransportModel::DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep)
+{
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  const double dt = m_PathLength / track->GetVelocity();
+  fastStep.ProposePrimaryTrackFinalPosition(m_ExitPosition, true);
+  fastStep.ProposePrimaryTrackFinalMomentumDirection(m_ExitDirection, true);
+  fastStep.ProposePrimaryTrackPathLength(m_PathLength);
+  fastStep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + dt);
+  fastStep.ProposePrimaryTrackFinalProperTime(track->GetProperTime() + dt * track->GetDynamicParticle()->GetMass() / track->GetTotalEnergy());
+  fastStep.ProposeTotalEnergyDeposited(0.);
+  m_NTransported++;
+}
+
+void G4JLeicBeamLineTransportModel::Print(const std::string &name) const
+{
+  std::cout << name << ": transported " << m_NTransported << " particles, "
+            << m_NOutOfAperture << " left the aperture and were tracked by G4" << std::endl;
+}
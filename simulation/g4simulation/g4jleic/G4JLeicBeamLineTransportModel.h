@@ -0,0 +1,70 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4JLEIC_G4JLEICBEAMLINETRANSPORTMODEL_H
+#define G4JLEIC_G4JLEICBEAMLINETRANSPORTMODEL_H
+
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Types.hh>
+#include <Geant4/G4VFastSimulationModel.hh>
+
+#include <string>
+
+class G4FastStep;
+class G4FastTrack;
+class G4ParticleDefinition;
+class G4Region;
+
+/*!
+ * \brief fast transport through the vacuum of a beamline magnet
+ *
+ * Particles entering the field volume through one of its end faces are
+ * moved to the opposite face in one step instead of being stepped through
+ * the field:
+ *  - DIPOLE: uniform field, the helix is calculated exactly
+ *  - QUADRUPOLE: thick lens, first order transfer map in the transverse
+ *    coordinates for the momentum of the particle
+ *  - no field or neutral particles: straight line
+ * The momentum is not changed. If the trajectory leaves the aperture
+ * (inner_radius) inside the magnet the particle is handed to the normal
+ * tracking. Only particles which do not decay on the length of the
+ * beamline are transported, unstable ones need the full simulation.
+ */
+class G4JLeicBeamLineTransportModel : public G4VFastSimulationModel
+{
+ public:
+  //! length and radius of the field volume (G4 units). The particles the model
+  //! applies to get the fast simulation process, the subsystem has to call
+  //! PHG4CalorimeterRegion::RegisterFastSimulationPhysics() first
+  G4JLeicBeamLineTransportModel(const std::string &name, G4Region *envelope, const G4double length, const G4double radius);
+  ~G4JLeicBeamLineTransportModel() override {}
+
+  G4bool IsApplicable(const G4ParticleDefinition &particle) override;
+  G4bool ModelTrigger(const G4FastTrack &fastTrack) override;
+  void DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep) override;
+
+  //! field in the local frame of the magnet
+  void SetDipoleField(const G4ThreeVector &field) { m_DipoleField = field; }
+  //! gradient of a G4QuadrupoleMagField in the frame of the magnet
+  void SetQuadrupoleGradient(const G4double gradient) { m_Gradient = gradient; }
+
+  void Print(const std::string &name) const;
+
+ private:
+  bool TransportDipole(const G4ThreeVector &pos, const G4ThreeVector &dir, const G4double kappa, const G4double zexit);
+  bool TransportQuadrupole(const G4ThreeVector &pos, const G4ThreeVector &dir, const G4double k, const G4double zexit);
+
+  G4double m_HalfLength;
+  G4double m_Radius;
+  G4ThreeVector m_DipoleField;
+  G4double m_Gradient = 0.;
+
+  //! exit point, direction and path length found in ModelTrigger for DoIt
+  G4ThreeVector m_ExitPosition;
+  G4ThreeVector m_ExitDirection;
+  G4double m_PathLength = 0.;
+
+  unsigned long m_NTransported = 0;
+  unsigned long m_NOutOfAperture = 0;
+};
+
+#endif  // G4JLEIC_G4JLEICBEAMLINETRANSPORTMODEL_H
@@ -1,20 +1,25 @@
 #include "G4JLeicVTXDetector.h"
+#include "G4JLeicVTXLadderParameterisation.h"
 
 #include <phparameter/PHParameters.h>
 #include <phparameter/PHParametersContainer.h>
 
 #include <g4main/PHG4Detector.h>  // for PHG4Detector
 
+#include <phool/recoConsts.h>
+
 #include <Geant4/G4Box.hh>
 #include <Geant4/G4Color.hh>
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
+#include <Geant4/G4PVParameterised.hh>
 #include <Geant4/G4PVPlacement.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4String.hh>          // for G4String
 #include <Geant4/G4SystemOfUnits.hh>
 #include <Geant4/G4ThreeVector.hh>  // for G4ThreeVector
 #include <Geant4/G4Transform3D.hh>              // for G4Transform3D
+#include <Geant4/G4Tubs.hh>
 #include <Geant4/G4VisAttributes.hh>
 
 #include <cmath>
@@ -34,6 +39,7 @@ G4JLeicVTXDetector::G4JLeicVTXDetector(PHG4Subsystem *subsys, PHCompositeNode *N
   m_IsActiveFlag = par->get_int_param("active");
   m_IsAbsorberActiveFlag = par->get_int_param("absorberactive");
   m_Layers = par->get_int_param("layers");
+  m_ParameterisedLadders = par->get_int_param("parameterised_ladders");
 }
 
 //_______________________________________________________________
@@ -91,6 +97,11 @@ void G4JLeicVTXDetector::ConstructMe(G4LogicalVolume *logicWorld)
     }
     attr_cb_VTX_ladder->SetForceSolid(true);
     logical->SetVisAttributes(attr_cb_VTX_ladder);
+    if (m_ParameterisedLadders)
+    {
+      ConstructParameterisedLayer(logicWorld, logical, ilayer, NUM, dR);
+      continue;
+    }
     for (int ia = 0; ia < NUM; ia++)
     {
       double phi = (ia * (cb_VTX_ladder_deltaphi));
@@ -98,12 +109,12 @@ void G4JLeicVTXDetector::ConstructMe(G4LogicalVolume *logicWorld)
       double y = -dR * sin(phi);
       G4RotationMatrix rot;
       rot.rotateZ(cb_VTX_ladder_deltaphi * ia);
-      rot.rotateZ(-7. * deg);
+      rot.rotateZ(m_LadderTilt);
       ostringstream physname;
       physname << "cb_VTX_ladder_Phys_" << ilayer << "_" << ia;
       G4VPhysicalVolume *phy = new G4PVPlacement(G4Transform3D(rot, G4ThreeVector(x, y, 0)),
                                                  logical, physname.str(),
-                                                 logicWorld, 0, false, OverlapCheck());
+                                                 logicWorld, 0, ia, OverlapCheck());
       // layer starts at zero but needs to be positive to mark active volume
       m_PhysicalVolumesMap.insert(make_pair(phy, ilayer + 1));
     }
@@ -112,6 +123,30 @@ void G4JLeicVTXDetector::ConstructMe(G4LogicalVolume *logicWorld)
   return;
 }
 
+void G4JLeicVTXDetector::ConstructParameterisedLayer(G4LogicalVolume *logicWorld, G4LogicalVolume *ladder_logic, const int ilayer, const int nladders, const double radius)
+{
+  const PHParameters *par = m_ParamsContainer->GetParameters(ilayer);
+  double cb_VTX_ladder_DZ = par->get_double_param("Dz") * cm;
+  double cb_VTX_ladder_DY = par->get_double_param("Dy") * cm;
+  double cb_VTX_ladder_Thickness = par->get_double_param("Dx") * cm;
+  // the parameterised ladders have to be the only daughters of their mother,
+  // the tube encloses the tilted ladders with a margin of half a ladder thickness
+  double rmin = radius * cos(m_LadderTilt) - cb_VTX_ladder_Thickness;
+  double rmax = hypot(radius * cos(m_LadderTilt) + cb_VTX_ladder_Thickness,
+                      fabs(radius * sin(m_LadderTilt)) + cb_VTX_ladder_DY / 2.);
+  recoConsts *rc = recoConsts::instance();
+  G4VSolid *envelope_solid = new G4Tubs("cb_VTX_layer_Solid_" + to_string(ilayer), rmin, rmax, cb_VTX_ladder_DZ / 2., 0, 2 * M_PI);
+  G4LogicalVolume *envelope_logic = new G4LogicalVolume(envelope_solid, G4Material::GetMaterial(rc->get_StringFlag("WorldMaterial")), "cb_VTX_layer_Logic_" + to_string(ilayer));
+  envelope_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+  new G4PVPlacement(nullptr, G4ThreeVector(0, 0, 0), envelope_logic, "cb_VTX_layer_Phys_" + to_string(ilayer),
+                    logicWorld, false, ilayer, OverlapCheck());
+  G4JLeicVTXLadderParameterisation *ladder_param = new G4JLeicVTXLadderParameterisation(radius, 2 * M_PI / nladders, m_LadderTilt);
+  G4VPhysicalVolume *phy = new G4PVParameterised("cb_VTX_ladder_Phys_" + to_string(ilayer), ladder_logic, envelope_logic,
+                                                 kUndefined, nladders, ladder_param, OverlapCheck());
+  // a single physical volume for all ladders of this layer
+  m_PhysicalVolumesMap.insert(make_pair(phy, ilayer + 1));
+}
+
 void G4JLeicVTXDetector::Print(const std::string &what) const
 {
   cout << "JLeic VTX Detector:" << endl;
@@ -5,6 +5,7 @@
 
 #include <g4main/PHG4Detector.h>
 
+#include <cmath>  // for M_PI
 #include <map>
 #include <string>  // for string
 
@@ -37,9 +38,15 @@ class G4JLeicVTXDetector : public PHG4Detector
   const std::string SuperDetector() const { return m_SuperDetector; }
 
  protected:
+  void ConstructParameterisedLayer(G4LogicalVolume *logicWorld, G4LogicalVolume *ladder_logic, const int ilayer, const int nladders, const double radius);
+
   int m_IsActiveFlag;
   int m_IsAbsorberActiveFlag;
   int m_Layers;
+  //! build each layer from one parameterised ladder instead of individual placements
+  int m_ParameterisedLadders;
+  //! rotation of the ladders with respect to the radial direction
+  double m_LadderTilt = -7. * M_PI / 180.;
   PHParametersContainer *m_ParamsContainer;
   std::map<G4VPhysicalVolume *, int> m_PhysicalVolumesMap;
 
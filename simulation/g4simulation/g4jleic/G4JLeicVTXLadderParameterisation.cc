@@ -0,0 +1,25 @@
+#include "G4JLeicVTXLadderParameterisation.h"
+
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+
+#include <cmath>
+
+G4JLeicVTXLadderParameterisation::G4JLeicVTXLadderParameterisation(const G4double radius, const G4double deltaphi, const G4double tilt)
+  : m_Radius(radius)
+  , m_DeltaPhi(deltaphi)
+  , m_Tilt(tilt)
+{
+}
+
+void G4JLeicVTXLadderParameterisation::ComputeTransformation(const G4int copyNo, G4VPhysicalVolume *physVol) const
+{
+  double phi = copyNo * m_DeltaPhi;
+  physVol->SetTranslation(G4ThreeVector(-m_Radius * cos(phi), -m_Radius * sin(phi), 0));
+  // G4VPhysicalVolume takes the frame rotation, the inverse of the
+  // rotation used for G4PVPlacement(G4Transform3D, ...)
+  m_Rotation = G4RotationMatrix();
+  m_Rotation.rotateZ(phi + m_Tilt);
+  m_Rotation.invert();
+  physVol->SetRotation(&m_Rotation);
+}
@@ -0,0 +1,36 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4JLEIC_G4JLEICVTXLADDERPARAMETERISATION_H
+#define G4JLEIC_G4JLEICVTXLADDERPARAMETERISATION_H
+
+#include <Geant4/G4RotationMatrix.hh>
+#include <Geant4/G4Types.hh>
+#include <Geant4/G4VPVParameterisation.hh>
+
+class G4VPhysicalVolume;
+
+/*!
+ * \brief places the ladders of one vertex tracker layer around the beam
+ * pipe, the copy number is the ladder index in phi
+ *
+ * Same positions and rotations as the individual placements in
+ * G4JLeicVTXDetector::ConstructMe
+ */
+class G4JLeicVTXLadderParameterisation : public G4VPVParameterisation
+{
+ public:
+  G4JLeicVTXLadderParameterisation(const G4double radius, const G4double deltaphi, const G4double tilt);
+
+  virtual ~G4JLeicVTXLadderParameterisation() {}
+
+  virtual void ComputeTransformation(const G4int copyNo, G4VPhysicalVolume *physVol) const;
+
+ private:
+  G4double m_Radius;
+  G4double m_DeltaPhi;
+  G4double m_Tilt;
+  // the physical volume keeps a pointer to the rotation, it is updated for every copy
+  mutable G4RotationMatrix m_Rotation;
+};
+
+#endif  // G4JLEIC_G4JLEICVTXLADDERPARAMETERISATION_H
@@ -129,6 +129,8 @@ bool G4JLeicVTXSteppingAction::UserSteppingAction(const G4Step* aStep, bool was_
       m_Hit = new PHG4Hitv1();
     }
     m_Hit->set_layer(layer_id);
+    // the copy number is the ladder index for placed and parameterised ladders
+    m_Hit->set_ladder_phi_index(touch->GetCopyNumber());
     //here we set the entrance values in cm
     m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
     m_Hit->set_y(0, prePoint->GetPosition().y() / cm);
@@ -173,4 +173,5 @@ void G4JLeicVTXSubsystem::SetDefaultParameters()
   set_default_double_param(-1, "zsize", 5.);
   set_default_int_param(-1, "active", 1);
   set_default_int_param(-1, "absorberactive", 0);
+  set_default_int_param(-1, "parameterised_ladders", 0);
 }
@@ -1,6 +1,7 @@
 #include "AllSiliconTrackerDetector.h"
 
 #include "AllSiliconTrackerDisplayAction.h"
+#include "AllSiliconTrackerSensorGeom.h"
 #include "AllSiliconTrackerSubsystem.h"
 
 #include <phparameter/PHParameters.h>
@@ -10,11 +11,13 @@
 #include <g4main/PHG4Subsystem.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
 #include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
 #include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
 
 #include <TSystem.h>
 
@@ -28,6 +31,8 @@
 #include <Geant4/G4PVPlacement.hh>
 #include <Geant4/G4SolidStore.hh>
 #include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4VSolid.hh>
+#include <Geant4/G4VTouchable.hh>
 #include <Geant4/G4VisAttributes.hh>
 
 #include <boost/algorithm/string.hpp>
@@ -36,8 +41,8 @@
 #include <cmath>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
-class G4VSolid;
 class PHCompositeNode;
 
 using namespace std;
@@ -58,28 +63,79 @@ AllSiliconTrackerDetector::AllSiliconTrackerDetector(PHG4Subsystem *subsys,
 
 //_______________________________________________________________
 int AllSiliconTrackerDetector::IsInDetector(G4VPhysicalVolume *volume) const
+{
+  int detid;
+  return IsInDetector(volume, detid);
+}
+
+//_______________________________________________________________
+int AllSiliconTrackerDetector::IsInDetector(const G4VPhysicalVolume *volume, int &detid) const
+{
+  const unsigned int id = volume->GetInstanceID();
+  if (id >= m_VolumeTable.size())
+  {
+    return 0;
+  }
+  const VolumeInfo &info = m_VolumeTable[id];
+  if ((info.active > 0 && m_Active) || (info.active < 0 && m_AbsorberActive))
+  {
+    detid = info.detid;
+    return info.detid;
+  }
+  return 0;
+}
+
+//_______________________________________________________________
+void AllSiliconTrackerDetector::ConstructMe(G4LogicalVolume *logicWorld)
 {
   if (m_Active)
   {
-    auto iter = m_ActivePhysicalVolumesSet.find(volume);
-    if (iter != m_ActivePhysicalVolumesSet.end())
+    m_SensorGeom = new AllSiliconTrackerSensorGeom();
+  }
+  AllSiliconTrackerSubsystem *mysubsys = dynamic_cast<AllSiliconTrackerSubsystem *>(GetMySubsystem());
+  vector<PHG4GeometryCache::Placement> placed;
+  unique_ptr<PHG4GeometryCache> cache;
+  if (!m_Params->get_string_param("GeometryCache").empty())
+  {
+    // everything the volume tree depends on goes into the key
+    cache.reset(new PHG4GeometryCache(m_Params->get_string_param("GeometryCache")));
+    cache->Verbosity(Verbosity());
+    cache->AddSourceFile(m_GDMPath);
+    for (set<string>::const_iterator its = mysubsys->assembly_iters().first; its != mysubsys->assembly_iters().second; ++its)
     {
-      return iter->second;
+      cache->AddKey("assembly " + *its);
     }
+    for (set<string>::const_iterator its = mysubsys->logvol_iters().first; its != mysubsys->logvol_iters().second; ++its)
+    {
+      cache->AddKey("logvol " + *its);
+    }
+    ostringstream placement;
+    placement.precision(17);
+    for (const char *par : {"place_x", "place_y", "place_z", "rot_x", "rot_y", "rot_z"})
+    {
+      placement << m_Params->get_double_param(par) << " ";
+    }
+    cache->AddKey(placement.str() + GetName());
   }
-  if (m_AbsorberActive)
+  if (!cache || !cache->Load(logicWorld, placed))
   {
-    auto iter = m_PassivePhysicalVolumesSet.find(volume);
-    if (iter != m_PassivePhysicalVolumesSet.end())
+    ConstructFromGDML(logicWorld, placed);
+    if (cache)
     {
-      return iter->second;
+      cache->Save(placed);
     }
   }
-  return 0;
+  vector<int> volpath;
+  for (auto &p : placed)
+  {
+    // the top volumes are placed directly in the world
+    InsertVolumes(p.first, p.second, p.first->GetObjectRotationValue(), p.first->GetObjectTranslation(), volpath);
+  }
+  AddHitNodes(topNode());
+  return;
 }
 
-//_______________________________________________________________
-void AllSiliconTrackerDetector::ConstructMe(G4LogicalVolume *logicWorld)
+void AllSiliconTrackerDetector::ConstructFromGDML(G4LogicalVolume *logicWorld, vector<PHG4GeometryCache::Placement> &placed)
 {
   unique_ptr<G4GDMLReadStructure> reader(new G4GDMLReadStructure());
   G4GDMLParser gdmlParser(reader.get());
@@ -114,7 +170,7 @@ void AllSiliconTrackerDetector::ConstructMe(G4LogicalVolume *logicWorld)
     vector<G4VPhysicalVolume *>::iterator it = avol->GetVolumesIterator();
     for (unsigned int i = 0; i < avol->TotalImprintedVolumes(); i++)
     {
-      InsertVolumes(*it, insertassemblies);
+      placed.push_back(make_pair(*it, insertassemblies));
       ++it;
     }
   }
@@ -138,14 +194,14 @@ void AllSiliconTrackerDetector::ConstructMe(G4LogicalVolume *logicWorld)
                                                 vol,
                                                 G4String(GetName().c_str()),
                                                 logicWorld, false, 0, OverlapCheck());
-    InsertVolumes(phys, insertlogicalvolumes);
+    placed.push_back(make_pair(phys, insertlogicalvolumes));
   }
-  AddHitNodes(topNode());
   return;
 }
 
-void AllSiliconTrackerDetector::InsertVolumes(G4VPhysicalVolume *physvol, const int flag)
+void AllSiliconTrackerDetector::InsertVolumes(G4VPhysicalVolume *physvol, const int flag, const G4RotationMatrix &rot, const G4ThreeVector &pos, vector<int> &volpath)
 {
+  volpath.push_back(physvol->GetInstanceID());
   static int detid = -9999;
   if (flag == insertassemblies)
   {
@@ -163,30 +219,40 @@ void AllSiliconTrackerDetector::InsertVolumes(G4VPhysicalVolume *physvol, const
     if (physvol->GetName().find("av_") != string::npos && physvol->GetName().find("_impr_") != string::npos)
     {
       detid = -9999;  // reset detid so we see if this is not handled here
-      std::vector<std::string> splitname;
-      boost::algorithm::split(splitname, physvol->GetName(), boost::is_any_of("_"));
-      if (splitname[4].find("AluStrips") != string::npos)
+      // the same logical volume is imprinted many times, decode its name only once
+      auto cached = m_AssemblyDetIds.find(physvol->GetLogicalVolume());
+      if (cached != m_AssemblyDetIds.end())
       {
-        detid = 100;
+        detid = cached->second;
       }
       else
       {
-        string detprefix[] = {"VstStave", "FstContainerVolume", "BstContainerVolume", "Beampipe"};
-        //start layer count at 10 for VstStave
-        // at 20 for Fst
-        // at 30 for Bst
-        // at 40 for beampipe
-        int increase = 10;
-        for (auto toerase : detprefix)
+        std::vector<std::string> splitname;
+        boost::algorithm::split(splitname, physvol->GetName(), boost::is_any_of("_"));
+        if (splitname[4].find("AluStrips") != string::npos)
+        {
+          detid = 100;
+        }
+        else
         {
-          size_t pos = splitname[4].find(toerase);
-          if (pos != string::npos)
+          string detprefix[] = {"VstStave", "FstContainerVolume", "BstContainerVolume", "Beampipe"};
+          //start layer count at 10 for VstStave
+          // at 20 for Fst
+          // at 30 for Bst
+          // at 40 for beampipe
+          int increase = 10;
+          for (auto toerase : detprefix)
           {
-            detid = boost::lexical_cast<int>(splitname[4].erase(pos, toerase.length())) + increase;
-            break;
+            size_t pos = splitname[4].find(toerase);
+            if (pos != string::npos)
+            {
+              detid = boost::lexical_cast<int>(splitname[4].erase(pos, toerase.length())) + increase;
+              break;
+            }
+            increase += 10;
           }
-          increase += 10;
         }
+        m_AssemblyDetIds[physvol->GetLogicalVolume()] = detid;
       }
     }
     if (detid < 0)
@@ -205,13 +271,37 @@ void AllSiliconTrackerDetector::InsertVolumes(G4VPhysicalVolume *physvol, const
   //  cout << "Adding " << physvol->GetName() << endl;
   if (physvol->GetName().find("MimosaCore") != string::npos)
   {
-    m_ActivePhysicalVolumesSet.insert(make_pair(physvol, detid));
+    AddVolume(physvol, 1, detid);
+    // the same physical volume shows up in every placement of its mother,
+    // each visit is a separate sensor
+    if (m_SensorGeom)
+    {
+      AllSiliconTrackerSensorGeom::Sensor sensor;
+      sensor.detid = detid;
+      G4ThreeVector pmin, pmax;
+      logvol->GetSolid()->BoundingLimits(pmin, pmax);
+      for (int i = 0; i < 3; i++)
+      {
+        // the local origin, the center of the box
+        sensor.center[i] = pos[i] / cm;
+        sensor.halfsize[i] = 0.5 * (pmax[i] - pmin[i]) / cm;
+        if (sensor.halfsize[i] < sensor.halfsize[sensor.normal])
+        {
+          sensor.normal = i;
+        }
+        for (int j = 0; j < 3; j++)
+        {
+          sensor.rotation[i][j] = rot[i][j];
+        }
+      }
+      m_SensorIndex[volpath] = m_SensorGeom->AddSensor(sensor);
+    }
   }
   else
   {
     if (m_AbsorberActive)
     {
-      m_PassivePhysicalVolumesSet.insert(make_pair(physvol, -detid));
+      AddVolume(physvol, -1, -detid);
     }
   }
   // G4 10.06 returns unsigned int for GetNoDaughters()
@@ -220,8 +310,9 @@ void AllSiliconTrackerDetector::InsertVolumes(G4VPhysicalVolume *physvol, const
   {
     G4VPhysicalVolume *physvol = logvol->GetDaughter(i);
     // here we decide which volumes are active
-    InsertVolumes(physvol, flag);
+    InsertVolumes(physvol, flag, rot * physvol->GetObjectRotationValue(), rot * physvol->GetObjectTranslation() + pos, volpath);
   }
+  volpath.pop_back();
   return;
 }
 
@@ -240,20 +331,32 @@ void AllSiliconTrackerDetector::Print(const std::string &what) const
 
 int AllSiliconTrackerDetector::get_detid(const G4VPhysicalVolume *physvol, const int whichactive)
 {
-  if (whichactive > 0)
+  if (whichactive == 0)
   {
-    return m_ActivePhysicalVolumesSet.find(physvol)->second;
+    cout << "AllSiliconTrackerDetector::get_detid invalid whichactive flag = 0" << endl;
+    gSystem->Exit(1);
   }
-  else if (whichactive < 0)
+  return m_VolumeTable[physvol->GetInstanceID()].detid;
+}
+
+void AllSiliconTrackerDetector::AddVolume(const G4VPhysicalVolume *physvol, const int active, const int detid)
+{
+  const unsigned int id = physvol->GetInstanceID();
+  if (id >= m_VolumeTable.size())
   {
-    return m_PassivePhysicalVolumesSet.find(physvol)->second;
+    m_VolumeTable.resize(id + 1);
   }
-  else
+  // the first insertion wins, like it did for the volume maps before
+  if (m_VolumeTable[id].active)
   {
-    cout << "AllSiliconTrackerDetector::get_detid invalid whichactive flag = 0" << endl;
-    gSystem->Exit(1);
+    return;
+  }
+  m_VolumeTable[id].active = active;
+  m_VolumeTable[id].detid = detid;
+  if (active > 0)
+  {
+    m_ActiveDetIds.insert(detid);
   }
-  return 0;
 }
 
 void AllSiliconTrackerDetector::AddHitNodes(PHCompositeNode *topNode)
@@ -279,30 +382,9 @@ void AllSiliconTrackerDetector::AddHitNodes(PHCompositeNode *topNode)
       DetNode = new PHCompositeNode(myname);
       dstNode->addNode(DetNode);
     }
-    set<int> DetidSet;
-    for (auto iter = m_ActivePhysicalVolumesSet.begin(); iter != m_ActivePhysicalVolumesSet.end(); ++iter)
-    {
-      DetidSet.insert(iter->second);
-    }
-    ostringstream g4hitnodeactive;
-    for (auto iter = DetidSet.begin(); iter != DetidSet.end(); ++iter)
+    for (auto iter = m_ActiveDetIds.begin(); iter != m_ActiveDetIds.end(); ++iter)
     {
-      g4hitnodeactive.str("");
-      string region;
-      if (*iter < 20)
-      {
-        region = "_CENTRAL_";
-      }
-      else if (*iter < 30)
-      {
-        region = "_FORWARD_";
-      }
-      else
-      {
-        region = "_BACKWARD_";
-      }
-      g4hitnodeactive << "G4HIT_" << myname << region << *iter;
-      nodes.insert(make_pair(g4hitnodeactive.str(), *iter));
+      nodes.insert(make_pair(AllSiliconTrackerSensorGeom::HitNodeName(myname, *iter), *iter));
     }
     if (m_Params->get_int_param("absorberactive"))
     {
@@ -319,6 +401,14 @@ void AllSiliconTrackerDetector::AddHitNodes(PHCompositeNode *topNode)
       }
       m_HitContainerMap.insert(make_pair(nodename.second, g4_hits));
     }
+    PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "RUN"));
+    string geonode = "SENSORGEOM_" + myname;
+    if (findNode::getClass<AllSiliconTrackerSensorGeom>(runNode, geonode))
+    {
+      cout << PHWHERE << " " << geonode << " exists already" << endl;
+      gSystem->Exit(1);
+    }
+    runNode->addNode(new PHDataNode<AllSiliconTrackerSensorGeom>(m_SensorGeom, geonode));
   }
   return;
 }
@@ -334,3 +424,19 @@ PHG4HitContainer *AllSiliconTrackerDetector::get_hitcontainer(const int i)
   gSystem->Exit(1);
   exit(1);
 }
+
+int AllSiliconTrackerDetector::get_sensor(const G4VTouchable *touch) const
+{
+  // the world is at the top of the history
+  vector<int> volpath;
+  for (int depth = touch->GetHistoryDepth() - 1; depth >= 0; depth--)
+  {
+    volpath.push_back(touch->GetVolume(depth)->GetInstanceID());
+  }
+  auto iter = m_SensorIndex.find(volpath);
+  if (iter == m_SensorIndex.end())
+  {
+    return -1;
+  }
+  return iter->second;
+}
@@ -3,15 +3,23 @@
 #ifndef ALLSILICONTRACKERDETECTOR_H
 #define ALLSILICONTRACKERDETECTOR_H
 
+#include <g4eicutils/PHG4GeometryCache.h>
+
 #include <g4main/PHG4Detector.h>
 
+#include <Geant4/G4RotationMatrix.hh>
+#include <Geant4/G4ThreeVector.hh>
+
 #include <map>
 #include <set>
 #include <string>  // for string
+#include <vector>
 
 class AllSiliconTrackerDisplayAction;
+class AllSiliconTrackerSensorGeom;
 class G4LogicalVolume;
 class G4VPhysicalVolume;
+class G4VTouchable;
 class PHCompositeNode;
 class PHG4HitContainer;
 class PHG4Subsystem;
@@ -34,6 +42,8 @@ class AllSiliconTrackerDetector : public PHG4Detector
   //!@name volume accessors
   //@{
   int IsInDetector(G4VPhysicalVolume *) const;
+  //! same as above, also returns the detector id of the volume
+  int IsInDetector(const G4VPhysicalVolume *volume, int &detid) const;
   //@}
 
   void SuperDetector(const std::string &name) { m_SuperDetector = name; }
@@ -41,6 +51,8 @@ class AllSiliconTrackerDetector : public PHG4Detector
 
   int get_detid(const G4VPhysicalVolume *physvol, const int whichactive);
   PHG4HitContainer *get_hitcontainer(const int i);
+  //! index of the sensor the touchable is in, -1 if it is not a sensor
+  int get_sensor(const G4VTouchable *touch) const;
 
  private:
   enum
@@ -48,7 +60,11 @@ class AllSiliconTrackerDetector : public PHG4Detector
     insertassemblies = 1,
     insertlogicalvolumes = 2
   };
-  void InsertVolumes(G4VPhysicalVolume *physvol, const int flag);
+  //! parse the GDML file and place the requested volumes in the world
+  void ConstructFromGDML(G4LogicalVolume *logicWorld, std::vector<PHG4GeometryCache::Placement> &placed);
+  //! rot and pos transform the local coordinates of physvol into global ones,
+  //! volpath holds the instance ids of the volumes above physvol starting below the world
+  void InsertVolumes(G4VPhysicalVolume *physvol, const int flag, const G4RotationMatrix &rot, const G4ThreeVector &pos, std::vector<int> &volpath);
   void AddHitNodes(PHCompositeNode *topNode);
   AllSiliconTrackerDisplayAction *m_DisplayAction;
   PHParameters *m_Params;
@@ -59,11 +75,29 @@ class AllSiliconTrackerDetector : public PHG4Detector
   int m_Active;
   int m_AbsorberActive;
 
-  // active volumes
-  std::map<const G4VPhysicalVolume *, int> m_ActivePhysicalVolumesSet;
-  std::map<const G4VPhysicalVolume *, int> m_PassivePhysicalVolumesSet;
+  struct VolumeInfo
+  {
+    //! > 0 active, < 0 passive, 0 not part of this detector
+    int active = 0;
+    //! detector id as returned by get_detid (negative for passive volumes)
+    int detid = 0;
+  };
+  void AddVolume(const G4VPhysicalVolume *physvol, const int active, const int detid);
+
+  //! volume lookup indexed by the instance id of the physical volume
+  std::vector<VolumeInfo> m_VolumeTable;
+  std::set<int> m_ActiveDetIds;
+
+  //! detector ids decoded from the name of the placed logical volumes of the assemblies
+  std::map<const G4LogicalVolume *, int> m_AssemblyDetIds;
 
   std::map<int, PHG4HitContainer *> m_HitContainerMap;
+
+  //! sensor positions for the digitization, owned by the RUN node
+  AllSiliconTrackerSensorGeom *m_SensorGeom = nullptr;
+  //! sensor index by the instance ids of the volumes from below the world down to the sensor,
+  //! the sensor volumes are shared by all placements of their mothers
+  std::map<std::vector<int>, int> m_SensorIndex;
 };
 
 #endif  // ALLSILICONTRACKERDETECTOR_H
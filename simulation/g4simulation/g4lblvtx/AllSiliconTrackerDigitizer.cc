@@ -0,0 +1,360 @@
+#include "AllSiliconTrackerDigitizer.h"
+
+#include "AllSiliconTrackerSensorGeom.h"
+
+#include <trackbase/TrkrClusterContainerv3.h>
+#include <trackbase/TrkrClusterv2.h>
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitv2.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/PHRandomSeed.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  // mean energy per electron-hole pair in silicon (GeV)
+  const double si_w_value = 3.6e-9;
+
+  uint64_t PixelKey(const int sensor, const int column, const int row)
+  {
+    return (((uint64_t) sensor) << 32) | (((uint64_t) column) << 16) | row;
+  }
+}  // namespace
+
+AllSiliconTrackerDigitizer::AllSiliconTrackerDigitizer(const std::string &name)
+  : SubsysReco(name)
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+}
+
+AllSiliconTrackerDigitizer::~AllSiliconTrackerDigitizer()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+int AllSiliconTrackerDigitizer::InitRun(PHCompositeNode *topNode)
+{
+  const std::string geonodename = "SENSORGEOM_" + m_Detector;
+  m_SensorGeom = findNode::getClass<AllSiliconTrackerSensorGeom>(topNode, geonodename);
+  if (!m_SensorGeom)
+  {
+    std::cout << PHWHERE << " Could not locate sensor geometry node " << geonodename << std::endl;
+    exit(1);
+  }
+  if (m_SensorGeom->size() > 65536)
+  {
+    std::cout << PHWHERE << " number of sensors (" << m_SensorGeom->size()
+              << ") does not fit into the hitset keys" << std::endl;
+    exit(1);
+  }
+  for (int i = 0; i < m_SensorGeom->size(); i++)
+  {
+    const AllSiliconTrackerSensorGeom::Sensor &sensor = m_SensorGeom->GetSensor(i);
+    for (int j = 0; j < 2; j++)
+    {
+      const int npixels = std::ceil(2. * sensor.halfsize[(sensor.normal + j + 1) % 3] / m_Pitch[j]);
+      if (npixels > 65536)
+      {
+        std::cout << PHWHERE << " sensor " << i << " has " << npixels
+                  << " pixels along axis " << j << ", they do not fit into the hit keys" << std::endl;
+        exit(1);
+      }
+    }
+  }
+
+  m_HitNodeNames.clear();
+  for (int detid : m_SensorGeom->GetDetIds())
+  {
+    m_HitNodeNames.push_back(AllSiliconTrackerSensorGeom::HitNodeName(m_Detector, detid));
+  }
+  CreateNodes(topNode);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int AllSiliconTrackerDigitizer::process_event(PHCompositeNode *topNode)
+{
+  const auto start = std::chrono::steady_clock::now();
+  m_PixelCharge.clear();
+
+  // sub steps short compared to the pixel size
+  const double substep = 0.5 * std::min(m_Pitch[0], m_Pitch[1]);
+
+  for (const std::string &nodename : m_HitNodeNames)
+  {
+    PHG4HitContainer *g4hits = findNode::getClass<PHG4HitContainer>(topNode, nodename);
+    if (!g4hits)
+    {
+      continue;
+    }
+    PHG4HitContainer::ConstRange hit_begin_end = g4hits->getHits();
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      PHG4Hit *g4hit = hiter->second;
+      const int isensor = g4hit->get_index_i();
+      if (isensor < 0 || isensor >= m_SensorGeom->size() || g4hit->get_edep() <= 0)
+      {
+        continue;
+      }
+      const AllSiliconTrackerSensorGeom::Sensor &sensor = m_SensorGeom->GetSensor(isensor);
+      const double local0[3] = {g4hit->get_local_x(0), g4hit->get_local_y(0), g4hit->get_local_z(0)};
+      const double local1[3] = {g4hit->get_local_x(1), g4hit->get_local_y(1), g4hit->get_local_z(1)};
+      const int n = sensor.normal;
+      const int a = (n + 1) % 3;
+      const int b = (n + 2) % 3;
+      const double thickness = 2. * sensor.halfsize[n];
+      const double dn = local1[n] - local0[n];
+      const double da = local1[a] - local0[a];
+      const double db = local1[b] - local0[b];
+      const double length = std::sqrt(da * da + db * db);
+      const int nsub = std::min(1000, std::max(1, (int) std::ceil(length / substep)));
+      const double electrons = g4hit->get_edep() / si_w_value / nsub;
+      for (int i = 0; i < nsub; i++)
+      {
+        const double frac = (i + 0.5) / nsub;
+        // charge is collected at the face with negative local coordinate
+        const double drift = std::min(thickness, std::max(0., local0[n] + frac * dn + sensor.halfsize[n]));
+        const double sigma = (thickness > 0) ? m_DiffusionWidth * std::sqrt(drift / thickness) : 0.;
+        AddCharge(isensor, local0[a] + frac * da, local0[b] + frac * db, sigma, electrons);
+      }
+    }
+  }
+
+  MakeHitsAndClusters();
+
+  m_NEvents++;
+  m_Time += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  if (Verbosity() > 1)
+  {
+    std::cout << Name() << ": " << m_PixelCharge.size() << " pixels with charge, "
+              << m_Clusters->size() << " clusters" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int AllSiliconTrackerDigitizer::End(PHCompositeNode * /*topNode*/)
+{
+  if (Verbosity() > 0 && m_NEvents > 0)
+  {
+    std::cout << Name() << ": " << m_NEvents << " events, "
+              << (double) m_NFiredPixels / m_NEvents << " fired pixels and "
+              << (double) m_NClusters / m_NEvents << " clusters per event, "
+              << m_Time / m_NEvents << " ms per event" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void AllSiliconTrackerDigitizer::AddCharge(const int isensor, const double pa, const double pb, const double sigma, const double electrons)
+{
+  const AllSiliconTrackerSensorGeom::Sensor &sensor = m_SensorGeom->GetSensor(isensor);
+  const double pos[2] = {pa, pb};
+  int first[2];
+  std::vector<double> fraction[2];
+  for (int j = 0; j < 2; j++)
+  {
+    const double halfsize = sensor.halfsize[(sensor.normal + j + 1) % 3];
+    const int npixels = std::ceil(2. * halfsize / m_Pitch[j]);
+    const double u = pos[j] + halfsize;
+    const int center = std::floor(u / m_Pitch[j]);
+    if (sigma < 0.01 * m_Pitch[j])
+    {
+      if (center < 0 || center >= npixels)
+      {
+        return;
+      }
+      first[j] = center;
+      fraction[j].push_back(1.);
+      continue;
+    }
+    // share the charge with the pixels within 3 sigma
+    const int range = std::ceil(3. * sigma / m_Pitch[j]);
+    first[j] = std::max(0, center - range);
+    const int last = std::min(npixels - 1, center + range);
+    for (int i = first[j]; i <= last; i++)
+    {
+      fraction[j].push_back(0.5 * (std::erf(((i + 1) * m_Pitch[j] - u) / (M_SQRT2 * sigma)) -
+                                   std::erf((i * m_Pitch[j] - u) / (M_SQRT2 * sigma))));
+    }
+  }
+  for (unsigned int i = 0; i < fraction[0].size(); i++)
+  {
+    for (unsigned int k = 0; k < fraction[1].size(); k++)
+    {
+      const double charge = electrons * fraction[0][i] * fraction[1][k];
+      if (charge > 0)
+      {
+        m_PixelCharge[PixelKey(isensor, first[0] + i, first[1] + k)] += charge;
+      }
+    }
+  }
+}
+
+void AllSiliconTrackerDigitizer::MakeHitsAndClusters()
+{
+  std::vector<uint64_t> fired;
+  for (auto &iter : m_PixelCharge)
+  {
+    iter.second += gsl_ran_gaussian(m_RandomGenerator, m_Noise);
+    if (iter.second < m_Threshold)
+    {
+      continue;
+    }
+    fired.push_back(iter.first);
+    const int isensor = iter.first >> 32;
+    const AllSiliconTrackerSensorGeom::Sensor &sensor = m_SensorGeom->GetSensor(isensor);
+    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, sensor.detid) | isensor;
+    TrkrHitSetContainer::ConstIterator hitset = m_HitSets->findOrAddHitSet(hitsetkey);
+    TrkrHitv2 *hit = new TrkrHitv2();
+    hit->setAdc(iter.second);
+    hitset->second->addHitSpecificKey(iter.first & 0xFFFFFFFF, hit);
+  }
+  m_NFiredPixels += fired.size();
+
+  // connected components by flood fill over the fired pixels sorted by
+  // sensor, column and row, the neighbours are found by binary search
+  std::sort(fired.begin(), fired.end());
+  std::vector<char> used(fired.size(), 0);
+  unsigned int clusid = 0;
+  std::vector<size_t> stack;
+  std::vector<uint64_t> members;
+  for (size_t iseed = 0; iseed < fired.size(); iseed++)
+  {
+    if (used[iseed])
+    {
+      continue;
+    }
+    used[iseed] = 1;
+    const int isensor = fired[iseed] >> 32;
+    stack.assign(1, iseed);
+    members.clear();
+    while (!stack.empty())
+    {
+      const uint64_t key = fired[stack.back()];
+      stack.pop_back();
+      members.push_back(key);
+      const int column = (key >> 16) & 0xFFFF;
+      const int row = key & 0xFFFF;
+      for (int dc = -1; dc <= 1; dc++)
+      {
+        for (int dr = -1; dr <= 1; dr++)
+        {
+          if ((!dc && !dr) || column + dc < 0 || row + dr < 0 || column + dc > 0xFFFF || row + dr > 0xFFFF)
+          {
+            continue;
+          }
+          const uint64_t neighbour = PixelKey(isensor, column + dc, row + dr);
+          auto iter = std::lower_bound(fired.begin(), fired.end(), neighbour);
+          if (iter != fired.end() && *iter == neighbour && !used[iter - fired.begin()])
+          {
+            used[iter - fired.begin()] = 1;
+            stack.push_back(iter - fired.begin());
+          }
+        }
+      }
+    }
+
+    const AllSiliconTrackerSensorGeom::Sensor &sensor = m_SensorGeom->GetSensor(isensor);
+    const int axis[2] = {(sensor.normal + 1) % 3, (sensor.normal + 2) % 3};
+    double sum[2] = {0., 0.};
+    for (uint64_t key : members)
+    {
+      sum[0] += ((key >> 16) & 0xFFFF) + 0.5;
+      sum[1] += (key & 0xFFFF) + 0.5;
+    }
+    double local[3] = {0., 0., 0.};
+    // local covariance, diagonal in the sensor frame
+    double localerr[3] = {0., 0., 0.};
+    for (int j = 0; j < 2; j++)
+    {
+      local[axis[j]] = sum[j] / members.size() * m_Pitch[j] - sensor.halfsize[axis[j]];
+      localerr[axis[j]] = m_Pitch[j] * m_Pitch[j] / 12.;
+    }
+    localerr[sensor.normal] = 4. * sensor.halfsize[sensor.normal] * sensor.halfsize[sensor.normal] / 12.;
+    double global[3];
+    sensor.LocalToGlobal(local, global);
+
+    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, sensor.detid) | isensor;
+    auto clus = std::make_unique<TrkrClusterv2>();
+    TrkrDefs::cluskey cluskey = hitsetkey;
+    cluskey = (cluskey << TrkrDefs::kBitShiftClusId) | clusid;
+    clus->setClusKey(cluskey);
+    for (int i = 0; i < 3; i++)
+    {
+      clus->setPosition(i, global[i]);
+      for (int k = 0; k < 3; k++)
+      {
+        double err = 0.;
+        for (int l = 0; l < 3; l++)
+        {
+          err += sensor.rotation[i][l] * localerr[l] * sensor.rotation[k][l];
+        }
+        clus->setError(i, k, err);
+      }
+    }
+    clus->setGlobal();
+    clus->setAdc(members.size());
+    m_Clusters->addCluster(clus.release());
+    clusid++;
+  }
+  m_NClusters += clusid;
+}
+
+void AllSiliconTrackerDigitizer::CreateNodes(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+    exit(1);
+  }
+  PHNodeIterator dstiter(dstNode);
+  PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+  if (!DetNode)
+  {
+    DetNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(DetNode);
+  }
+
+  std::string nodename = "TRKR_HITSET_" + m_Detector;
+  m_HitSets = findNode::getClass<TrkrHitSetContainer>(DetNode, nodename);
+  if (!m_HitSets)
+  {
+    m_HitSets = new TrkrHitSetContainerv1();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_HitSets, nodename, "PHObject"));
+  }
+
+  nodename = "TRKR_CLUSTER_" + m_Detector;
+  m_Clusters = findNode::getClass<TrkrClusterContainer>(DetNode, nodename);
+  if (!m_Clusters)
+  {
+    m_Clusters = new TrkrClusterContainerv3();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_Clusters, nodename, "PHObject"));
+  }
+  return;
+}
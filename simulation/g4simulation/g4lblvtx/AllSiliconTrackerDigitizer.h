@@ -0,0 +1,103 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef ALLSILICONTRACKERDIGITIZER_H
+#define ALLSILICONTRACKERDIGITIZER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <gsl/gsl_rng.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AllSiliconTrackerSensorGeom;
+class PHCompositeNode;
+class TrkrClusterContainer;
+class TrkrHitSetContainer;
+
+/**
+ * \brief SubsysReco module digitizing the G4Hits in the MimosaCore sensors
+ * of the AllSiliconTracker and clustering the fired pixels
+ *
+ * The energy of each G4Hit is converted to electrons along its path through
+ * the sensor, drifted to the collection face (negative local coordinate
+ * along the thickness) and shared onto the pixels with a gaussian
+ * diffusion width growing with the square root of the drift distance.
+ * Pixels with charge plus gaussian noise above threshold fire, neighbouring
+ * fired pixels (including corners) are joined into clusters in a single
+ * pass over the fired pixels. The cluster position is the mean of the
+ * fired pixel centers (binary readout). Output nodes:
+ *  - TRKR_HITSET_<detector>: one hitset per sensor (mvtx id, layer = detid,
+ *    sensor index in the lower 16 bits), hitkey = (column << 16) | row,
+ *    adc = collected charge in electrons
+ *  - TRKR_CLUSTER_<detector>: clusters in global coordinates
+ * The geometry is taken from SENSORGEOM_<detector> on the RUN node.
+ */
+class AllSiliconTrackerDigitizer : public SubsysReco
+{
+ public:
+  AllSiliconTrackerDigitizer(const std::string &name = "AllSiliconTrackerDigitizer");
+  ~AllSiliconTrackerDigitizer() override;
+
+  //! run initialization
+  int InitRun(PHCompositeNode *topNode) override;
+
+  //! event processing
+  int process_event(PHCompositeNode *topNode) override;
+
+  //! timing and multiplicity summary
+  int End(PHCompositeNode *topNode) override;
+
+  /** Name of the detector (or superdetector) the G4Hits should be taken from.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  //! pixel pitch along the two in-plane local axes (cm)
+  void set_pitch(const double pitch_a, const double pitch_b)
+  {
+    m_Pitch[0] = pitch_a;
+    m_Pitch[1] = pitch_b;
+  }
+  //! diffusion width (cm) after drifting through the full sensor thickness
+  void set_diffusion_width(const double w) { m_DiffusionWidth = w; }
+  //! pixel noise and threshold in electrons
+  void set_threshold(const double noise, const double threshold)
+  {
+    m_Noise = noise;
+    m_Threshold = threshold;
+  }
+
+ private:
+  void CreateNodes(PHCompositeNode *topNode);
+
+  //! add electrons at the local in-plane position pa, pb with the given spread
+  void AddCharge(const int sensor, const double pa, const double pb, const double sigma, const double electrons);
+
+  void MakeHitsAndClusters();
+
+  gsl_rng *m_RandomGenerator = nullptr;
+
+  AllSiliconTrackerSensorGeom *m_SensorGeom = nullptr;
+  TrkrHitSetContainer *m_HitSets = nullptr;
+  TrkrClusterContainer *m_Clusters = nullptr;
+  std::vector<std::string> m_HitNodeNames;
+
+  std::string m_Detector = "LBLVTX";
+
+  double m_Pitch[2] = {0.002, 0.002};
+  double m_DiffusionWidth = 0.0005;
+  double m_Noise = 5.;
+  double m_Threshold = 100.;
+
+  //! (sensor << 32) | (column << 16) | row -> electrons
+  std::unordered_map<uint64_t, double> m_PixelCharge;
+
+  unsigned long m_NEvents = 0;
+  unsigned long m_NFiredPixels = 0;
+  unsigned long m_NClusters = 0;
+  double m_Time = 0.;
+};
+
+#endif  // ALLSILICONTRACKERDIGITIZER_H
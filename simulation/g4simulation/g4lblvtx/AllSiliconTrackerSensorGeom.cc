@@ -0,0 +1,52 @@
+#include "AllSiliconTrackerSensorGeom.h"
+
+#include <sstream>
+
+void AllSiliconTrackerSensorGeom::Sensor::LocalToGlobal(const double local[3], double global[3]) const
+{
+  for (int i = 0; i < 3; i++)
+  {
+    global[i] = center[i];
+    for (int j = 0; j < 3; j++)
+    {
+      global[i] += rotation[i][j] * local[j];
+    }
+  }
+}
+
+int AllSiliconTrackerSensorGeom::AddSensor(const Sensor &sensor)
+{
+  const int index = m_Sensors.size();
+  m_Sensors.push_back(sensor);
+  return index;
+}
+
+std::set<int> AllSiliconTrackerSensorGeom::GetDetIds() const
+{
+  std::set<int> detids;
+  for (const Sensor &sensor : m_Sensors)
+  {
+    detids.insert(sensor.detid);
+  }
+  return detids;
+}
+
+std::string AllSiliconTrackerSensorGeom::HitNodeName(const std::string &detector, const int detid)
+{
+  std::string region;
+  if (detid < 20)
+  {
+    region = "_CENTRAL_";
+  }
+  else if (detid < 30)
+  {
+    region = "_FORWARD_";
+  }
+  else
+  {
+    region = "_BACKWARD_";
+  }
+  std::ostringstream nodename;
+  nodename << "G4HIT_" << detector << region << detid;
+  return nodename.str();
+}
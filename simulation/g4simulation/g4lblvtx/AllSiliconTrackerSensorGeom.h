@@ -0,0 +1,54 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef ALLSILICONTRACKERSENSORGEOM_H
+#define ALLSILICONTRACKERSENSORGEOM_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+/*!
+ * \brief position and orientation of the MimosaCore sensors of the
+ * AllSiliconTracker
+ *
+ * Filled by AllSiliconTrackerDetector when the geometry is built and put on
+ * the RUN node as SENSORGEOM_<detector> for the digitization. The sensors
+ * are boxes, their local coordinates are relative to the center of the box
+ * (cm). The G4Hits keep the index of their sensor in index_i and their local
+ * entry and exit points.
+ */
+class AllSiliconTrackerSensorGeom
+{
+ public:
+  struct Sensor
+  {
+    int detid = 0;
+    //! local to global rotation
+    double rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double center[3] = {0, 0, 0};
+    double halfsize[3] = {0, 0, 0};
+    //! local axis along the thickness of the sensor
+    int normal = 0;
+
+    void LocalToGlobal(const double local[3], double global[3]) const;
+  };
+
+  AllSiliconTrackerSensorGeom() = default;
+  ~AllSiliconTrackerSensorGeom() = default;
+
+  //! returns the index of the new sensor
+  int AddSensor(const Sensor &sensor);
+
+  const Sensor &GetSensor(const int index) const { return m_Sensors[index]; }
+  int size() const { return m_Sensors.size(); }
+
+  std::set<int> GetDetIds() const;
+
+  //! name of the G4Hit node of the sensors with this detid
+  static std::string HitNodeName(const std::string &detector, const int detid);
+
+ private:
+  std::vector<Sensor> m_Sensors;
+};
+
+#endif  // ALLSILICONTRACKERSENSORGEOM_H
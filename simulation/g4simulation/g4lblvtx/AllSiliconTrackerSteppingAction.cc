@@ -17,6 +17,8 @@
 
 #include <TSystem.h>
 
+#include <Geant4/G4AffineTransform.hh>
+#include <Geant4/G4NavigationHistory.hh>
 #include <Geant4/G4ParticleDefinition.hh>
 #include <Geant4/G4ReferenceCountedHandle.hh>
 #include <Geant4/G4Step.hh>
@@ -82,7 +84,9 @@ bool AllSiliconTrackerSteppingAction::UserSteppingAction(const G4Step *aStep, bo
   //  == 0 outside of detector
   //   > 0 for hits in active volume
   //  < 0 for hits in passive material
-  int whichactive = m_Detector->IsInDetector(volume);
+  // the detector id comes with the same lookup
+  int detector_id = 0;
+  int whichactive = m_Detector->IsInDetector(volume, detector_id);
   if (!whichactive)
   {
     return false;
@@ -97,7 +101,6 @@ bool AllSiliconTrackerSteppingAction::UserSteppingAction(const G4Step *aStep, bo
     G4Track *killtrack = const_cast<G4Track *>(aTrack);
     killtrack->SetTrackStatus(fStopAndKill);
   }
-  int detector_id = m_Detector->get_detid(volume, whichactive);  // the detector id is coded into the IsInDetector return
   // cout << "Name: " << volume->GetName() << endl;
   // cout << "det id: " << whichactive << endl;
   bool geantino = false;
@@ -168,6 +171,16 @@ bool AllSiliconTrackerSteppingAction::UserSteppingAction(const G4Step *aStep, bo
     m_Hit->set_z(0, prePoint->GetPosition().z() / cm);
     // time in ns
     m_Hit->set_t(0, prePoint->GetGlobalTime() / nanosecond);
+    if (whichactive > 0)
+    {
+      // sensor and local coordinates for the digitization
+      m_Hit->set_index_i(m_Detector->get_sensor(touch()));
+      const G4AffineTransform &transform = touch->GetHistory()->GetTopTransform();
+      G4ThreeVector local = transform.TransformPoint(prePoint->GetPosition());
+      m_Hit->set_local_x(0, local.x() / cm);
+      m_Hit->set_local_y(0, local.y() / cm);
+      m_Hit->set_local_z(0, local.z() / cm);
+    }
     // set the track ID
     m_Hit->set_trkid(aTrack->GetTrackID());
     m_SaveTrackId = aTrack->GetTrackID();
@@ -269,6 +282,14 @@ bool AllSiliconTrackerSteppingAction::UserSteppingAction(const G4Step *aStep, bo
       m_Hit->set_y(1, postPoint->GetPosition().y() / cm);
       m_Hit->set_z(1, postPoint->GetPosition().z() / cm);
       m_Hit->set_t(1, postPoint->GetGlobalTime() / nanosecond);
+      if (whichactive > 0)
+      {
+        // the pre step point is still inside the sensor
+        G4ThreeVector local = touch->GetHistory()->GetTopTransform().TransformPoint(postPoint->GetPosition());
+        m_Hit->set_local_x(1, local.x() / cm);
+        m_Hit->set_local_y(1, local.y() / cm);
+        m_Hit->set_local_z(1, local.z() / cm);
+      }
       if (G4VUserTrackInformation *p = aTrack->GetUserInformation())
       {
         if (PHG4TrackUserInfoV1 *pp = dynamic_cast<PHG4TrackUserInfoV1 *>(p))
@@ -204,4 +204,6 @@ void AllSiliconTrackerSubsystem::SetDefaultParameters()
   set_default_double_param("rot_z", 0.);
 
   set_default_string_param("GDMPath", "DefaultParameters-InvalidPath");
+  // binary cache of the volumes built from the GDML file, empty: no cache
+  set_default_string_param("GeometryCache", "");
 }
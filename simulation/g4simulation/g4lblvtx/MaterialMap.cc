@@ -0,0 +1,98 @@
+#include "MaterialMap.h"
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TFile.h>
+#include <TH2.h>
+#include <TKey.h>
+#include <TList.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+
+MaterialMap::MaterialMap(const std::string &filename)
+{
+  TFile infile(filename.c_str());
+  if (!infile.IsOpen())
+  {
+    std::cout << PHWHERE << " cannot open material map " << filename << std::endl;
+    exit(1);
+  }
+  TIter next(infile.GetListOfKeys());
+  while (TKey *key = dynamic_cast<TKey *>(next()))
+  {
+    const std::string name = key->GetName();
+    if (name.find("x0_") != 0)
+    {
+      continue;
+    }
+    const std::string group = name.substr(3);
+    TH2 *x0 = dynamic_cast<TH2 *>(infile.Get(name.c_str()));
+    TH2 *lambda = dynamic_cast<TH2 *>(infile.Get(("lambda_" + group).c_str()));
+    if (!x0 || !lambda)
+    {
+      std::cout << PHWHERE << " incomplete material map for " << group << " in " << filename << std::endl;
+      exit(1);
+    }
+    // keep them after the file is closed
+    x0->SetDirectory(nullptr);
+    lambda->SetDirectory(nullptr);
+    m_Maps[group] = std::make_pair(x0, lambda);
+  }
+}
+
+MaterialMap::~MaterialMap()
+{
+  for (auto &iter : m_Maps)
+  {
+    delete iter.second.first;
+    delete iter.second.second;
+  }
+}
+
+double MaterialMap::GetX0(const std::string &group, const double eta, const double phi) const
+{
+  auto iter = m_Maps.find(group);
+  return (iter == m_Maps.end()) ? 0. : Interpolate(iter->second.first, eta, phi);
+}
+
+double MaterialMap::GetLambda(const std::string &group, const double eta, const double phi) const
+{
+  auto iter = m_Maps.find(group);
+  return (iter == m_Maps.end()) ? 0. : Interpolate(iter->second.second, eta, phi);
+}
+
+std::vector<std::string> MaterialMap::GetGroups() const
+{
+  std::vector<std::string> groups;
+  for (auto &iter : m_Maps)
+  {
+    groups.push_back(iter.first);
+  }
+  return groups;
+}
+
+double MaterialMap::Interpolate(const TH2 *h, const double eta, const double phi)
+{
+  // bilinear between the bin centers, periodic in phi
+  const TAxis *xaxis = h->GetXaxis();
+  const TAxis *yaxis = h->GetYaxis();
+  const int nx = xaxis->GetNbins();
+  const int ny = yaxis->GetNbins();
+  const double fx = std::min((double) nx - 1, std::max(0., (eta - xaxis->GetXmin()) / xaxis->GetBinWidth(1) - 0.5));
+  double fy = (phi - yaxis->GetXmin()) / yaxis->GetBinWidth(1) - 0.5;
+  fy -= ny * std::floor(fy / ny);
+  const int ix = std::min(nx - 2, (int) fx);
+  const int iy = (int) fy;
+  const double wx = (nx > 1) ? fx - ix : 0.;
+  const double wy = fy - iy;
+  // bins are numbered from 1, the upper phi neighbour wraps around
+  const int bx0 = std::max(0, ix) + 1;
+  const int bx1 = std::min(nx, bx0 + 1);
+  const int by0 = iy % ny + 1;
+  const int by1 = (iy + 1) % ny + 1;
+  return (1. - wx) * ((1. - wy) * h->GetBinContent(bx0, by0) + wy * h->GetBinContent(bx0, by1)) +
+         wx * ((1. - wy) * h->GetBinContent(bx1, by0) + wy * h->GetBinContent(bx1, by1));
+}
@@ -0,0 +1,40 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MATERIALMAP_H
+#define MATERIALMAP_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TH2;
+
+/**
+ * \brief lookup of the material budget written by MaterialMapBuilder
+ *
+ * Values are interpolated linearly between the bin centers, phi is taken
+ * modulo 2pi. Outside of the eta range the value of the closest bin is
+ * used. No Geant4 is needed for the lookup.
+ */
+class MaterialMap
+{
+ public:
+  explicit MaterialMap(const std::string &filename);
+  ~MaterialMap();
+
+  //! X/X0 of the group ("total" for everything) along eta, phi
+  double GetX0(const std::string &group, const double eta, const double phi) const;
+  //! lambda/lambda0 of the group along eta, phi
+  double GetLambda(const std::string &group, const double eta, const double phi) const;
+
+  std::vector<std::string> GetGroups() const;
+
+ private:
+  static double Interpolate(const TH2 *h, const double eta, const double phi);
+
+  //! group -> (x0, lambda)
+  std::map<std::string, std::pair<TH2 *, TH2 *>> m_Maps;
+};
+
+#endif  // MATERIALMAP_H
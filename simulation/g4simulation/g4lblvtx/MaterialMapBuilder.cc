@@ -0,0 +1,184 @@
+#include "MaterialMapBuilder.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/phool.h>  // for PHWHERE
+
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4Navigator.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4TouchableHistory.hh>
+#include <Geant4/G4TransportationManager.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+
+#include <TFile.h>
+#include <TH2.h>
+
+#include <algorithm>
+#include <cfloat>  // for DBL_MAX
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <memory>
+
+MaterialMapBuilder::MaterialMapBuilder(const std::string &name, const std::string &filename)
+  : SubsysReco(name)
+  , m_FileName(filename)
+{
+}
+
+void MaterialMapBuilder::AddGroup(const std::string &group, const std::string &pattern)
+{
+  m_Patterns.push_back(std::make_pair(group, pattern));
+  if (std::find(m_Groups.begin(), m_Groups.end(), group) == m_Groups.end())
+  {
+    m_Groups.push_back(group);
+  }
+}
+
+int MaterialMapBuilder::FindGroup(const std::vector<G4VPhysicalVolume *> &history)
+{
+  // the innermost volume with a matching name decides
+  for (G4VPhysicalVolume *vol : history)
+  {
+    auto iter = m_VolumeGroup.find(vol);
+    if (iter == m_VolumeGroup.end())
+    {
+      int group = -1;
+      for (const auto &pattern : m_Patterns)
+      {
+        if (vol->GetName().find(pattern.second) != std::string::npos)
+        {
+          group = std::find(m_Groups.begin(), m_Groups.end(), pattern.first) - m_Groups.begin();
+          break;
+        }
+      }
+      iter = m_VolumeGroup.insert(std::make_pair(vol, group)).first;
+    }
+    if (iter->second >= 0)
+    {
+      return iter->second;
+    }
+  }
+  return -1;
+}
+
+int MaterialMapBuilder::InitRun(PHCompositeNode * /*topNode*/)
+{
+  G4VPhysicalVolume *world = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume();
+  if (!world)
+  {
+    std::cout << PHWHERE << " no geometry, register " << Name() << " after PHG4Reco" << std::endl;
+    exit(1);
+  }
+  // our own navigator, the one used for tracking is left alone
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  const int ngroups = m_Groups.size();
+  TFile outfile(m_FileName.c_str(), "RECREATE");
+  std::vector<TH2 *> x0maps;
+  std::vector<TH2 *> lambdamaps;
+  for (int i = 0; i <= ngroups; i++)
+  {
+    const std::string group = (i < ngroups) ? m_Groups[i] : "total";
+    x0maps.push_back(new TH2F(("x0_" + group).c_str(), (group + ";#eta;#phi;X/X_{0}").c_str(),
+                              m_NEtaBins, m_EtaRange[0], m_EtaRange[1], m_NPhiBins, -M_PI, M_PI));
+    lambdamaps.push_back(new TH2F(("lambda_" + group).c_str(), (group + ";#eta;#phi;#lambda/#lambda_{0}").c_str(),
+                                  m_NEtaBins, m_EtaRange[0], m_EtaRange[1], m_NPhiBins, -M_PI, M_PI));
+  }
+
+  const G4ThreeVector vertex(m_Vertex[0] * cm, m_Vertex[1] * cm, m_Vertex[2] * cm);
+  const double maxradius = m_MaxRadius * cm;
+  const double maxz = m_MaxZ * cm;
+  std::vector<double> x0(ngroups + 1);
+  std::vector<double> lambda(ngroups + 1);
+  std::vector<G4VPhysicalVolume *> history;
+  unsigned long nsteps = 0;
+  for (int ieta = 1; ieta <= m_NEtaBins; ieta++)
+  {
+    const double theta = 2. * std::atan(std::exp(-x0maps[0]->GetXaxis()->GetBinCenter(ieta)));
+    for (int iphi = 1; iphi <= m_NPhiBins; iphi++)
+    {
+      const double phi = x0maps[0]->GetYaxis()->GetBinCenter(iphi);
+      const G4ThreeVector dir(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+
+      // path length until the line leaves the scanned cylinder
+      double maxlength = (dir.z() > 0) ? (maxz - vertex.z()) / dir.z() : ((dir.z() < 0) ? (-maxz - vertex.z()) / dir.z() : DBL_MAX);
+      const double a = dir.perp2();
+      if (a > 0)
+      {
+        const double b = vertex.x() * dir.x() + vertex.y() * dir.y();
+        const double c = vertex.perp2() - maxradius * maxradius;
+        maxlength = std::min(maxlength, (-b + std::sqrt(std::max(0., b * b - a * c))) / a);
+      }
+
+      std::fill(x0.begin(), x0.end(), 0.);
+      std::fill(lambda.begin(), lambda.end(), 0.);
+      G4ThreeVector pos = vertex;
+      double length = 0.;
+      int nzerosteps = 0;
+      G4VPhysicalVolume *vol = navigator.LocateGlobalPointAndSetup(pos, &dir, false, false);
+      while (vol && length < maxlength)
+      {
+        double safety;
+        double step = std::min(navigator.ComputeStep(pos, dir, kInfinity, safety), maxlength - length);
+        // stuck on a boundary, push the point through it
+        if (step <= 0.)
+        {
+          if (++nzerosteps > 10)
+          {
+            step = 1 * nm;
+          }
+        }
+        else
+        {
+          nzerosteps = 0;
+        }
+        const G4Material *material = vol->GetLogicalVolume()->GetMaterial();
+        std::unique_ptr<G4TouchableHistory> touch(navigator.CreateTouchableHistory());
+        history.clear();
+        for (int i = 0; i < touch->GetHistoryDepth(); i++)
+        {
+          history.push_back(touch->GetVolume(i));
+        }
+        const int group = FindGroup(history);
+        const double dx0 = step / material->GetRadlen();
+        const double dlambda = step / material->GetNuclearInterLength();
+        if (group >= 0)
+        {
+          x0[group] += dx0;
+          lambda[group] += dlambda;
+        }
+        x0[ngroups] += dx0;
+        lambda[ngroups] += dlambda;
+
+        length += step;
+        pos += step * dir;
+        navigator.SetGeometricallyLimitedStep();
+        vol = navigator.LocateGlobalPointAndSetup(pos, &dir, true);
+        nsteps++;
+      }
+      for (int i = 0; i <= ngroups; i++)
+      {
+        x0maps[i]->SetBinContent(ieta, iphi, x0[i]);
+        lambdamaps[i]->SetBinContent(ieta, iphi, lambda[i]);
+      }
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << m_NEtaBins * m_NPhiBins << " lines, " << nsteps << " steps" << std::endl;
+    const int ieta = x0maps[ngroups]->GetXaxis()->FindBin(0.);
+    for (int i = 0; i <= ngroups; i++)
+    {
+      std::cout << "  " << x0maps[i]->GetName() << " at eta = 0: " << x0maps[i]->GetBinContent(ieta, 1) << std::endl;
+    }
+  }
+  outfile.Write();
+  outfile.Close();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,81 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MATERIALMAPBUILDER_H
+#define MATERIALMAPBUILDER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class G4VPhysicalVolume;
+class PHCompositeNode;
+
+/**
+ * \brief material budget map of the constructed geometry
+ *
+ * Register after PHG4Reco and run a single event. At InitRun straight lines
+ * from the vertex are followed through the geometry with a G4Navigator
+ * (what a geantino would do, without tracking) for every bin center of an
+ * (eta, phi) grid. X/X0 and lambda/lambda0 are accumulated per group, a
+ * volume belongs to the group of the first pattern contained in its name,
+ * going from the volume up through its mothers. Everything is also summed
+ * in the group "total". The lines stop when they leave the world or the
+ * cylinder given by set_max_radius/set_max_z.
+ *
+ * The output file holds two TH2F (eta, phi) per group, x0_<group> and
+ * lambda_<group>, read them back with MaterialMap.
+ */
+class MaterialMapBuilder : public SubsysReco
+{
+ public:
+  MaterialMapBuilder(const std::string &name = "MaterialMapBuilder", const std::string &filename = "material_map.root");
+  ~MaterialMapBuilder() override {}
+
+  //! scan the geometry and write the map
+  int InitRun(PHCompositeNode *topNode) override;
+
+  //! volumes with the pattern in their (or their mothers) name go to this group,
+  //! use one group per layer for a layer by layer map
+  void AddGroup(const std::string &group, const std::string &pattern);
+
+  void set_eta_bins(const int nbins, const double etamin, const double etamax)
+  {
+    m_NEtaBins = nbins;
+    m_EtaRange[0] = etamin;
+    m_EtaRange[1] = etamax;
+  }
+  void set_phi_bins(const int nbins) { m_NPhiBins = nbins; }
+  //! start of the lines (cm)
+  void set_vertex(const double x, const double y, const double z)
+  {
+    m_Vertex[0] = x;
+    m_Vertex[1] = y;
+    m_Vertex[2] = z;
+  }
+  //! scanned cylinder (cm), e.g. up to the calorimeters
+  void set_max_radius(const double r) { m_MaxRadius = r; }
+  void set_max_z(const double z) { m_MaxZ = z; }
+
+ private:
+  //! group index of a volume, -1 if it is in none of the groups
+  int FindGroup(const std::vector<G4VPhysicalVolume *> &history);
+
+  std::string m_FileName;
+
+  int m_NEtaBins = 100;
+  double m_EtaRange[2] = {-4., 4.};
+  int m_NPhiBins = 64;
+  double m_Vertex[3] = {0., 0., 0.};
+  double m_MaxRadius = 1e9;
+  double m_MaxZ = 1e9;
+
+  //! (group, pattern)
+  std::vector<std::pair<std::string, std::string>> m_Patterns;
+  std::vector<std::string> m_Groups;
+  std::unordered_map<const G4VPhysicalVolume *, int> m_VolumeGroup;
+};
+
+#endif  // MATERIALMAPBUILDER_H
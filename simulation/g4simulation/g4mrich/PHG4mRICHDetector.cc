@@ -17,6 +17,8 @@
  * Materials are defined in gmain/PHG4Reco::DefineMaterials      *
  *===============================================================*/
 #include "PHG4mRICHDetector.h"
+#include "PHG4mRICHFresnelLens.h"
+#include "PHG4mRICHModuleGeom.h"
 
 #include <phparameter/PHParameters.h>
 
@@ -24,12 +26,21 @@
 
 #include <g4main/PHG4Detector.h>  // for PHG4Detector
 
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TSystem.h>
+
 #include <Geant4/G4AssemblyVolume.hh>
 #include <Geant4/G4Box.hh>
 #include <Geant4/G4LogicalBorderSurface.hh>
 #include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4MaterialPropertiesTable.hh>  // for G4MaterialProperties...
+#include <Geant4/G4MaterialPropertyVector.hh>
 #include <Geant4/G4OpticalSurface.hh>
 #include <Geant4/G4PVPlacement.hh>
 #include <Geant4/G4PhysicalConstants.hh>
@@ -50,8 +61,7 @@
 #include <iostream>  // for operator<<, basic_os...
 #include <iterator>  // for begin, end
 #include <string>
-
-class PHCompositeNode;
+#include <vector>
 
 using namespace CLHEP;
 
@@ -64,6 +74,7 @@ PHG4mRICHDetector::PHG4mRICHDetector(PHG4Subsystem* subsys, PHCompositeNode* Nod
   , absorberactive(0)
   , mRICH_PV(nullptr)
   , sensor_PV{nullptr, nullptr, nullptr, nullptr}
+  , m_ModuleGeom(nullptr)
 {
 }
 
@@ -82,9 +93,24 @@ int PHG4mRICHDetector::IsInmRICH(G4VPhysicalVolume* volume) const
 
   return INACTIVE;
 }
+
+//_______________________________________________________________
+bool PHG4mRICHDetector::IsInmRICHRadiator(const G4VPhysicalVolume* volume) const
+{
+  if (!volume) return false;
+  return radiator_mat.find(volume->GetLogicalVolume()->GetMaterial()) != radiator_mat.end();
+}
 //______________________________________________________________
 void PHG4mRICHDetector::ConstructMe(G4LogicalVolume* logicWorld)
 {
+  // optical materials of a module, used to select the photons for the
+  // QE culling in the stacking action
+  for (const std::string& matname : {"mRICH_Aerogel2", "mRICH_Acrylic", "mRICH_Borosilicate"})
+  {
+    G4Material* mat = G4Material::GetMaterial(matname, false);
+    if (mat) radiator_mat.insert(mat);
+  }
+
   int subsystemSetup = params->get_int_param("subsystemSetup");
   // -1: single module
   //  0: h-side sectors and e-side wall
@@ -112,6 +138,11 @@ void PHG4mRICHDetector::ConstructMe(G4LogicalVolume* logicWorld)
   {
     build_mRICH_sector2(logicWorld, 8);
   }
+
+  if (active)
+  {
+    AddModuleGeom(logicWorld);
+  }
 }
 //_______________________________________________________________
 G4LogicalVolume* PHG4mRICHDetector::Construct_a_mRICH(G4LogicalVolume* logicWorld)  //, int detectorSetup )
@@ -122,6 +153,7 @@ G4LogicalVolume* PHG4mRICHDetector::Construct_a_mRICH(G4LogicalVolume* logicWorl
 
   //--------------------------- skeleton setup ---------------------------//
   /*holder box and hollow volume*/ G4VPhysicalVolume* hollowVol = build_holderBox(parameters, logicWorld);
+  module_lv.insert(mRICH_PV->GetLogicalVolume());
   /*aerogel                     */ build_aerogel(parameters, hollowVol);
   if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << __FILE__ << "::" << __func__ << ": build_aerogel" << std::endl;
 
@@ -139,6 +171,7 @@ G4LogicalVolume* PHG4mRICHDetector::Construct_a_mRICH(G4LogicalVolume* logicWorl
       if (Verbosity() >= Fun4AllBase::VERBOSITY_MORE) std::cout << __FILE__ << "::" << __func__ << ": readout electronics not placed" << std::endl;
     }
   }
+  SetModuleOptics(parameters);
 
   return hollowVol->GetMotherLogical();  //return detector holder box.
                                          //you have more than 1 daugthers,
@@ -269,6 +302,20 @@ G4double PHG4mRICHDetector::LensPar::GetSagita(G4double r)
   return Sagita_value;
 }
 
+//________________________________________________________________________//
+std::vector<G4double> PHG4mRICHDetector::LensPar::GetGrooveDepths()
+{
+  std::vector<G4double> grooveDepth;
+  for (int igroove = 0; igroove < 1000; igroove++)
+  {
+    G4double iRmin1 = (igroove + 0) * grooveWidth;
+    G4double iRmax1 = (igroove + 1) * grooveWidth;
+    if (iRmax1 > diameter / 2.0) break;
+    grooveDepth.push_back((iRmin1 < eff_diameter / 2.0) ? GetSagita(iRmax1) - GetSagita(iRmin1) : 0.);
+  }
+  return grooveDepth;
+}
+
 //________________________________________________________________________//
 PHG4mRICHDetector::mRichParameter::mRichParameter()
 {
@@ -761,6 +808,16 @@ void PHG4mRICHDetector::build_lens(LensPar* par, G4LogicalVolume* motherLV)
   SurfaceVisAtt->SetForceWireframe(true);
   SurfaceVisAtt->SetForceSolid(true);
 
+  if (params->get_int_param("analytic_lens"))
+  {
+    // single solid with the same groove profile as the polycones below
+    G4VSolid* lens_solid = new PHG4mRICHFresnelLens(par->name, par->halfXYZ[0], par->halfXYZ[2], par->grooveWidth, par->centerThickness, par->GetGrooveDepths());
+    G4LogicalVolume* lens_log = new G4LogicalVolume(lens_solid, par->material, par->name.c_str(), 0, 0, 0);
+    new G4PVPlacement(0, par->pos, lens_log, par->name.c_str(), motherLV, false, 0, OverlapCheck());
+    lens_log->SetVisAttributes(SurfaceVisAtt);
+    return;
+  }
+
   int igroove;
   for (igroove = 0; igroove < 1000; igroove++)
   {  //just put a arbitrary large number
@@ -1131,3 +1188,86 @@ void PHG4mRICHDetector::build_mRICH_wall_eside_proj(G4LogicalVolume* logicWorld)
   rot->rotateX(180 * deg);
   mRICHwall->MakeImprint(logicWorld, pos, rot, 1000, OverlapCheck());
 }
+//________________________________________________________________________//
+void PHG4mRICHDetector::SetModuleOptics(mRichParameter* detectorParameter)
+{
+  if (!active) return;
+  if (!m_ModuleGeom) m_ModuleGeom = new PHG4mRICHModuleGeom();
+
+  // everything is placed in the hollow volume
+  const G4double hollow_z = detectorParameter->GetBoxPar("hollowVolume")->pos.z();
+
+  PHG4mRICHModuleGeom::Optics optics;
+  BoxPar* aerogel = detectorParameter->GetBoxPar("aerogel");
+  optics.aerogel_halfxy = aerogel->halfXYZ[0] / cm;
+  optics.aerogel_z[0] = (hollow_z + aerogel->pos.z() - aerogel->halfXYZ[2]) / cm;
+  optics.aerogel_z[1] = (hollow_z + aerogel->pos.z() + aerogel->halfXYZ[2]) / cm;
+  G4MaterialPropertiesTable* agel_mpt = aerogel->material ? aerogel->material->GetMaterialPropertiesTable() : nullptr;
+  if (agel_mpt && agel_mpt->GetProperty("RINDEX"))
+  {
+    // center of the sensitive range of the sensors
+    optics.aerogel_index = agel_mpt->GetProperty("RINDEX")->Value(3. * eV);
+  }
+
+  // the lens is only there in the full setup
+  if (params->get_int_param("detectorSetup"))
+  {
+    LensPar* lens = detectorParameter->GetLensPar("fresnelLens");
+    optics.lens_index = lens->n;
+    optics.lens_halfxy = lens->halfXYZ[0] / cm;
+    optics.lens_z = (hollow_z + lens->pos.z()) / cm;
+    optics.lens_halfz = lens->halfXYZ[2] / cm;
+    optics.groove_width = lens->grooveWidth / cm;
+    optics.center_thickness = lens->centerThickness / cm;
+    for (G4double depth : lens->GetGrooveDepths())
+    {
+      optics.groove_depth.push_back(depth / cm);
+    }
+  }
+
+  // the four sensors are placed symmetrically around the module axis
+  BoxPar* sensor = detectorParameter->GetBoxPar("sensor");
+  optics.sensor_z = (hollow_z + sensor->pos.z() - sensor->halfXYZ[2]) / cm;
+  optics.sensor_inner = (std::abs(sensor->pos.x()) - sensor->halfXYZ[0]) / cm;
+  optics.sensor_halfxy = (std::abs(sensor->pos.x()) + sensor->halfXYZ[0]) / cm;
+
+  m_ModuleGeom->SetOptics(optics);
+}
+//________________________________________________________________________//
+void PHG4mRICHDetector::AddModuleGeom(G4LogicalVolume* logicWorld)
+{
+  if (!m_ModuleGeom) return;
+
+  // all walls and sectors are imprinted directly into the world
+  const G4int ndaughters = logicWorld->GetNoDaughters();
+  for (G4int i = 0; i < ndaughters; i++)
+  {
+    G4VPhysicalVolume* physvol = logicWorld->GetDaughter(i);
+    if (module_lv.find(physvol->GetLogicalVolume()) == module_lv.end()) continue;
+
+    PHG4mRICHModuleGeom::Module module;
+    module.module_id = physvol->GetCopyNo() - 1;  // same as the sensor hits
+    const G4RotationMatrix rot = physvol->GetObjectRotationValue();
+    const G4ThreeVector pos = physvol->GetObjectTranslation();
+    for (int j = 0; j < 3; j++)
+    {
+      module.center[j] = pos[j] / cm;
+      for (int k = 0; k < 3; k++)
+      {
+        module.rotation[j][k] = rot[j][k];
+      }
+    }
+    m_ModuleGeom->AddModule(module);
+  }
+  if (Verbosity() >= Fun4AllBase::VERBOSITY_SOME) std::cout << __FILE__ << "::" << __func__ << ": " << m_ModuleGeom->size() << " mRICH modules" << std::endl;
+
+  PHNodeIterator iter(topNode());
+  PHCompositeNode* runNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "RUN"));
+  const std::string geonode = PHG4mRICHModuleGeom::NodeName(params->get_string_param("detectorname"));
+  if (findNode::getClass<PHG4mRICHModuleGeom>(runNode, geonode))
+  {
+    std::cout << PHWHERE << " " << geonode << " exists already" << std::endl;
+    gSystem->Exit(1);
+  }
+  runNode->addNode(new PHDataNode<PHG4mRICHModuleGeom>(m_ModuleGeom, geonode));
+}
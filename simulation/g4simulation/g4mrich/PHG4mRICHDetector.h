@@ -14,7 +14,9 @@
 #include <Geant4/G4Types.hh>  // for G4double, G4int
 
 #include <map>  // for map
+#include <set>
 #include <string>
+#include <vector>
 
 class G4LogicalVolume;
 class G4Material;
@@ -22,6 +24,7 @@ class G4VPhysicalVolume;
 class PHParameters;
 class PHCompositeNode;
 class PHG4Subsystem;
+class PHG4mRICHModuleGeom;
 
 //___________________________________________________________________________
 class PHG4mRICHDetector : public PHG4Detector
@@ -40,6 +43,9 @@ class PHG4mRICHDetector : public PHG4Detector
   //bool IsInBlock(G4VPhysicalVolume*) const;
   int IsInmRICH(G4VPhysicalVolume*) const;
 
+  //! true for volumes made of an mRICH optical material (aerogel, lens, glass window)
+  bool IsInmRICHRadiator(const G4VPhysicalVolume*) const;
+
   //void BlackHole(const int i=1) {blackhole = i;}
   //int IsBlackHole() const {return blackhole;}
 
@@ -102,6 +108,11 @@ class PHG4mRICHDetector : public PHG4Detector
   void build_mRICH_sector2(G4LogicalVolume* logicWorld, int numSector);
   void build_mRICH_wall_eside_proj(G4LogicalVolume* space);
 
+  //! module constants for the ring reconstruction, in the holder box frame
+  void SetModuleOptics(mRichParameter* detectorParameter);
+  //! placements of the holder boxes in the world, the geometry goes to the RUN node
+  void AddModuleGeom(G4LogicalVolume* logicWorld);
+
   int layer;
   int active;
   int absorberactive;
@@ -112,6 +123,11 @@ class PHG4mRICHDetector : public PHG4Detector
 
   std::map<const G4VPhysicalVolume*, int> sensor_vol;   // physical volume of senseors
   std::map<const G4VPhysicalVolume*, int> aerogel_vol;  // physical volume of senseors
+
+  std::set<const G4Material*> radiator_mat;  // materials in which photons are produced
+
+  std::set<const G4LogicalVolume*> module_lv;  // holder boxes of all module types
+  PHG4mRICHModuleGeom* m_ModuleGeom;
 };
 //___________________________________________________________________________
 class PHG4mRICHDetector::mRichParameter
@@ -207,6 +223,8 @@ class PHG4mRICHDetector::LensPar
 
   void Set_halfXYZ(G4double halfX, G4double grooveDensity);
   G4double GetSagita(G4double r);
+  //! depth of every groove up to the lens radius, 0 outside the effective diameter
+  std::vector<G4double> GetGrooveDepths();
 };
 //___________________________________________________________________________
 #endif
@@ -0,0 +1,506 @@
+#include "PHG4mRICHFresnelLens.h"
+
+#include <Geant4/G4AffineTransform.hh>
+#include <Geant4/G4BoundingEnvelope.hh>
+#include <Geant4/G4Polyhedron.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4VGraphicsScene.hh>
+#include <Geant4/G4VoxelLimits.hh>
+#include <Geant4/Randomize.hh>
+#include <Geant4/geomdefs.hh>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  const G4double tiny = 1e-12;
+}
+
+//_______________________________________________________________
+PHG4mRICHFresnelLens::PHG4mRICHFresnelLens(const G4String &name, const G4double halfXY, const G4double halfZ,
+                                           const G4double grooveWidth, const G4double centerThickness,
+                                           const std::vector<G4double> &grooveDepth)
+  : G4VSolid(name)
+  , m_HalfXY(halfXY)
+  , m_HalfZ(halfZ)
+  , m_GrooveWidth(grooveWidth)
+  , m_CenterThickness(centerThickness)
+  , m_OuterRadius(grooveDepth.size() * grooveWidth)
+{
+  for (G4double depth : grooveDepth)
+  {
+    if (depth > 0)
+    {
+      m_ZLow.push_back(-m_HalfZ);
+      m_Slope.push_back(depth / m_GrooveWidth);
+      m_ZMin.push_back(-m_HalfZ);
+      m_ZMax.push_back(-m_HalfZ + depth);
+    }
+    else
+    {
+      m_ZLow.push_back(m_HalfZ - m_CenterThickness);
+      m_Slope.push_back(0.);
+      m_ZMin.push_back(m_HalfZ - m_CenterThickness);
+      m_ZMax.push_back(m_HalfZ - m_CenterThickness);
+    }
+  }
+}
+
+//_______________________________________________________________
+int PHG4mRICHFresnelLens::GrooveIndex(const G4double r) const
+{
+  int i = r / m_GrooveWidth;
+  return std::max(0, std::min(i, (int) m_ZLow.size() - 1));
+}
+
+//_______________________________________________________________
+G4double PHG4mRICHFresnelLens::BottomDistance(const G4double r, const G4double z, int &face) const
+{
+  int i = GrooveIndex(r);
+  G4double dcone = (z - Bottom(i, r)) / std::sqrt(1. + m_Slope[i] * m_Slope[i]);
+  bool inside = (dcone >= 0);
+  G4double dist = std::fabs(dcone);
+  face = 0;
+
+  // vertical faces between this groove and its neighbours, they only
+  // matter if z is between the two lower surfaces at the groove border
+  if (i > 0)
+  {
+    G4double radius = i * m_GrooveWidth;
+    G4double zneighbour = Bottom(i - 1, radius);
+    if (z >= std::min(zneighbour, m_ZLow[i]) && z <= std::max(zneighbour, m_ZLow[i]) && r - radius < dist)
+    {
+      dist = r - radius;
+      face = 1;
+    }
+  }
+  if (i + 1 < (int) m_ZLow.size())
+  {
+    G4double radius = (i + 1) * m_GrooveWidth;
+    G4double zown = Bottom(i, radius);
+    if (z >= std::min(zown, m_ZLow[i + 1]) && z <= std::max(zown, m_ZLow[i + 1]) && radius - r < dist)
+    {
+      dist = radius - r;
+      face = 2;
+    }
+  }
+  return inside ? dist : -dist;
+}
+
+//_______________________________________________________________
+bool PHG4mRICHFresnelLens::IsInside(const G4ThreeVector &p) const
+{
+  if (std::fabs(p.x()) > m_HalfXY || std::fabs(p.y()) > m_HalfXY || p.z() > m_HalfZ)
+  {
+    return false;
+  }
+  G4double r = p.perp();
+  if (r > m_OuterRadius)
+  {
+    return false;
+  }
+  return p.z() >= Bottom(GrooveIndex(r), r);
+}
+
+//_______________________________________________________________
+EInside PHG4mRICHFresnelLens::Inside(const G4ThreeVector &p) const
+{
+  const G4double delta = 0.5 * kCarTolerance;
+  G4double r = p.perp();
+  G4double dist = std::min(std::min(m_HalfXY - std::fabs(p.x()), m_HalfXY - std::fabs(p.y())),
+                           std::min(m_HalfZ - p.z(), m_OuterRadius - r));
+  if (dist < -delta)
+  {
+    return kOutside;
+  }
+  int face;
+  dist = std::min(dist, BottomDistance(r, p.z(), face));
+  if (dist > delta)
+  {
+    return kInside;
+  }
+  if (dist < -delta)
+  {
+    return kOutside;
+  }
+  return kSurface;
+}
+
+//_______________________________________________________________
+G4ThreeVector PHG4mRICHFresnelLens::SurfaceNormal(const G4ThreeVector &p) const
+{
+  G4double r = p.perp();
+  G4ThreeVector rhat = (r > tiny) ? G4ThreeVector(p.x() / r, p.y() / r, 0) : G4ThreeVector(1, 0, 0);
+
+  G4ThreeVector normal(0, 0, 1);
+  G4double dmin = std::fabs(m_HalfZ - p.z());
+  if (std::fabs(m_HalfXY - std::fabs(p.x())) < dmin)
+  {
+    dmin = std::fabs(m_HalfXY - std::fabs(p.x()));
+    normal = G4ThreeVector((p.x() < 0) ? -1 : 1, 0, 0);
+  }
+  if (std::fabs(m_HalfXY - std::fabs(p.y())) < dmin)
+  {
+    dmin = std::fabs(m_HalfXY - std::fabs(p.y()));
+    normal = G4ThreeVector(0, (p.y() < 0) ? -1 : 1, 0);
+  }
+  if (std::fabs(m_OuterRadius - r) < dmin)
+  {
+    dmin = std::fabs(m_OuterRadius - r);
+    normal = rhat;
+  }
+  int face;
+  G4double dbottom = std::fabs(BottomDistance(r, p.z(), face));
+  if (dbottom < dmin)
+  {
+    int i = GrooveIndex(r);
+    if (face == 0)
+    {
+      // lower surface z = zlow + slope * (r - ri), material above it
+      normal = (m_Slope[i] * rhat - G4ThreeVector(0, 0, 1)) / std::sqrt(1. + m_Slope[i] * m_Slope[i]);
+    }
+    else if (face == 1)
+    {
+      // the material is on the side with the lower surface further down
+      normal = (Bottom(i - 1, i * m_GrooveWidth) > m_ZLow[i]) ? -rhat : rhat;
+    }
+    else
+    {
+      normal = (Bottom(i, (i + 1) * m_GrooveWidth) < m_ZLow[i + 1]) ? rhat : -rhat;
+    }
+  }
+  return normal;
+}
+
+//_______________________________________________________________
+void PHG4mRICHFresnelLens::Intersections(const G4ThreeVector &p, const G4ThreeVector &v, std::vector<G4double> &s) const
+{
+  s.clear();
+
+  // clip the ray to the bounding box
+  G4double s0 = 0;
+  G4double s1 = kInfinity;
+  const G4double half[3] = {m_HalfXY, m_HalfXY, m_HalfZ};
+  for (int i = 0; i < 3; i++)
+  {
+    if (std::fabs(v[i]) < tiny)
+    {
+      if (std::fabs(p[i]) > half[i])
+      {
+        return;
+      }
+      continue;
+    }
+    G4double t1 = (-half[i] - p[i]) / v[i];
+    G4double t2 = (half[i] - p[i]) / v[i];
+    s0 = std::max(s0, std::min(t1, t2));
+    s1 = std::min(s1, std::max(t1, t2));
+  }
+  if (s0 > s1)
+  {
+    return;
+  }
+  s.push_back(s0);
+  s.push_back(s1);
+
+  // crossings of the groove borders, r^2(t) = a t^2 + 2 b t + c
+  const G4double a = v.x() * v.x() + v.y() * v.y();
+  const G4double b = p.x() * v.x() + p.y() * v.y();
+  const G4double c = p.x() * p.x() + p.y() * p.y();
+  if (a > tiny)
+  {
+    G4double tclosest = std::max(s0, std::min(s1, -b / a));
+    G4double rmin = std::sqrt(std::max(0., a * tclosest * tclosest + 2 * b * tclosest + c));
+    G4double rmax = std::sqrt(std::max(a * s0 * s0 + 2 * b * s0 + c, a * s1 * s1 + 2 * b * s1 + c));
+    int jmin = std::max(1, (int) std::ceil(rmin / m_GrooveWidth));
+    int jmax = std::min((int) m_ZLow.size(), (int) std::floor(rmax / m_GrooveWidth));
+    for (int j = jmin; j <= jmax; j++)
+    {
+      G4double radius = j * m_GrooveWidth;
+      G4double disc = b * b - a * (c - radius * radius);
+      if (disc < 0)
+      {
+        continue;
+      }
+      disc = std::sqrt(disc);
+      for (G4double t : {(-b - disc) / a, (-b + disc) / a})
+      {
+        if (t > s0 && t < s1)
+        {
+          s.push_back(t);
+        }
+      }
+    }
+  }
+  std::sort(s.begin(), s.end());
+
+  // crossings of the lower surface, the groove is fixed between two borders
+  const unsigned int nborders = s.size();
+  for (unsigned int k = 0; k + 1 < nborders; k++)
+  {
+    G4double ta = s[k];
+    G4double tb = s[k + 1];
+    G4double tm = 0.5 * (ta + tb);
+    int i = GrooveIndex(std::sqrt(std::max(0., a * tm * tm + 2 * b * tm + c)));
+    if (m_Slope[i] == 0)
+    {
+      if (std::fabs(v.z()) > tiny)
+      {
+        G4double t = (m_ZLow[i] - p.z()) / v.z();
+        if (t > ta && t < tb)
+        {
+          s.push_back(t);
+        }
+      }
+      continue;
+    }
+    // cone r = c0 + c1 * t
+    const G4double c0 = i * m_GrooveWidth + (p.z() - m_ZLow[i]) / m_Slope[i];
+    const G4double c1 = v.z() / m_Slope[i];
+    const G4double A = a - c1 * c1;
+    const G4double B = b - c0 * c1;
+    const G4double C = c - c0 * c0;
+    G4double roots[2];
+    int nroots = 0;
+    if (std::fabs(A) < tiny)
+    {
+      if (std::fabs(B) > tiny)
+      {
+        roots[nroots++] = -C / (2 * B);
+      }
+    }
+    else
+    {
+      G4double disc = B * B - A * C;
+      if (disc >= 0)
+      {
+        disc = std::sqrt(disc);
+        roots[nroots++] = (-B - disc) / A;
+        roots[nroots++] = (-B + disc) / A;
+      }
+    }
+    for (int n = 0; n < nroots; n++)
+    {
+      if (roots[n] > ta && roots[n] < tb && c0 + c1 * roots[n] >= 0)
+      {
+        s.push_back(roots[n]);
+      }
+    }
+  }
+  std::sort(s.begin(), s.end());
+}
+
+//_______________________________________________________________
+G4double PHG4mRICHFresnelLens::DistanceToIn(const G4ThreeVector &p, const G4ThreeVector &v) const
+{
+  std::vector<G4double> s;
+  Intersections(p, v, s);
+  for (unsigned int k = 0; k + 1 < s.size(); k++)
+  {
+    if (s[k + 1] - s[k] < 0.5 * kCarTolerance)
+    {
+      continue;
+    }
+    if (IsInside(p + 0.5 * (s[k] + s[k + 1]) * v))
+    {
+      return (s[k] < 0.5 * kCarTolerance) ? 0. : s[k];
+    }
+  }
+  return kInfinity;
+}
+
+//_______________________________________________________________
+G4double PHG4mRICHFresnelLens::DistanceToIn(const G4ThreeVector &p) const
+{
+  G4double r = p.perp();
+  G4double dist = std::max(std::max(std::fabs(p.x()) - m_HalfXY, std::fabs(p.y()) - m_HalfXY),
+                           std::max(std::fabs(p.z()) - m_HalfZ, r - m_OuterRadius));
+  if (dist > 0)
+  {
+    return dist;
+  }
+  int face;
+  if (BottomDistance(r, p.z(), face) >= 0)
+  {
+    return 0;
+  }
+
+  // below the lower surface of groove i, the material of the other grooves
+  // is at least the radial (or for the neighbours the vertical) gap away
+  int i = GrooveIndex(r);
+  const int ngroove = m_ZLow.size();
+  dist = (p.z() - Bottom(i, r)) / std::sqrt(1. + m_Slope[i] * m_Slope[i]);
+  dist = std::fabs(dist);
+  if (i > 0)
+  {
+    dist = std::min(dist, std::max(r - i * m_GrooveWidth, m_ZMin[i - 1] - p.z()));
+  }
+  if (i > 1)
+  {
+    dist = std::min(dist, r - (i - 1) * m_GrooveWidth);
+  }
+  if (i + 1 < ngroove)
+  {
+    dist = std::min(dist, std::max((i + 1) * m_GrooveWidth - r, m_ZMin[i + 1] - p.z()));
+  }
+  if (i + 2 < ngroove)
+  {
+    dist = std::min(dist, (i + 2) * m_GrooveWidth - r);
+  }
+  return std::max(0., dist);
+}
+
+//_______________________________________________________________
+G4double PHG4mRICHFresnelLens::DistanceToOut(const G4ThreeVector &p, const G4ThreeVector &v,
+                                             const G4bool calcNorm, G4bool *validNorm,
+                                             G4ThreeVector *n) const
+{
+  std::vector<G4double> s;
+  Intersections(p, v, s);
+  G4double dist = 0;
+  if (!s.empty())
+  {
+    dist = s.back();
+    for (unsigned int k = 0; k + 1 < s.size(); k++)
+    {
+      if (s[k + 1] - s[k] < 0.5 * kCarTolerance)
+      {
+        continue;
+      }
+      if (!IsInside(p + 0.5 * (s[k] + s[k + 1]) * v))
+      {
+        dist = (s[k] < 0.5 * kCarTolerance) ? 0. : s[k];
+        break;
+      }
+    }
+  }
+  if (calcNorm)
+  {
+    // the lens is not convex
+    *validNorm = false;
+    *n = SurfaceNormal(p + dist * v);
+  }
+  return dist;
+}
+
+//_______________________________________________________________
+G4double PHG4mRICHFresnelLens::DistanceToOut(const G4ThreeVector &p) const
+{
+  G4double r = p.perp();
+  G4double dist = std::min(std::min(m_HalfXY - std::fabs(p.x()), m_HalfXY - std::fabs(p.y())),
+                           std::min(m_HalfZ - p.z(), m_OuterRadius - r));
+  int i = GrooveIndex(r);
+  const int ngroove = m_ZLow.size();
+  dist = std::min(dist, (p.z() - Bottom(i, r)) / std::sqrt(1. + m_Slope[i] * m_Slope[i]));
+  // the air below the neighbouring grooves
+  if (i > 0)
+  {
+    dist = std::min(dist, std::max(r - i * m_GrooveWidth, p.z() - m_ZMax[i - 1]));
+  }
+  if (i > 1)
+  {
+    dist = std::min(dist, r - (i - 1) * m_GrooveWidth);
+  }
+  if (i + 1 < ngroove)
+  {
+    dist = std::min(dist, std::max((i + 1) * m_GrooveWidth - r, p.z() - m_ZMax[i + 1]));
+  }
+  if (i + 2 < ngroove)
+  {
+    dist = std::min(dist, (i + 2) * m_GrooveWidth - r);
+  }
+  return std::max(0., dist);
+}
+
+//_______________________________________________________________
+void PHG4mRICHFresnelLens::BoundingLimits(G4ThreeVector &pMin, G4ThreeVector &pMax) const
+{
+  G4double halfxy = std::min(m_HalfXY, m_OuterRadius);
+  pMin.set(-halfxy, -halfxy, -m_HalfZ);
+  pMax.set(halfxy, halfxy, m_HalfZ);
+}
+
+//_______________________________________________________________
+G4bool PHG4mRICHFresnelLens::CalculateExtent(const EAxis pAxis, const G4VoxelLimits &pVoxelLimit,
+                                             const G4AffineTransform &pTransform,
+                                             G4double &pMin, G4double &pMax) const
+{
+  G4ThreeVector bmin, bmax;
+  BoundingLimits(bmin, bmax);
+  G4BoundingEnvelope bbox(bmin, bmax);
+  return bbox.CalculateExtent(pAxis, pVoxelLimit, pTransform, pMin, pMax);
+}
+
+//_______________________________________________________________
+G4ThreeVector PHG4mRICHFresnelLens::GetPointOnSurface() const
+{
+  // flat face, grooved face and the four sides, roughly by area
+  G4double aface = 4 * m_HalfXY * m_HalfXY;
+  G4double aside = 16 * m_HalfXY * m_HalfZ;
+  G4double select = G4UniformRand() * (2 * aface + aside);
+  for (int itry = 0; itry < 1000; itry++)
+  {
+    G4double x = (2 * G4UniformRand() - 1) * m_HalfXY;
+    G4double y = (2 * G4UniformRand() - 1) * m_HalfXY;
+    if (select >= 2 * aface)
+    {
+      // one of the sides
+      int side = 4 * G4UniformRand();
+      if (side < 2)
+      {
+        x = (side == 0) ? -m_HalfXY : m_HalfXY;
+      }
+      else
+      {
+        y = (side == 2) ? -m_HalfXY : m_HalfXY;
+      }
+    }
+    G4double r = std::sqrt(x * x + y * y);
+    if (r > m_OuterRadius)
+    {
+      continue;
+    }
+    G4double zbottom = Bottom(GrooveIndex(r), r);
+    if (select < aface)
+    {
+      return G4ThreeVector(x, y, m_HalfZ);
+    }
+    if (select < 2 * aface)
+    {
+      return G4ThreeVector(x, y, zbottom);
+    }
+    return G4ThreeVector(x, y, zbottom + G4UniformRand() * (m_HalfZ - zbottom));
+  }
+  return G4ThreeVector(0, 0, m_HalfZ);
+}
+
+//_______________________________________________________________
+std::ostream &PHG4mRICHFresnelLens::StreamInfo(std::ostream &os) const
+{
+  os << "-----------------------------------------------------------\n"
+     << "    *** Dump for solid - " << GetName() << " ***\n"
+     << "    ===================================================\n"
+     << " Solid type: " << GetEntityType() << "\n"
+     << " Parameters: \n"
+     << "   half length xy: " << m_HalfXY / CLHEP::mm << " mm\n"
+     << "   half length z: " << m_HalfZ / CLHEP::mm << " mm\n"
+     << "   groove width: " << m_GrooveWidth / CLHEP::mm << " mm\n"
+     << "   center thickness: " << m_CenterThickness / CLHEP::mm << " mm\n"
+     << "   number of grooves: " << m_ZLow.size() << "\n"
+     << "-----------------------------------------------------------\n";
+  return os;
+}
+
+//_______________________________________________________________
+void PHG4mRICHFresnelLens::DescribeYourselfTo(G4VGraphicsScene &scene) const
+{
+  scene.AddSolid(*this);
+}
+
+//_______________________________________________________________
+G4Polyhedron *PHG4mRICHFresnelLens::CreatePolyhedron() const
+{
+  G4double halfxy = std::min(m_HalfXY, m_OuterRadius);
+  return new G4PolyhedronBox(halfxy, halfxy, m_HalfZ);
+}
@@ -0,0 +1,95 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4MRICHFRESNELLENS_H
+#define G4DETECTORS_PHG4MRICHFRESNELLENS_H
+
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4Types.hh>
+#include <Geant4/G4VSolid.hh>
+
+#include <iostream>
+#include <vector>
+
+class G4AffineTransform;
+class G4Polyhedron;
+class G4VGraphicsScene;
+class G4VoxelLimits;
+
+/*!
+ * \brief Fresnel lens of an mRICH module as a single solid
+ *
+ * Square plate (|x|,|y| < halfXY, |z| < halfZ) cut at the radius of the
+ * last groove. The flat side is at +z, the grooves are at -z. Groove i
+ * covers i*grooveWidth < r < (i+1)*grooveWidth. A groove with depth > 0 is
+ * a conical tooth whose lower surface rises linearly from -halfZ at its
+ * inner radius to -halfZ + depth at its outer radius. A groove with
+ * depth <= 0 is flat with the thickness centerThickness. This is the same
+ * profile as the polycone grooves of PHG4mRICHDetector::build_lens. All
+ * surfaces are found from the groove index of the radius, so a photon
+ * only sees the real acrylic/air boundaries.
+ */
+class PHG4mRICHFresnelLens : public G4VSolid
+{
+ public:
+  PHG4mRICHFresnelLens(const G4String &name, const G4double halfXY, const G4double halfZ,
+                       const G4double grooveWidth, const G4double centerThickness,
+                       const std::vector<G4double> &grooveDepth);
+
+  virtual ~PHG4mRICHFresnelLens() {}
+
+  EInside Inside(const G4ThreeVector &p) const override;
+  G4ThreeVector SurfaceNormal(const G4ThreeVector &p) const override;
+  G4double DistanceToIn(const G4ThreeVector &p, const G4ThreeVector &v) const override;
+  G4double DistanceToIn(const G4ThreeVector &p) const override;
+  G4double DistanceToOut(const G4ThreeVector &p, const G4ThreeVector &v,
+                         const G4bool calcNorm = false, G4bool *validNorm = nullptr,
+                         G4ThreeVector *n = nullptr) const override;
+  G4double DistanceToOut(const G4ThreeVector &p) const override;
+
+  void BoundingLimits(G4ThreeVector &pMin, G4ThreeVector &pMax) const override;
+  G4bool CalculateExtent(const EAxis pAxis, const G4VoxelLimits &pVoxelLimit,
+                         const G4AffineTransform &pTransform,
+                         G4double &pMin, G4double &pMax) const override;
+
+  G4ThreeVector GetPointOnSurface() const override;
+  G4GeometryType GetEntityType() const override { return "PHG4mRICHFresnelLens"; }
+  G4VSolid *Clone() const override { return new PHG4mRICHFresnelLens(*this); }
+  std::ostream &StreamInfo(std::ostream &os) const override;
+
+  //! drawn as its bounding box
+  void DescribeYourselfTo(G4VGraphicsScene &scene) const override;
+  G4Polyhedron *CreatePolyhedron() const override;
+
+ private:
+  int GrooveIndex(const G4double r) const;
+
+  //! z of the lower lens surface in groove i at radius r
+  G4double Bottom(const int i, const G4double r) const
+  {
+    return m_ZLow[i] + m_Slope[i] * (r - i * m_GrooveWidth);
+  }
+
+  //! signed distance to the lower surface (cone and step faces), > 0 inside
+  G4double BottomDistance(const G4double r, const G4double z, int &face) const;
+
+  //! point inside without tolerance, used to classify the ray intervals
+  bool IsInside(const G4ThreeVector &p) const;
+
+  //! sorted distances along the ray at which it may cross the lens surface
+  void Intersections(const G4ThreeVector &p, const G4ThreeVector &v, std::vector<G4double> &s) const;
+
+  G4double m_HalfXY;
+  G4double m_HalfZ;
+  G4double m_GrooveWidth;
+  G4double m_CenterThickness;
+  G4double m_OuterRadius;
+
+  // per groove: lower surface at the inner radius, slope, lowest and
+  // highest point of the lower surface
+  std::vector<G4double> m_ZLow;
+  std::vector<G4double> m_Slope;
+  std::vector<G4double> m_ZMin;
+  std::vector<G4double> m_ZMax;
+};
+
+#endif  // G4DETECTORS_PHG4MRICHFRESNELLENS_H
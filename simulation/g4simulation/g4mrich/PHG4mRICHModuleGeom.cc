@@ -0,0 +1,41 @@
+#include "PHG4mRICHModuleGeom.h"
+
+void PHG4mRICHModuleGeom::Module::LocalToGlobal(const double local[3], double global[3]) const
+{
+  LocalToGlobalDir(local, global);
+  for (int i = 0; i < 3; i++)
+  {
+    global[i] += center[i];
+  }
+}
+
+void PHG4mRICHModuleGeom::Module::GlobalToLocal(const double global[3], double local[3]) const
+{
+  const double shifted[3] = {global[0] - center[0], global[1] - center[1], global[2] - center[2]};
+  GlobalToLocalDir(shifted, local);
+}
+
+void PHG4mRICHModuleGeom::Module::LocalToGlobalDir(const double local[3], double global[3]) const
+{
+  for (int i = 0; i < 3; i++)
+  {
+    global[i] = 0;
+    for (int j = 0; j < 3; j++)
+    {
+      global[i] += rotation[i][j] * local[j];
+    }
+  }
+}
+
+void PHG4mRICHModuleGeom::Module::GlobalToLocalDir(const double global[3], double local[3]) const
+{
+  // the transpose is the inverse of the rotation
+  for (int i = 0; i < 3; i++)
+  {
+    local[i] = 0;
+    for (int j = 0; j < 3; j++)
+    {
+      local[i] += rotation[j][i] * global[j];
+    }
+  }
+}
@@ -0,0 +1,78 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4MRICHMODULEGEOM_H
+#define G4DETECTORS_PHG4MRICHMODULEGEOM_H
+
+#include <string>
+#include <vector>
+
+/*!
+ * \brief placement and optics of the mRICH modules
+ *
+ * Filled by PHG4mRICHDetector when the geometry is built and put on the RUN
+ * node as MODULEGEOM_<detector> for the ring reconstruction. All lengths are
+ * in cm. The module frame is the frame of the holder box, the particle
+ * enters at -z and the sensors are at +z. Every module is built from the
+ * same parameters, so the optics is only stored once.
+ */
+class PHG4mRICHModuleGeom
+{
+ public:
+  struct Module
+  {
+    //! module_id of the sensor hits (copy number of the holder box - 1)
+    int module_id = 0;
+    //! local to global rotation
+    double rotation[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    double center[3] = {0, 0, 0};
+
+    void LocalToGlobal(const double local[3], double global[3]) const;
+    void GlobalToLocal(const double global[3], double local[3]) const;
+    //! same for directions
+    void LocalToGlobalDir(const double local[3], double global[3]) const;
+    void GlobalToLocalDir(const double global[3], double local[3]) const;
+  };
+
+  struct Optics
+  {
+    double aerogel_index = 1.03;
+    double aerogel_halfxy = 0;
+    //! upstream and downstream face of the aerogel block
+    double aerogel_z[2] = {0, 0};
+
+    double lens_index = 1.49;
+    double lens_halfxy = 0;
+    //! center of the lens, grooves at lens_z - lens_halfz, flat face at lens_z + lens_halfz
+    double lens_z = 0;
+    double lens_halfz = 0;
+    double groove_width = 0;
+    double center_thickness = 0;
+    //! depth of every groove, <= 0 for the flat part outside the effective diameter
+    std::vector<double> groove_depth;
+
+    //! entrance of the photons into the sensors, the four sensors cover
+    //! sensor_inner < |x|, |y| < sensor_halfxy
+    double sensor_z = 0;
+    double sensor_inner = 0;
+    double sensor_halfxy = 0;
+  };
+
+  PHG4mRICHModuleGeom() = default;
+  ~PHG4mRICHModuleGeom() = default;
+
+  void AddModule(const Module &module) { m_Modules.push_back(module); }
+  const Module &GetModule(const int index) const { return m_Modules[index]; }
+  int size() const { return m_Modules.size(); }
+
+  void SetOptics(const Optics &optics) { m_Optics = optics; }
+  const Optics &GetOptics() const { return m_Optics; }
+
+  //! name of the geometry node of this detector
+  static std::string NodeName(const std::string &detector) { return "MODULEGEOM_" + detector; }
+
+ private:
+  std::vector<Module> m_Modules;
+  Optics m_Optics;
+};
+
+#endif  // G4DETECTORS_PHG4MRICHMODULEGEOM_H
@@ -0,0 +1,544 @@
+#include "PHG4mRICHRingReco.h"
+
+#include "PHG4mRICHModuleGeom.h"
+
+#include <eicpidbase/EICPIDDefs.h>
+#include <eicpidbase/EICPIDParticle.h>
+#include <eicpidbase/EICPIDParticleContainer.h>
+
+#include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackState.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace
+{
+  struct Hypothesis
+  {
+    EICPIDDefs::PIDCandidate candidate;
+    double mass;  // GeV
+  };
+
+  const Hypothesis hypotheses[] = {
+      {EICPIDDefs::ElectronCandiate, 0.000511},
+      {EICPIDDefs::PionCandiate, 0.13957},
+      {EICPIDDefs::KaonCandiate, 0.493677},
+      {EICPIDDefs::ProtonCandiate, 0.938272}};
+
+  // hits of other modules with the same module_id are further away from the sensor plane
+  const double sensor_tolerance = 0.5;
+
+  /*!
+   * refraction of the unit vector dir at a surface with the unit normal
+   * against the photon, eta = n_before / n_after. false for total internal
+   * reflection
+   */
+  bool Refract(const double normal[3], const double eta, double dir[3])
+  {
+    const double cosi = -(normal[0] * dir[0] + normal[1] * dir[1] + normal[2] * dir[2]);
+    const double k = 1. - eta * eta * (1. - cosi * cosi);
+    if (k < 0)
+    {
+      return false;
+    }
+    const double a = eta * cosi - std::sqrt(k);
+    for (int i = 0; i < 3; i++)
+    {
+      dir[i] = eta * dir[i] + a * normal[i];
+    }
+    return true;
+  }
+}  // namespace
+
+PHG4mRICHRingReco::PHG4mRICHRingReco(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+int PHG4mRICHRingReco::InitRun(PHCompositeNode *topNode)
+{
+  const std::string geonodename = PHG4mRICHModuleGeom::NodeName(m_Detector);
+  m_Geom = findNode::getClass<PHG4mRICHModuleGeom>(topNode, geonodename);
+  if (!m_Geom)
+  {
+    std::cout << PHWHERE << " Could not locate module geometry node " << geonodename << std::endl;
+    exit(1);
+  }
+  if (m_NRadiusBins < 2 || m_NSlopeBins < 2 || m_NDepth < 1 || m_NPhi < 1)
+  {
+    std::cout << PHWHERE << " invalid binning of the lens response table or the ring" << std::endl;
+    exit(1);
+  }
+  BuildLensLUT();
+
+  m_PIDContainer = findNode::getClass<EICPIDParticleContainer>(topNode, "EICPIDParticleMap");
+  if (!m_PIDContainer)
+  {
+    PHNodeIterator iter(topNode);
+    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    if (!dstNode)
+    {
+      std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+      exit(1);
+    }
+    m_PIDContainer = new EICPIDParticleContainer();
+    dstNode->addNode(new PHIODataNode<PHObject>(m_PIDContainer, "EICPIDParticleMap", "PHObject"));
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4mRICHRingReco::process_event(PHCompositeNode *topNode)
+{
+  const std::string hitnodename = "G4HIT_" + m_Detector;
+  m_Hits = findNode::getClass<PHG4HitContainer>(topNode, hitnodename);
+  if (!m_Hits)
+  {
+    std::cout << PHWHERE << " Could not locate g4 hit node " << hitnodename << std::endl;
+    exit(1);
+  }
+  m_TrackMap = findNode::getClass<SvtxTrackMap>(topNode, m_TrackMapName);
+  if (!m_TrackMap)
+  {
+    std::cout << PHWHERE << " Could not locate track node " << m_TrackMapName << std::endl;
+    exit(1);
+  }
+
+  // the hits of a module are collected once for all its tracks
+  std::map<int, std::vector<SensorHit>> module_hits;
+  for (SvtxTrackMap::ConstIter iter = m_TrackMap->begin(); iter != m_TrackMap->end(); ++iter)
+  {
+    const SvtxTrack *track = iter->second;
+    double local_pos[3];
+    double local_dir[3];
+    double mom;
+    const int index = FindModule(track, local_pos, local_dir, mom);
+    if (index < 0)
+    {
+      continue;
+    }
+    auto hititer = module_hits.find(index);
+    if (hititer == module_hits.end())
+    {
+      hititer = module_hits.insert(std::make_pair(index, std::vector<SensorHit>())).first;
+      GetSensorHits(index, hititer->second);
+    }
+
+    EICPIDParticle *pidparticle = m_PIDContainer->findOrAddPIDParticle(track->get_id())->second;
+    for (const Hypothesis &hypo : hypotheses)
+    {
+      const double loglikelihood = LogLikelihood(local_pos, local_dir, mom, hypo.mass, hititer->second);
+      pidparticle->set_LogLikelyhood(hypo.candidate, EICPIDDefs::mRICH, loglikelihood);
+    }
+    if (Verbosity() > 1)
+    {
+      std::cout << Name() << ": track " << track->get_id() << " p = " << mom
+                << " GeV in module " << m_Geom->GetModule(index).module_id
+                << " with " << hititer->second.size() << " hits" << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void PHG4mRICHRingReco::BuildLensLUT()
+{
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  m_LensLUT.clear();
+  // skeleton setup without lens, photons go straight to the sensors
+  if (optics.groove_depth.empty())
+  {
+    return;
+  }
+
+  const int ngrooves = optics.groove_depth.size();
+  const double halfz = optics.lens_halfz;
+  const double width = optics.groove_width;
+  // from the flat face of the lens to the sensors
+  const double gap = optics.sensor_z - (optics.lens_z + halfz);
+
+  m_RadiusStep = std::sqrt(2.) * optics.lens_halfxy / (m_NRadiusBins - 1);
+  m_SlopeStep = 2. * m_MaxSlope / (m_NSlopeBins - 1);
+  m_LensLUT.assign(2 * m_NRadiusBins * m_NSlopeBins * m_NSlopeBins, NAN);
+
+  int ntransmitted = 0;
+  for (int ir = 0; ir < m_NRadiusBins; ir++)
+  {
+    const double rho = ir * m_RadiusStep;
+    for (int ia = 0; ia < m_NSlopeBins; ia++)
+    {
+      for (int it = 0; it < m_NSlopeBins; it++)
+      {
+        // photon at (rho, 0, -halfz) in the lens frame
+        double dir[3] = {-m_MaxSlope + ia * m_SlopeStep, -m_MaxSlope + it * m_SlopeStep, 1.};
+        const double norm = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+        for (double &d : dir)
+        {
+          d /= norm;
+        }
+
+        // groove surface under the photon, the grooves are narrow so the
+        // groove at the intersection is found after two iterations
+        double zsurf = -halfz;
+        double slope = 0;
+        double pos[3] = {rho, 0., -halfz};
+        bool lost = false;
+        for (int iter = 0; iter < 3; iter++)
+        {
+          const double t = (zsurf + halfz) / dir[2];
+          pos[0] = rho + t * dir[0];
+          pos[1] = t * dir[1];
+          pos[2] = zsurf;
+          const double r = std::sqrt(pos[0] * pos[0] + pos[1] * pos[1]);
+          const int igroove = r / width;
+          if (igroove >= ngrooves)
+          {
+            lost = true;
+            break;
+          }
+          const double depth = optics.groove_depth[igroove];
+          if (depth > 0)
+          {
+            slope = depth / width;
+            zsurf = -halfz + slope * (r - igroove * width);
+          }
+          else
+          {
+            slope = 0;
+            zsurf = halfz - optics.center_thickness;
+          }
+        }
+        if (lost)
+        {
+          continue;
+        }
+        const double t = (zsurf + halfz) / dir[2];
+        pos[0] = rho + t * dir[0];
+        pos[1] = t * dir[1];
+        pos[2] = zsurf;
+
+        // cone of the tooth, the normal points out of the lens towards -z
+        const double r = std::sqrt(pos[0] * pos[0] + pos[1] * pos[1]);
+        const double nnorm = std::sqrt(1. + slope * slope);
+        double normal[3] = {0., 0., -1. / nnorm};
+        if (r > 0)
+        {
+          normal[0] = slope * pos[0] / r / nnorm;
+          normal[1] = slope * pos[1] / r / nnorm;
+        }
+        if (!Refract(normal, 1. / optics.lens_index, dir) || dir[2] <= 0)
+        {
+          continue;
+        }
+
+        // flat face
+        const double tflat = (halfz - pos[2]) / dir[2];
+        pos[0] += tflat * dir[0];
+        pos[1] += tflat * dir[1];
+        const double flat[3] = {0., 0., -1.};
+        if (!Refract(flat, optics.lens_index, dir) || dir[2] <= 0)
+        {
+          continue;
+        }
+
+        const double tsensor = gap / dir[2];
+        const int bin = 2 * ((ir * m_NSlopeBins + ia) * m_NSlopeBins + it);
+        m_LensLUT[bin] = pos[0] + tsensor * dir[0];
+        m_LensLUT[bin + 1] = pos[1] + tsensor * dir[1];
+        ntransmitted++;
+      }
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": lens response table with " << m_NRadiusBins << " x " << m_NSlopeBins << " x " << m_NSlopeBins
+              << " nodes, " << ntransmitted << " transmitted" << std::endl;
+  }
+}
+
+bool PHG4mRICHRingReco::LensLookup(const double x, const double y, const double dir[3], double &sx, double &sy) const
+{
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  if (std::abs(x) > optics.lens_halfxy || std::abs(y) > optics.lens_halfxy || dir[2] <= 0)
+  {
+    return false;
+  }
+
+  // rotate the photon into the plane of the table
+  const double rho = std::sqrt(x * x + y * y);
+  const double c = (rho > 0) ? x / rho : 1.;
+  const double s = (rho > 0) ? y / rho : 0.;
+  const double radial = (dir[0] * c + dir[1] * s) / dir[2];
+  const double tangential = (-dir[0] * s + dir[1] * c) / dir[2];
+
+  const double coord[3] = {rho / m_RadiusStep, (radial + m_MaxSlope) / m_SlopeStep, (tangential + m_MaxSlope) / m_SlopeStep};
+  const int nbins[3] = {m_NRadiusBins, m_NSlopeBins, m_NSlopeBins};
+  int bin[3];
+  double frac[3];
+  for (int i = 0; i < 3; i++)
+  {
+    if (coord[i] < 0 || coord[i] >= nbins[i] - 1)
+    {
+      return false;
+    }
+    bin[i] = coord[i];
+    frac[i] = coord[i] - bin[i];
+  }
+
+  // trilinear interpolation, lost if any of the corners is lost
+  double pos[2] = {0., 0.};
+  for (int corner = 0; corner < 8; corner++)
+  {
+    double weight = 1.;
+    int node[3];
+    for (int i = 0; i < 3; i++)
+    {
+      const int up = (corner >> i) & 1;
+      node[i] = bin[i] + up;
+      weight *= up ? frac[i] : 1. - frac[i];
+    }
+    const int index = 2 * ((node[0] * m_NSlopeBins + node[1]) * m_NSlopeBins + node[2]);
+    if (std::isnan(m_LensLUT[index]))
+    {
+      return false;
+    }
+    pos[0] += weight * m_LensLUT[index];
+    pos[1] += weight * m_LensLUT[index + 1];
+  }
+
+  sx = pos[0] * c - pos[1] * s;
+  sy = pos[0] * s + pos[1] * c;
+  return true;
+}
+
+bool PHG4mRICHRingReco::PhotonToSensor(const double pos[3], const double dir[3], double &sx, double &sy) const
+{
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  if (dir[2] <= 0)
+  {
+    return false;
+  }
+
+  // downstream face of the aerogel
+  const double tagel = (optics.aerogel_z[1] - pos[2]) / dir[2];
+  double x = pos[0] + tagel * dir[0];
+  double y = pos[1] + tagel * dir[1];
+  if (std::abs(x) > optics.aerogel_halfxy || std::abs(y) > optics.aerogel_halfxy)
+  {
+    return false;
+  }
+  double d[3] = {dir[0], dir[1], dir[2]};
+  const double face[3] = {0., 0., -1.};
+  if (!Refract(face, optics.aerogel_index, d) || d[2] <= 0)
+  {
+    return false;
+  }
+
+  if (m_LensLUT.empty())
+  {
+    const double tsensor = (optics.sensor_z - optics.aerogel_z[1]) / d[2];
+    sx = x + tsensor * d[0];
+    sy = y + tsensor * d[1];
+  }
+  else
+  {
+    const double tlens = (optics.lens_z - optics.lens_halfz - optics.aerogel_z[1]) / d[2];
+    x += tlens * d[0];
+    y += tlens * d[1];
+    if (!LensLookup(x, y, d, sx, sy))
+    {
+      return false;
+    }
+  }
+
+  const double ax = std::abs(sx);
+  const double ay = std::abs(sy);
+  return ax > optics.sensor_inner && ax < optics.sensor_halfxy && ay > optics.sensor_inner && ay < optics.sensor_halfxy;
+}
+
+int PHG4mRICHRingReco::FindModule(const SvtxTrack *track, double local_pos[3], double local_dir[3], double &mom) const
+{
+  double pos[3] = {track->get_x(), track->get_y(), track->get_z()};
+  double dir[3] = {track->get_px(), track->get_py(), track->get_pz()};
+  for (SvtxTrack::ConstStateIter iter = track->begin_states(); iter != track->end_states(); ++iter)
+  {
+    const SvtxTrackState *state = iter->second;
+    if (state->get_name() == m_ProjectionName)
+    {
+      pos[0] = state->get_x();
+      pos[1] = state->get_y();
+      pos[2] = state->get_z();
+      dir[0] = state->get_px();
+      dir[1] = state->get_py();
+      dir[2] = state->get_pz();
+      break;
+    }
+  }
+  mom = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+  if (!(mom > 0))
+  {
+    return -1;
+  }
+  for (double &d : dir)
+  {
+    d /= mom;
+  }
+
+  // module closest along the track whose aerogel front face is crossed
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  int found = -1;
+  double mindist = std::numeric_limits<double>::max();
+  for (int i = 0; i < m_Geom->size(); i++)
+  {
+    const PHG4mRICHModuleGeom::Module &module = m_Geom->GetModule(i);
+    double lpos[3];
+    double ldir[3];
+    module.GlobalToLocal(pos, lpos);
+    module.GlobalToLocalDir(dir, ldir);
+    if (ldir[2] <= 0)
+    {
+      continue;
+    }
+    const double t = (optics.aerogel_z[0] - lpos[2]) / ldir[2];
+    const double x = lpos[0] + t * ldir[0];
+    const double y = lpos[1] + t * ldir[1];
+    if (std::abs(x) > optics.aerogel_halfxy || std::abs(y) > optics.aerogel_halfxy || std::abs(t) >= mindist)
+    {
+      continue;
+    }
+    found = i;
+    mindist = std::abs(t);
+    local_pos[0] = x;
+    local_pos[1] = y;
+    local_pos[2] = optics.aerogel_z[0];
+    for (int j = 0; j < 3; j++)
+    {
+      local_dir[j] = ldir[j];
+    }
+  }
+  return found;
+}
+
+void PHG4mRICHRingReco::GetSensorHits(const int index, std::vector<SensorHit> &sensorhits) const
+{
+  const PHG4mRICHModuleGeom::Module &module = m_Geom->GetModule(index);
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  // the stepping action stores the photons with the module_id as layer
+  PHG4HitContainer::ConstRange range = m_Hits->getHits(static_cast<unsigned int>(module.module_id));
+  for (PHG4HitContainer::ConstIterator hititer = range.first; hititer != range.second; ++hititer)
+  {
+    const PHG4Hit *hit = hititer->second;
+    const double global[3] = {hit->get_x(0), hit->get_y(0), hit->get_z(0)};
+    double local[3];
+    module.GlobalToLocal(global, local);
+    if (std::abs(local[2] - optics.sensor_z) > sensor_tolerance ||
+        std::abs(local[0]) > optics.sensor_halfxy || std::abs(local[1]) > optics.sensor_halfxy)
+    {
+      continue;
+    }
+    sensorhits.push_back({local[0], local[1]});
+  }
+}
+
+double PHG4mRICHRingReco::LogLikelihood(const double local_pos[3], const double local_dir[3], const double mom,
+                                        const double mass, const std::vector<SensorHit> &sensorhits) const
+{
+  const PHG4mRICHModuleGeom::Optics &optics = m_Geom->GetOptics();
+  const double beta = mom / std::sqrt(mom * mom + mass * mass);
+  const double cos_theta = 1. / (optics.aerogel_index * beta);
+
+  // predicted photons on the sensor plane, each one carries the same share of the yield
+  std::vector<SensorHit> ring;
+  double weight = 0;
+  if (cos_theta < 1.)
+  {
+    const double sin_theta = std::sqrt(1. - cos_theta * cos_theta);
+    const double path = (optics.aerogel_z[1] - optics.aerogel_z[0]) / local_dir[2];
+    weight = m_PhotonYield * path * sin_theta * sin_theta / (m_NDepth * m_NPhi);
+
+    // two unit vectors perpendicular to the track
+    double u[3] = {0., local_dir[2], -local_dir[1]};
+    if (std::abs(local_dir[0]) > 0.5)
+    {
+      u[0] = -local_dir[2];
+      u[1] = 0.;
+      u[2] = local_dir[0];
+    }
+    const double unorm = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+    for (double &c : u)
+    {
+      c /= unorm;
+    }
+    const double v[3] = {local_dir[1] * u[2] - local_dir[2] * u[1],
+                         local_dir[2] * u[0] - local_dir[0] * u[2],
+                         local_dir[0] * u[1] - local_dir[1] * u[0]};
+
+    ring.reserve(m_NDepth * m_NPhi);
+    for (int idepth = 0; idepth < m_NDepth; idepth++)
+    {
+      const double t = path * (idepth + 0.5) / m_NDepth;
+      const double emission[3] = {local_pos[0] + t * local_dir[0], local_pos[1] + t * local_dir[1], local_pos[2] + t * local_dir[2]};
+      for (int iphi = 0; iphi < m_NPhi; iphi++)
+      {
+        const double phi = 2. * M_PI * iphi / m_NPhi;
+        const double cphi = std::cos(phi) * sin_theta;
+        const double sphi = std::sin(phi) * sin_theta;
+        double photon[3];
+        for (int i = 0; i < 3; i++)
+        {
+          photon[i] = cos_theta * local_dir[i] + cphi * u[i] + sphi * v[i];
+        }
+        SensorHit point;
+        if (PhotonToSensor(emission, photon, point.x, point.y))
+        {
+          ring.push_back(point);
+        }
+      }
+    }
+  }
+
+  // extended likelihood: Poisson term of the expected number of hits and
+  // the density of every hit, predicted photons smeared with a 2d Gaussian
+  // on top of a flat background over the sensors
+  const double sensor_width = optics.sensor_halfxy - optics.sensor_inner;
+  const double background_density = m_Background / (4. * sensor_width * sensor_width);
+  const double sigma2 = m_HitResolution * m_HitResolution;
+  const double norm = weight / (2. * M_PI * sigma2);
+  const double maxdist2 = 25. * sigma2;
+
+  double loglikelihood = -(weight * ring.size() + m_Background);
+  for (const SensorHit &hit : sensorhits)
+  {
+    double density = background_density;
+    for (const SensorHit &point : ring)
+    {
+      const double dx = hit.x - point.x;
+      const double dy = hit.y - point.y;
+      const double dist2 = dx * dx + dy * dy;
+      if (dist2 < maxdist2)
+      {
+        density += norm * std::exp(-0.5 * dist2 / sigma2);
+      }
+    }
+    loglikelihood += std::log(density);
+  }
+  return loglikelihood;
+}
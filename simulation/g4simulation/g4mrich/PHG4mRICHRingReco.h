@@ -0,0 +1,123 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4MRICHRINGRECO_H
+#define G4DETECTORS_PHG4MRICHRINGRECO_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class EICPIDParticleContainer;
+class PHCompositeNode;
+class PHG4HitContainer;
+class PHG4mRICHModuleGeom;
+class SvtxTrack;
+class SvtxTrackMap;
+
+/**
+ * \brief mRICH particle identification from the photon hits
+ *
+ * Every track is extended as a straight line from its projection onto the
+ * mRICH (or from the vertex if there is none) to the aerogel of the module
+ * it crosses. For every mass hypothesis the Cherenkov photons are emitted
+ * at a few depths in the aerogel and a fixed set of azimuths, refracted
+ * into the air gap and mapped through the Fresnel lens onto the sensor
+ * plane with a lens response table. The table is generated at InitRun by
+ * tracing rays through the groove profile of the lens in MODULEGEOM_mRICH,
+ * using the rotational symmetry of the lens it only depends on the radius
+ * and the radial and tangential slope of the photon. The mirrors are not
+ * modeled, photons outside the lens or the sensors are lost.
+ *
+ * The predicted photons are smeared with a 2d Gaussian of the hit
+ * resolution on top of a flat background, and the extended log-likelihood
+ * of the hits of the module goes to EICPIDParticleMap. Only the hits with
+ * the module_id of the crossed module are read, so the cost is linear in
+ * the number of hits per module.
+ */
+class PHG4mRICHRingReco : public SubsysReco
+{
+ public:
+  PHG4mRICHRingReco(const std::string &name = "PHG4mRICHRingReco");
+  ~PHG4mRICHRingReco() override {}
+
+  //! builds the lens response table
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  /** Name of the detector, used for the hit and geometry nodes.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+  void set_trackmap_name(const std::string &name) { m_TrackMapName = name; }
+  //! name of the track state at the mRICH
+  void set_projection_name(const std::string &name) { m_ProjectionName = name; }
+
+  //! photoelectrons per cm of aerogel at sin^2(theta_c) = 1
+  void set_photon_yield(const double n) { m_PhotonYield = n; }
+  //! expected number of noise hits per module, > 0 keeps the likelihood of stray hits finite
+  void set_background(const double b) { m_Background = b; }
+  //! resolution (cm) of the photon hits on the sensor plane
+  void set_hit_resolution(const double s) { m_HitResolution = s; }
+  //! emission points along the track and around the cone
+  void set_ring_points(const int ndepth, const int nphi)
+  {
+    m_NDepth = ndepth;
+    m_NPhi = nphi;
+  }
+  //! nodes of the lens response table in radius and slope (|slope| < maxslope)
+  void set_lut_bins(const int nradius, const int nslope, const double maxslope)
+  {
+    m_NRadiusBins = nradius;
+    m_NSlopeBins = nslope;
+    m_MaxSlope = maxslope;
+  }
+
+ private:
+  struct SensorHit
+  {
+    double x;
+    double y;
+  };
+
+  //! radius, radial and tangential slope -> radial and tangential position on the sensor plane
+  void BuildLensLUT();
+  //! photon at the upstream plane of the lens (module frame), false if it is lost
+  bool LensLookup(const double x, const double y, const double dir[3], double &sx, double &sy) const;
+
+  //! photon through the aerogel exit, the air gap and the lens, false if it is not detected
+  bool PhotonToSensor(const double pos[3], const double dir[3], double &sx, double &sy) const;
+
+  //! module index and local entry point and direction, -1 if the track misses the mRICH
+  int FindModule(const SvtxTrack *track, double local_pos[3], double local_dir[3], double &mom) const;
+
+  void GetSensorHits(const int index, std::vector<SensorHit> &sensorhits) const;
+
+  double LogLikelihood(const double local_pos[3], const double local_dir[3], const double mom,
+                       const double mass, const std::vector<SensorHit> &sensorhits) const;
+
+  const PHG4mRICHModuleGeom *m_Geom = nullptr;
+  PHG4HitContainer *m_Hits = nullptr;
+  SvtxTrackMap *m_TrackMap = nullptr;
+  EICPIDParticleContainer *m_PIDContainer = nullptr;
+
+  std::string m_Detector = "mRICH";
+  std::string m_TrackMapName = "TrackMap";
+  std::string m_ProjectionName = "mRICH";
+
+  double m_PhotonYield = 60.;
+  double m_Background = 0.5;
+  double m_HitResolution = 0.25;
+  int m_NDepth = 3;
+  int m_NPhi = 48;
+
+  int m_NRadiusBins = 100;
+  int m_NSlopeBins = 61;
+  double m_MaxSlope = 0.6;
+  double m_RadiusStep = 0;
+  double m_SlopeStep = 0;
+  //! sensor position (radial, tangential) per node, NAN if the photon is lost
+  std::vector<float> m_LensLUT;
+};
+
+#endif  // G4DETECTORS_PHG4MRICHRINGRECO_H
@@ -0,0 +1,119 @@
+#include "PHG4mRICHStackingAction.h"
+
+#include "PHG4mRICHDetector.h"
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/PHRandomSeed.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <Geant4/G4OpticalPhoton.hh>
+#include <Geant4/G4PhysicalConstants.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4Track.hh>
+
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//____________________________________________________________________________..
+PHG4mRICHStackingAction::PHG4mRICHStackingAction(PHG4mRICHDetector* detector, PHParameters* params)
+  : PHG4StackingAction(detector->GetName())
+  , m_RandomGenerator(gsl_rng_alloc(gsl_rng_mt19937))
+  , detector_(detector)
+  , m_SafetyFactor(params->get_double_param("qe_safety_factor"))
+  , m_KeptPhotons(0)
+  , m_KilledPhotons(0)
+{
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+
+  // measured QE of the sensors, "wavelength(nm) QE" per line in increasing
+  // wavelength, resampled on a 1 nm grid
+  const std::string qefile = params->get_string_param("qe_file");
+  std::ifstream fin(qefile);
+  std::vector<double> lambda;
+  std::vector<double> qe;
+  std::string line;
+  while (std::getline(fin, line))
+  {
+    std::istringstream sline(line);
+    double l, q;
+    if (line.empty() || line[0] == '#' || !(sline >> l >> q))
+    {
+      continue;
+    }
+    lambda.push_back(l);
+    qe.push_back(q);
+  }
+  if (lambda.size() < 2)
+  {
+    std::cout << PHWHERE << " qe_culling needs the sensor QE in qe_file, cannot read \"" << qefile << "\"" << std::endl;
+    exit(1);
+  }
+  m_LambdaMin = std::ceil(lambda.front());
+  m_QE.resize(std::floor(lambda.back()) - m_LambdaMin + 1);
+  for (unsigned int i = 0; i < m_QE.size(); i++)
+  {
+    const double l = m_LambdaMin + i;
+    const unsigned int bin = std::min<unsigned int>(std::upper_bound(lambda.begin(), lambda.end(), l) - lambda.begin(), lambda.size() - 1) - 1;
+    m_QE[i] = qe[bin] + (qe[bin + 1] - qe[bin]) * (l - lambda[bin]) / (lambda[bin + 1] - lambda[bin]);
+  }
+}
+
+//____________________________________________________________________________..
+PHG4mRICHStackingAction::~PHG4mRICHStackingAction()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+//____________________________________________________________________________..
+double PHG4mRICHStackingAction::GetQE(double lambda) const
+{
+  int bin = std::lround(lambda) - m_LambdaMin;
+  if (bin < 0 || bin >= static_cast<int>(m_QE.size()))
+  {
+    return 0.;
+  }
+  return m_QE[bin];
+}
+
+//____________________________________________________________________________..
+G4ClassificationOfNewTrack PHG4mRICHStackingAction::ClassifyNewTrack(const G4Track* aTrack)
+{
+  if (aTrack->GetDefinition() != G4OpticalPhoton::OpticalPhotonDefinition())
+  {
+    return fUrgent;
+  }
+  if (!detector_->IsInmRICHRadiator(aTrack->GetVolume()))
+  {
+    return fUrgent;
+  }
+
+  double lambda = h_Planck * c_light / aTrack->GetTotalEnergy() / nm;
+  double prob = std::min(1., m_SafetyFactor * GetQE(lambda));
+  if (gsl_rng_uniform(m_RandomGenerator) >= prob)
+  {
+    m_KilledPhotons++;
+    return fKill;
+  }
+  m_KeptPhotons++;
+  return fUrgent;
+}
+
+//____________________________________________________________________________..
+void PHG4mRICHStackingAction::PrepareNewEvent()
+{
+  if (Verbosity())
+  {
+    std::cout << "PHG4mRICHStackingAction: optical photons kept: " << m_KeptPhotons
+              << ", killed: " << m_KilledPhotons << std::endl;
+  }
+  m_KeptPhotons = 0;
+  m_KilledPhotons = 0;
+}
@@ -0,0 +1,47 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4MRICHSTACKINGACTION_H
+#define G4DETECTORS_PHG4MRICHSTACKINGACTION_H
+
+#include <g4main/PHG4StackingAction.h>
+
+#include <Geant4/G4UserStackingAction.hh>
+
+#include <gsl/gsl_rng.h>
+
+#include <vector>
+
+class PHG4mRICHDetector;
+class PHParameters;
+
+//! kill optical photons produced in the mRICH according to the sensor QE,
+//! photons are kept with probability min(1, qe_safety_factor * QE(lambda))
+class PHG4mRICHStackingAction : public PHG4StackingAction
+{
+ public:
+  //! constructor
+  PHG4mRICHStackingAction(PHG4mRICHDetector* detector, PHParameters* params);
+
+  //! destructor
+  virtual ~PHG4mRICHStackingAction();
+
+  virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
+  virtual void PrepareNewEvent();
+
+  //! photon detection efficiency at wavelength (in nm)
+  double GetQE(double lambda) const;
+
+ private:
+  gsl_rng* m_RandomGenerator;
+  PHG4mRICHDetector* detector_;
+  double m_SafetyFactor;
+
+  //! QE from qe_file on a 1 nm grid starting at m_LambdaMin (nm)
+  std::vector<double> m_QE;
+  int m_LambdaMin = 0;
+
+  unsigned int m_KeptPhotons;
+  unsigned int m_KilledPhotons;
+};
+
+#endif  // G4DETECTORS_PHG4MRICHSTACKINGACTION_H
@@ -4,6 +4,7 @@
  *===============================================================*/
 #include "PHG4mRICHSubsystem.h"
 #include "PHG4mRICHDetector.h"
+#include "PHG4mRICHStackingAction.h"
 #include "PHG4mRICHSteppingAction.h"
 
 #include <phparameter/PHParameters.h>
@@ -11,6 +12,7 @@
 #include <g4detectors/PHG4EventActionClearZeroEdep.h>
 #include <g4main/PHG4EventAction.h>  // for PHG4EventAction
 #include <g4main/PHG4HitContainer.h>
+#include <g4main/PHG4StackingAction.h>  // for PHG4StackingAction
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
 #include <phool/PHCompositeNode.h>
@@ -34,6 +36,7 @@ PHG4mRICHSubsystem::PHG4mRICHSubsystem(const std::string& name, const int lyr)
   , _detectorName(name)
   , _steppingAction(nullptr)
   , _eventAction(nullptr)
+  , _stackingAction(nullptr)
 {
   InitializeParameters();
 }
@@ -101,6 +104,13 @@ int PHG4mRICHSubsystem::InitRunSubsystem(PHCompositeNode* topNode)
     // create stepping action
     _steppingAction = new PHG4mRICHSteppingAction(_detector, GetParams());
 
+    // kill photons which would not be detected right when they are created
+    if (GetParams()->get_int_param("qe_culling"))
+    {
+      _stackingAction = new PHG4mRICHStackingAction(_detector, GetParams());
+      _stackingAction->Verbosity(Verbosity());
+    }
+
     // event actions
     BOOST_FOREACH (std::string node, nodes)
     {
@@ -147,4 +157,11 @@ void PHG4mRICHSubsystem::SetDefaultParameters()
   set_default_double_param("eta_max", 1.9);
 
   set_default_int_param("use_g4steps", 0);  //for stepping function
+
+  set_default_int_param("analytic_lens", 0);  //1: Fresnel lens as one PHG4mRICHFresnelLens solid
+                                              //0: one polycone volume per groove
+
+  set_default_int_param("qe_culling", 0);           //kill photons at creation according to sensor QE (opt-in)
+  set_default_double_param("qe_safety_factor", 1.);  //photons kept with prob. min(1, factor*QE)
+  set_default_string_param("qe_file", "");           //sensor QE for the culling, "wavelength(nm) QE" per line
 }
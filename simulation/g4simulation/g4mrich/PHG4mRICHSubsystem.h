@@ -15,6 +15,7 @@ class PHCompositeNode;
 class PHG4mRICHDetector;
 class PHG4Detector;
 class PHG4EventAction;
+class PHG4StackingAction;
 class PHG4SteppingAction;
 
 class PHG4mRICHSubsystem : public PHG4DetectorSubsystem
@@ -48,6 +49,7 @@ class PHG4mRICHSubsystem : public PHG4DetectorSubsystem
   //! accessors (reimplemented)
   virtual PHG4Detector* GetDetector(void) const;
   virtual PHG4SteppingAction* GetSteppingAction(void) const { return _steppingAction; }
+  virtual PHG4StackingAction* GetStackingAction(void) const { return _stackingAction; }
 
   PHG4EventAction* GetEventAction() const { return _eventAction; }
 
@@ -66,6 +68,9 @@ class PHG4mRICHSubsystem : public PHG4DetectorSubsystem
   /*! derives from PHG4SteppingActions */
   PHG4SteppingAction* _steppingAction;
   PHG4EventAction* _eventAction;
+
+  //! QE culling of optical photons at creation
+  PHG4StackingAction* _stackingAction;
 };
 
 #endif
@@ -8,6 +8,7 @@
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4PVDivision.hh>
 #include <Geant4/G4PVPlacement.hh>
+#include <Geant4/G4Region.hh>
 #include <Geant4/G4RotationMatrix.hh>
 #include <Geant4/G4SystemOfUnits.hh>
 #include <Geant4/G4ThreeVector.hh>  // for G4ThreeVector
@@ -27,6 +28,8 @@ PHG4TRDDetector::PHG4TRDDetector(PHG4Subsystem *subsys, PHCompositeNode *Node, P
   , Phys(nullptr)
   , fPhysicsRadiator(nullptr)
   , TRD_det_Phys(nullptr)
+  , fRadRegion(nullptr)
+  , fRegGasDet(nullptr)
   , m_Layer(lyr)
 {
 }
@@ -133,10 +136,11 @@ void PHG4TRDDetector::ConstructMe(G4LogicalVolume *logicWorld)
   fLogicRadiator->SetVisAttributes(TRD_rad_att);
 
   fPhysicsRadiator = new G4PVPlacement(0, G4ThreeVector(0, 0, fRadZ), fLogicRadiator, "TRD_Radiator_Phys", Logic, 0, false, OverlapCheck());  // Placing the Radiator in global detector volume "Phys". Phys has been placed in world volume earlier
-                                                                                                                                              /*
-  G4Region *fRadRegion = new G4Region("XTRradiator");
+
+  // the parametrised XTR model in the stepping action is bound to this region
+  fRadRegion = new G4Region("XTRradiator_" + GetName());
   fRadRegion->AddRootLogicalVolume(fLogicRadiator);
-   */
+
   if (Verbosity() > 0) 
   {
     std::cout << " Rad CENTER  pos z :"
@@ -145,7 +149,7 @@ void PHG4TRDDetector::ConstructMe(G4LogicalVolume *logicWorld)
   }
   // Absorber (Xe gas with MPGD)
 
-  double det_ThicknessZ = 2.5 * cm;
+  double det_ThicknessZ = m_Params->get_double_param("det_ThicknessZ") * cm;
   double det_Pos_Z = fRadZ + fRadThick / 2. + det_ThicknessZ / 2.;
   G4Material *det_Material = G4Material::GetMaterial("G4_Xe");
 
@@ -169,8 +173,7 @@ void PHG4TRDDetector::ConstructMe(G4LogicalVolume *logicWorld)
   TRD_det_Phys = new G4PVPlacement(0, G4ThreeVector(0, 0, det_Pos_Z), TRD_det_Logic, "TRD_det_Phys", Logic, 0, false, OverlapCheck());  // Placing the MPGD with Xe in global detector volume "Phys". Phys has been placed in world volume earlier
 
   if (Verbosity() > 0) std::cout << " det RIN :" << det_RIn << " det ROUT :" << det_ROut << std::endl;
-  /*
-  G4Region * fRegGasDet = new G4Region("XTRdEdxDetector"); 
+
+  fRegGasDet = new G4Region("XTRdEdxDetector_" + GetName());
   fRegGasDet->AddRootLogicalVolume(TRD_det_Logic);
-  */
 }
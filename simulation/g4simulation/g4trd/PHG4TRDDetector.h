@@ -8,6 +8,7 @@
 #include <string>
 
 class G4LogicalVolume;
+class G4Region;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4Subsystem;
@@ -27,6 +28,10 @@ class PHG4TRDDetector : public PHG4Detector
   void ConstructMe(G4LogicalVolume *world) override;
 
   bool IsInTRD(const G4VPhysicalVolume *) const;
+  bool IsInRadiator(const G4VPhysicalVolume *volume) const { return volume == fPhysicsRadiator; }
+  bool IsInGas(const G4VPhysicalVolume *volume) const { return volume == TRD_det_Phys; }
+  G4Region *GetRadiatorRegion() const { return fRadRegion; }
+  G4Region *GetGasRegion() const { return fRegGasDet; }
   void SuperDetector(const std::string &name) { m_SuperDetector = name; }
   const std::string SuperDetector() const { return m_SuperDetector; }
   int get_Layer() const { return m_Layer; }
@@ -37,6 +42,8 @@ class PHG4TRDDetector : public PHG4Detector
   G4VPhysicalVolume *Phys;
   G4VPhysicalVolume *fPhysicsRadiator;
   G4VPhysicalVolume *TRD_det_Phys;
+  G4Region *fRadRegion;
+  G4Region *fRegGasDet;
 
   int m_Layer;
   std::string m_SuperDetector;
@@ -1,6 +1,7 @@
 #include "PHG4TRDSteppingAction.h"
 #include "PHG4TRDDetector.h"
 #include "PHG4TRDSubsystem.h"
+#include "PHG4TRDXTRModel.h"
 
 //#include "PHG4StepStatusDecode.h"
 
@@ -16,7 +17,12 @@
 
 #include <phool/getClass.h>
 
+#include <Geant4/G4AffineTransform.hh>
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4NavigationHistory.hh>
 #include <Geant4/G4ParticleDefinition.hh>      // for G4ParticleDefinition
+#include <Geant4/G4PhysicalConstants.hh>
 #include <Geant4/G4ReferenceCountedHandle.hh>  // for G4ReferenceCountedHandle
 #include <Geant4/G4Step.hh>
 #include <Geant4/G4StepPoint.hh>   // for G4StepPoint
@@ -28,6 +34,7 @@
 #include <Geant4/G4TrackStatus.hh>            // for fStopAndKill
 #include <Geant4/G4Types.hh>                  // for G4double
 #include <Geant4/G4VPhysicalVolume.hh>        // for G4VPhysicalVolume
+#include <Geant4/G4VSolid.hh>
 #include <Geant4/G4VTouchable.hh>             // for G4VTouchable
 #include <Geant4/G4VUserTrackInformation.hh>  // for G4VUserTrackInformation
 
@@ -58,12 +65,19 @@ PHG4TRDSteppingAction::PHG4TRDSteppingAction(PHG4TRDSubsystem* subsys, PHG4TRDDe
   , m_BlackHoleFlag(m_Params->get_int_param("blackhole"))
   , m_ActiveFlag(m_Params->get_int_param("active"))
   , m_UseG4StepsFlag(m_Params->get_int_param("use_g4steps"))
+  , m_XTRModel(nullptr)
+  , m_XTRTrackId(-1)
+  , m_XTRPathLength(0.)
   , m_Zmin(m_Params->get_double_param("PosZ") * cm - m_Params->get_double_param("ThicknessZ") * cm / 2.)
   , m_Zmax(m_Params->get_double_param("PosZ") * cm + m_Params->get_double_param("ThicknessZ") * cm / 2.)
   //, m_EdepSum(0)
 {
   m_Zmin -= copysign(m_Zmin, 1. / 1e6 * cm);
   m_Zmax += copysign(m_Zmax, 1. / 1e6 * cm);
+  if (m_ActiveFlag && m_Params->get_int_param("xtr_model"))
+  {
+    m_XTRModel = new PHG4TRDXTRModel(m_Params);
+  }
 }
 
 PHG4TRDSteppingAction::~PHG4TRDSteppingAction()
@@ -73,6 +87,7 @@ PHG4TRDSteppingAction::~PHG4TRDSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  delete m_XTRModel;
 }
 
 //____________________________________________________________________________..
@@ -122,6 +137,28 @@ bool PHG4TRDSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     //       G4ParticleDefinition* def = aTrack->GetDefinition();
     //       std::cout << "Particle: " << def->GetParticleName() << std::endl;
     int prepointstatus = prePoint->GetStepStatus();
+    // the XTR of a charged track is generated from its path length in the
+    // radiator region once it enters the Xe gas
+    if (m_XTRModel && !geantino && aTrack->GetDefinition()->GetPDGCharge() != 0)
+    {
+      if (volume->GetLogicalVolume()->GetRegion() == m_Detector->GetRadiatorRegion())
+      {
+        if (aTrack->GetTrackID() != m_XTRTrackId)
+        {
+          m_XTRTrackId = aTrack->GetTrackID();
+          m_XTRPathLength = 0.;
+        }
+        m_XTRPathLength += aStep->GetStepLength();
+      }
+      else if (prepointstatus == fGeomBoundary &&
+               aTrack->GetTrackID() == m_XTRTrackId &&
+               m_Detector->IsInGas(volume))
+      {
+        MakeXTRHits(aStep, layer_id);
+        m_XTRTrackId = -1;
+        m_XTRPathLength = 0.;
+      }
+    }
     if (prepointstatus == fGeomBoundary ||
         prepointstatus == fUndefined ||
         (prepointstatus == fPostStepDoItProc && m_SavePostStepStatus == fGeomBoundary) ||
@@ -133,12 +170,19 @@ bool PHG4TRDSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
       }
 
       m_Hit->set_layer((unsigned int) layer_id);
+      m_Hit->set_index_i(m_Detector->IsInRadiator(volume) ? kRadiator : kGas);
 
       //here we set the entrance values in cm
       m_Hit->set_x(0, prePoint->GetPosition().x() / cm);
       m_Hit->set_y(0, prePoint->GetPosition().y() / cm);
       m_Hit->set_z(0, prePoint->GetPosition().z() / cm);
 
+      // local coordinates are needed for the drift in the digitizer
+      G4ThreeVector localpos = touch->GetHistory()->GetTopTransform().TransformPoint(prePoint->GetPosition());
+      m_Hit->set_local_x(0, localpos.x() / cm);
+      m_Hit->set_local_y(0, localpos.y() / cm);
+      m_Hit->set_local_z(0, localpos.z() / cm);
+
       m_Hit->set_px(0, prePoint->GetMomentum().x() / GeV);
       m_Hit->set_py(0, prePoint->GetMomentum().y() / GeV);
       m_Hit->set_pz(0, prePoint->GetMomentum().z() / GeV);
@@ -215,6 +259,12 @@ bool PHG4TRDSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
     m_Hit->set_y(1, postPoint->GetPosition().y() / cm);
     m_Hit->set_z(1, postPoint->GetPosition().z() / cm);
 
+    // the post step point can be on the boundary, use the transformation of the pre step volume
+    G4ThreeVector localpos = touch->GetHistory()->GetTopTransform().TransformPoint(postPoint->GetPosition());
+    m_Hit->set_local_x(1, localpos.x() / cm);
+    m_Hit->set_local_y(1, localpos.y() / cm);
+    m_Hit->set_local_z(1, localpos.z() / cm);
+
     m_Hit->set_px(1, postPoint->GetMomentum().x() / GeV);
     m_Hit->set_py(1, postPoint->GetMomentum().y() / GeV);
     m_Hit->set_pz(1, postPoint->GetMomentum().z() / GeV);
@@ -280,6 +330,88 @@ bool PHG4TRDSteppingAction::UserSteppingAction(const G4Step* aStep, bool)
   }
 }
 
+//____________________________________________________________________________..
+void PHG4TRDSteppingAction::MakeXTRHits(const G4Step* aStep, const int layer_id)
+{
+  const G4Track* aTrack = aStep->GetTrack();
+  const G4double mass = aTrack->GetDefinition()->GetPDGMass();
+  if (mass <= 0)
+  {
+    return;
+  }
+  G4StepPoint* prePoint = aStep->GetPreStepPoint();
+  const int nphotons = m_XTRModel->SamplePhotons(prePoint->GetTotalEnergy() / mass, m_XTRPathLength);
+  if (nphotons <= 0)
+  {
+    return;
+  }
+
+  // XTR is emitted within ~1/gamma of the track direction, the photons
+  // are taken collinear with the track
+  G4TouchableHandle touch = prePoint->GetTouchableHandle();
+  const G4AffineTransform& transform = touch->GetHistory()->GetTopTransform();
+  const G4ThreeVector direction = prePoint->GetMomentumDirection();
+  const G4ThreeVector localpos = transform.TransformPoint(prePoint->GetPosition());
+  const G4ThreeVector localdir = transform.TransformAxis(direction);
+  const double maxdepth = touch->GetSolid()->DistanceToOut(localpos, localdir);
+  const double density = prePoint->GetMaterial()->GetDensity();
+
+  PHG4Shower* shower = nullptr;
+  int trkid = aTrack->GetTrackID();
+  if (G4VUserTrackInformation* p = aTrack->GetUserInformation())
+  {
+    if (PHG4TrackUserInfoV1* pp = dynamic_cast<PHG4TrackUserInfoV1*>(p))
+    {
+      trkid = pp->GetUserTrackId();
+      shower = pp->GetShower();
+    }
+  }
+
+  for (int i = 0; i < nphotons; i++)
+  {
+    const double energy = m_XTRModel->SampleEnergy();
+    const double depth = m_XTRModel->SampleAbsorptionDepth(energy, density);
+    if (depth > maxdepth)
+    {
+      // photon leaves the gas
+      continue;
+    }
+    const G4ThreeVector pos = prePoint->GetPosition() + depth * direction;
+    const G4ThreeVector lpos = localpos + depth * localdir;
+    const G4ThreeVector mom = energy * direction;
+
+    PHG4Hit* hit = new PHG4Hitv1();
+    hit->set_layer((unsigned int) layer_id);
+    hit->set_index_i(kXTR);
+    // photo-absorption is point like, entry and exit are the same
+    for (int j = 0; j < 2; j++)
+    {
+      hit->set_x(j, pos.x() / cm);
+      hit->set_y(j, pos.y() / cm);
+      hit->set_z(j, pos.z() / cm);
+      hit->set_local_x(j, lpos.x() / cm);
+      hit->set_local_y(j, lpos.y() / cm);
+      hit->set_local_z(j, lpos.z() / cm);
+      hit->set_px(j, mom.x() / GeV);
+      hit->set_py(j, mom.y() / GeV);
+      hit->set_pz(j, mom.z() / GeV);
+      hit->set_t(j, (prePoint->GetGlobalTime() + depth / c_light) / nanosecond);
+    }
+    hit->set_trkid(trkid);
+    hit->set_edep(energy / GeV);
+    hit->set_eion(energy / GeV);
+    if (shower)
+    {
+      hit->set_shower_id(shower->get_id());
+    }
+    m_HitContainer->AddHit(layer_id, hit);
+    if (shower)
+    {
+      shower->add_g4hit_id(m_HitContainer->GetID(), hit->get_hit_id());
+    }
+  }
+}
+
 //____________________________________________________________________________..
 void PHG4TRDSteppingAction::SetInterfacePointers(PHCompositeNode* topNode)
 {
@@ -12,6 +12,7 @@ class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4TRDDetector;
 class PHG4TRDSubsystem;
+class PHG4TRDXTRModel;
 class PHG4Hit;
 class PHG4HitContainer;
 class PHG4Shower;
@@ -20,6 +21,14 @@ class PHParameters;
 class PHG4TRDSteppingAction : public PHG4SteppingAction
 {
  public:
+  //! where a hit was made, stored as index_i of the G4Hit
+  enum HitType
+  {
+    kRadiator = 0,
+    kGas = 1,
+    kXTR = 2
+  };
+
   //! constructor
   PHG4TRDSteppingAction(PHG4TRDSubsystem *subsys, PHG4TRDDetector *detector, const PHParameters *parameters);
 
@@ -41,6 +50,9 @@ class PHG4TRDSteppingAction : public PHG4SteppingAction
   void HitNodeName(const std::string &name) { m_HitNodeName = name; }
 
  private:
+  //! absorb the XTR photons of a track entering the Xe gas
+  void MakeXTRHits(const G4Step *aStep, const int layer_id);
+
   //! Pointer to subsystem
   PHG4TRDSubsystem *m_Subsystem;
   //! pointer to the detector
@@ -61,6 +73,12 @@ class PHG4TRDSteppingAction : public PHG4SteppingAction
   int m_BlackHoleFlag;
   int m_ActiveFlag;
   int m_UseG4StepsFlag;
+
+  //! parametrised XTR, nullptr if disabled
+  PHG4TRDXTRModel *m_XTRModel;
+  //! track and path length of the last track in the radiator region
+  int m_XTRTrackId;
+  double m_XTRPathLength;
   double m_Zmin;
   double m_Zmax;
   //double m_EdepSum;
@@ -100,8 +100,17 @@ void PHG4TRDSubsystem::SetDefaultParameters()
   set_default_double_param("PosZ", 30.);
   set_default_double_param("det_RIn", 20.);
   set_default_double_param("det_ROut", 200.);
+  set_default_double_param("det_ThicknessZ", 2.5);  // Xe gas, also the drift length of the digitizer
   set_default_int_param("use_g4steps", 1);
 
+  // parametrised transition radiation from the radiator region
+  set_default_int_param("xtr_model", 0);
+  set_default_double_param("xtr_yield_per_cm", 0.1);  // saturated photon yield per cm radiator
+  set_default_double_param("xtr_gamma_half", 2000.);  // gamma at half the saturated yield
+  set_default_double_param("xtr_mean_energy", 12.);   // keV
+  set_default_double_param("xtr_emin", 3.);           // keV
+  set_default_double_param("xtr_emax", 40.);          // keV
+
   // place holder, will be replaced by world material if not set by other means (macro)
   set_default_string_param("material", "G4_AIR");
 }
@@ -0,0 +1,92 @@
+#include "PHG4TRDXTRModel.h"
+
+#include <phparameter/PHParameters.h>
+
+#include <phool/PHRandomSeed.h>
+
+#include <Geant4/G4SystemOfUnits.hh>
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // Xe mass attenuation coefficient (cm2/g) vs photon energy (keV), approximate
+  // NIST XCOM values. The K edge at 34.56 keV is entered twice, upper_bound
+  // picks the segment above the edge for energies at the edge
+  const double xe_energy[] = {6., 8., 10., 15., 20., 30., 34.56, 34.56, 40., 50.};
+  const double xe_mu_rho[] = {517., 245., 137., 45.6, 20.9, 6.95, 4.8, 31.6, 21.6, 11.9};
+  const int xe_npoints = sizeof(xe_energy) / sizeof(xe_energy[0]);
+
+  // shape of the gamma distribution used for the photon energy
+  const double xtr_energy_shape = 3.;
+}  // namespace
+
+PHG4TRDXTRModel::PHG4TRDXTRModel(const PHParameters *parameters)
+  : m_YieldPerCm(parameters->get_double_param("xtr_yield_per_cm"))
+  , m_GammaHalf(parameters->get_double_param("xtr_gamma_half"))
+  , m_MeanEnergy(parameters->get_double_param("xtr_mean_energy") * keV)
+  , m_Emin(parameters->get_double_param("xtr_emin") * keV)
+  , m_Emax(parameters->get_double_param("xtr_emax") * keV)
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+}
+
+PHG4TRDXTRModel::~PHG4TRDXTRModel()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+double PHG4TRDXTRModel::MeanPhotons(const double gamma, const double pathlength) const
+{
+  // the yield switches on around gamma ~ m_GammaHalf and saturates above,
+  // pions below ~100 GeV stay far below threshold
+  const double x2 = (gamma / m_GammaHalf) * (gamma / m_GammaHalf);
+  return m_YieldPerCm * (pathlength / cm) * x2 / (1. + x2);
+}
+
+int PHG4TRDXTRModel::SamplePhotons(const double gamma, const double pathlength)
+{
+  const double mean = MeanPhotons(gamma, pathlength);
+  if (mean <= 0)
+  {
+    return 0;
+  }
+  return gsl_ran_poisson(m_RandomGenerator, mean);
+}
+
+double PHG4TRDXTRModel::SampleEnergy()
+{
+  double energy = m_MeanEnergy;
+  // the tails of the gamma distribution are outside the XTR range, resample
+  for (int i = 0; i < 100; i++)
+  {
+    energy = gsl_ran_gamma(m_RandomGenerator, xtr_energy_shape, m_MeanEnergy / xtr_energy_shape);
+    if (energy >= m_Emin && energy <= m_Emax)
+    {
+      break;
+    }
+  }
+  return std::min(std::max(energy, m_Emin), m_Emax);
+}
+
+double PHG4TRDXTRModel::AbsorptionLength(const double energy, const double density) const
+{
+  // log-log interpolation in the table, the first/last segment is
+  // used to extrapolate outside of it
+  const double e = energy / keV;
+  int i = std::upper_bound(xe_energy, xe_energy + xe_npoints, e) - xe_energy;
+  i = std::min(std::max(i, 1), xe_npoints - 1);
+  const double slope = std::log(xe_mu_rho[i] / xe_mu_rho[i - 1]) / std::log(xe_energy[i] / xe_energy[i - 1]);
+  const double mu_rho = xe_mu_rho[i - 1] * std::pow(e / xe_energy[i - 1], slope) * cm2 / g;
+  return 1. / (mu_rho * density);
+}
+
+double PHG4TRDXTRModel::SampleAbsorptionDepth(const double energy, const double density)
+{
+  return gsl_ran_exponential(m_RandomGenerator, AbsorptionLength(energy, density));
+}
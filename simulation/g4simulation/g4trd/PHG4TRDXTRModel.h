@@ -0,0 +1,50 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4DETECTORS_PHG4TRDXTRMODEL_H
+#define G4DETECTORS_PHG4TRDXTRMODEL_H
+
+#include <gsl/gsl_rng.h>
+
+class PHParameters;
+
+/*!
+ * \brief fast parametrised transition radiation model for the TRD radiator
+ *
+ * Instead of running the G4 XTR processes the number of XTR photons is taken
+ * from a yield which saturates with the Lorentz factor of the particle and
+ * scales with the radiator path length. Photon energies are sampled from a
+ * gamma distribution, the photo-absorption length uses the Xe attenuation
+ * coefficients. All energies/lengths are in G4 units.
+ */
+class PHG4TRDXTRModel
+{
+ public:
+  explicit PHG4TRDXTRModel(const PHParameters *parameters);
+  ~PHG4TRDXTRModel();
+
+  //! mean number of XTR photons for Lorentz factor gamma after pathlength of radiator
+  double MeanPhotons(const double gamma, const double pathlength) const;
+
+  //! poisson sampled number of XTR photons
+  int SamplePhotons(const double gamma, const double pathlength);
+
+  //! photon energy
+  double SampleEnergy();
+
+  //! photo-absorption length in Xe of given density
+  double AbsorptionLength(const double energy, const double density) const;
+
+  //! depth at which the photon is absorbed
+  double SampleAbsorptionDepth(const double energy, const double density);
+
+ private:
+  gsl_rng *m_RandomGenerator = nullptr;
+
+  double m_YieldPerCm;
+  double m_GammaHalf;
+  double m_MeanEnergy;
+  double m_Emin;
+  double m_Emax;
+};
+
+#endif
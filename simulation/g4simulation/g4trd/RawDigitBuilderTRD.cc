@@ -0,0 +1,274 @@
+#include "RawDigitBuilderTRD.h"
+
+#include "PHG4TRDSteppingAction.h"
+
+#include <trackbase/TrkrClusterContainerv3.h>
+#include <trackbase/TrkrClusterv2.h>
+#include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSet.h>
+#include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitv2.h>
+
+#include <g4main/PHG4Hit.h>
+#include <g4main/PHG4HitContainer.h>
+
+#include <phparameter/PHParameters.h>
+
+#include <pdbcalbase/PdbParameterMap.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>  // for PHNode
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>  // for PHObject
+#include <phool/PHRandomSeed.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <memory>
+
+namespace
+{
+  // mean energy per electron-ion pair in Xe (keV)
+  const double xe_w_value = 0.022;
+  // 10 bit adc
+  const double adc_max = 1023.;
+}  // namespace
+
+RawDigitBuilderTRD::RawDigitBuilderTRD(const std::string &name)
+  : SubsysReco(name)
+{
+  m_RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+  gsl_rng_set(m_RandomGenerator, PHRandomSeed());
+}
+
+RawDigitBuilderTRD::~RawDigitBuilderTRD()
+{
+  gsl_rng_free(m_RandomGenerator);
+}
+
+int RawDigitBuilderTRD::InitRun(PHCompositeNode *topNode)
+{
+  const std::string paramnodename = "G4GEOPARAM_" + m_Detector;
+  PdbParameterMap *saveparams = findNode::getClass<PdbParameterMap>(topNode, paramnodename);
+  if (!saveparams)
+  {
+    std::cout << PHWHERE << " Could not locate geometry parameter node " << paramnodename << std::endl;
+    exit(1);
+  }
+  PHParameters params(m_Detector);
+  params.FillFrom(saveparams);
+  m_DriftLength = params.get_double_param("det_ThicknessZ");
+  if (!(m_DriftLength > 0))
+  {
+    std::cout << PHWHERE << " invalid gas thickness " << m_DriftLength << " in " << paramnodename << std::endl;
+    exit(1);
+  }
+
+  const int nrows = std::ceil((m_Rmax - m_Rmin) / m_PadPitch);
+  if (nrows > 256 || m_NPhiPads > 65536 || m_NTimeBins > 65536)
+  {
+    std::cout << PHWHERE << " pad rows (" << nrows << "), phi pads (" << m_NPhiPads
+              << ") or time bins (" << m_NTimeBins << ") do not fit into the hit keys" << std::endl;
+    exit(1);
+  }
+  CreateNodes(topNode);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int RawDigitBuilderTRD::process_event(PHCompositeNode *topNode)
+{
+  std::string NodeNameHits = "G4HIT_" + m_Detector;
+  PHG4HitContainer *g4hits = findNode::getClass<PHG4HitContainer>(topNode, NodeNameHits);
+  if (!g4hits)
+  {
+    std::cout << PHWHERE << " Could not locate g4 hit node " << NodeNameHits << std::endl;
+    exit(1);
+  }
+
+  m_PadSignals.clear();
+
+  // sub steps short compared to the pad size and the drift per time bin
+  const double substep = 0.5 * std::min(m_PadPitch, m_DriftVelocity * m_TimeBinWidth);
+
+  PHG4HitContainer::ConstRange hit_begin_end = g4hits->getHits();
+  for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+  {
+    PHG4Hit *g4hit = hiter->second;
+    if (g4hit->get_index_i() == PHG4TRDSteppingAction::kRadiator || g4hit->get_edep() <= 0)
+    {
+      continue;
+    }
+    // the gas volume is not rotated, local and global z only differ by an offset
+    const double zoffset = g4hit->get_z(0) - g4hit->get_local_z(0);
+    const double dx = g4hit->get_x(1) - g4hit->get_x(0);
+    const double dy = g4hit->get_y(1) - g4hit->get_y(0);
+    const double dz = g4hit->get_local_z(1) - g4hit->get_local_z(0);
+    const double dt = g4hit->get_t(1) - g4hit->get_t(0);
+    const double length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const int nsub = std::min(1000, std::max(1, (int) std::ceil(length / substep)));
+    for (int i = 0; i < nsub; i++)
+    {
+      const double frac = (i + 0.5) / nsub;
+      AddDeposit(g4hit->get_x(0) + frac * dx,
+                 g4hit->get_y(0) + frac * dy,
+                 g4hit->get_local_z(0) + frac * dz,
+                 zoffset,
+                 g4hit->get_t(0) + frac * dt,
+                 g4hit->get_edep() / nsub);
+    }
+  }
+
+  MakeHitsAndClusters();
+
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << m_PadSignals.size() << " pads with signal, "
+              << m_Clusters->size() << " clusters" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void RawDigitBuilderTRD::AddDeposit(const double x, const double y, const double localz, const double zoffset, const double t, const double edep)
+{
+  const double r = std::sqrt(x * x + y * y);
+  if (r < m_Rmin || r >= m_Rmax)
+  {
+    return;
+  }
+  const int row = (r - m_Rmin) / m_PadPitch;
+  double phi = std::atan2(y, x);
+  if (phi < 0)
+  {
+    phi += 2. * M_PI;
+  }
+  const int phibin = std::min(m_NPhiPads - 1, (int) (phi / (2. * M_PI) * m_NPhiPads));
+
+  // electrons drift to the readout at the downstream face of the gas
+  const double drift = std::max(0., 0.5 * m_DriftLength - localz);
+  const int tbin = std::floor((t + drift / m_DriftVelocity) / m_TimeBinWidth);
+  if (tbin < 0 || tbin >= m_NTimeBins)
+  {
+    return;
+  }
+
+  const unsigned int nelectrons = gsl_ran_poisson(m_RandomGenerator, edep * 1e6 / xe_w_value);
+  if (!nelectrons)
+  {
+    return;
+  }
+  PadSignal &pad = m_PadSignals[row * m_NPhiPads + phibin];
+  if (pad.energy.empty())
+  {
+    pad.energy.resize(m_NTimeBins, 0.);
+    pad.zoffset = zoffset;
+  }
+  pad.energy[tbin] += nelectrons * xe_w_value;
+}
+
+void RawDigitBuilderTRD::MakeHitsAndClusters()
+{
+  unsigned int clusid = 0;
+  std::vector<unsigned int> adc(m_NTimeBins);
+  for (auto &iter : m_PadSignals)
+  {
+    const int row = iter.first / m_NPhiPads;
+    const int phibin = iter.first % m_NPhiPads;
+    const PadSignal &pad = iter.second;
+
+    TrkrDefs::hitsetkey hitsetkey = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::micromegasId, row);
+    TrkrHitSetContainer::ConstIterator hitset = m_HitSets->findOrAddHitSet(hitsetkey);
+
+    for (int tbin = 0; tbin < m_NTimeBins; tbin++)
+    {
+      double signal = pad.energy[tbin] * m_AdcPerKeV + gsl_ran_gaussian(m_RandomGenerator, m_AdcNoise);
+      signal = std::min(adc_max, std::max(0., signal));
+      adc[tbin] = (signal < m_AdcThreshold) ? 0 : (unsigned int) signal;
+      if (adc[tbin])
+      {
+        TrkrDefs::hitkey hitkey = (phibin << 16) | tbin;
+        TrkrHitv2 *hit = new TrkrHitv2();
+        hit->setAdc(adc[tbin]);
+        hitset->second->addHitSpecificKey(hitkey, hit);
+      }
+    }
+
+    // cluster counting: every run of time bins above threshold is one cluster,
+    // XTR photons show up as clusters with large charge
+    const double r = m_Rmin + (row + 0.5) * m_PadPitch;
+    const double phi = (phibin + 0.5) * 2. * M_PI / m_NPhiPads;
+    unsigned int sumadc = 0;
+    double sumtime = 0.;
+    for (int tbin = 0; tbin <= m_NTimeBins; tbin++)
+    {
+      if (tbin < m_NTimeBins && adc[tbin] > m_ClusterThreshold)
+      {
+        sumadc += adc[tbin];
+        sumtime += adc[tbin] * (tbin + 0.5) * m_TimeBinWidth;
+        continue;
+      }
+      if (!sumadc)
+      {
+        continue;
+      }
+      auto clus = std::make_unique<TrkrClusterv2>();
+      TrkrDefs::cluskey key = hitsetkey;
+      key = (key << TrkrDefs::kBitShiftClusId) | clusid;
+      clus->setClusKey(key);
+      clus->setPosition(0, r * std::cos(phi));
+      clus->setPosition(1, r * std::sin(phi));
+      clus->setPosition(2, pad.zoffset + 0.5 * m_DriftLength - m_DriftVelocity * sumtime / sumadc);
+      clus->setGlobal();
+      clus->setAdc(sumadc);
+      m_Clusters->addCluster(clus.release());
+      clusid++;
+      sumadc = 0;
+      sumtime = 0.;
+    }
+  }
+}
+
+void RawDigitBuilderTRD::CreateNodes(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
+    exit(1);
+  }
+  PHNodeIterator dstiter(dstNode);
+  PHCompositeNode *DetNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+  if (!DetNode)
+  {
+    DetNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(DetNode);
+  }
+
+  std::string nodename = "TRKR_HITSET_" + m_Detector;
+  m_HitSets = findNode::getClass<TrkrHitSetContainer>(DetNode, nodename);
+  if (!m_HitSets)
+  {
+    m_HitSets = new TrkrHitSetContainerv1();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_HitSets, nodename, "PHObject"));
+  }
+
+  nodename = "TRKR_CLUSTER_" + m_Detector;
+  m_Clusters = findNode::getClass<TrkrClusterContainer>(DetNode, nodename);
+  if (!m_Clusters)
+  {
+    m_Clusters = new TrkrClusterContainerv3();
+    DetNode->addNode(new PHIODataNode<PHObject>(m_Clusters, nodename, "PHObject"));
+  }
+  return;
+}
@@ -0,0 +1,115 @@
+#ifndef G4TRD_RAWDIGITBUILDERTRD_H
+#define G4TRD_RAWDIGITBUILDERTRD_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <gsl/gsl_rng.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+class TrkrClusterContainer;
+class TrkrHitSetContainer;
+
+/**
+ * \brief SubsysReco module turning the TRD G4Hits in the Xe gas into
+ * time binned drift signals on r-phi pads and counting the ionization
+ * clusters on each pad
+ *
+ * The energy of each G4Hit (dE/dx and absorbed XTR photons) is converted
+ * to primary electrons which drift along z to the readout at the downstream
+ * face of the gas volume, the drift length is the gas thickness saved by
+ * the subsystem in G4GEOPARAM_<detector>. Output nodes:
+ *  - TRKR_HITSET_<detector>: one hitset per pad row (micromegas id, layer = row),
+ *    hitkey = (phi pad << 16) | time bin, adc per time bin
+ *  - TRKR_CLUSTER_<detector>: one cluster per run of time bins above the
+ *    cluster threshold on a pad, z from the drift time, adc = summed charge
+ */
+class RawDigitBuilderTRD : public SubsysReco
+{
+ public:
+  RawDigitBuilderTRD(const std::string &name = "RawDigitBuilderTRD");
+  ~RawDigitBuilderTRD() override;
+
+  //! run initialization
+  int InitRun(PHCompositeNode *topNode) override;
+
+  //! event processing
+  int process_event(PHCompositeNode *topNode) override;
+
+  /** Name of the detector node the G4Hits should be taken from.
+   */
+  void Detector(const std::string &d) { m_Detector = d; }
+
+  //! drift velocity (cm/ns)
+  void set_drift_velocity(const double v) { m_DriftVelocity = v; }
+  //! time binning of the drift signal (ns)
+  void set_time_bins(const int nbins, const double width)
+  {
+    m_NTimeBins = nbins;
+    m_TimeBinWidth = width;
+  }
+  //! pad rows between rmin and rmax (cm) with given pitch, nphi pads per row
+  void set_pads(const double rmin, const double rmax, const double pitch, const int nphi)
+  {
+    m_Rmin = rmin;
+    m_Rmax = rmax;
+    m_PadPitch = pitch;
+    m_NPhiPads = nphi;
+  }
+  //! adc counts per keV, noise and zero suppression in adc counts
+  void set_adc(const double adc_per_kev, const double noise, const double threshold)
+  {
+    m_AdcPerKeV = adc_per_kev;
+    m_AdcNoise = noise;
+    m_AdcThreshold = threshold;
+  }
+  //! time bins with more than this adc make up a cluster
+  void set_cluster_threshold(const double adc) { m_ClusterThreshold = adc; }
+
+ private:
+  //! time binned signal (keV) of one pad and the global z of the local gas frame
+  struct PadSignal
+  {
+    std::vector<double> energy;
+    double zoffset = 0.;
+  };
+
+  void CreateNodes(PHCompositeNode *topNode);
+
+  //! add energy (GeV) deposited at global x,y and local z at time t (ns)
+  void AddDeposit(const double x, const double y, const double localz, const double zoffset, const double t, const double edep);
+
+  void MakeHitsAndClusters();
+
+  gsl_rng *m_RandomGenerator = nullptr;
+
+  TrkrHitSetContainer *m_HitSets = nullptr;
+  TrkrClusterContainer *m_Clusters = nullptr;
+
+  std::string m_Detector = "TRD";
+
+  //! thickness of the Xe gas volume (cm), from the geometry parameters
+  double m_DriftLength = NAN;
+  double m_DriftVelocity = 0.0035;
+  int m_NTimeBins = 30;
+  double m_TimeBinWidth = 25.;
+
+  double m_Rmin = 20.;
+  double m_Rmax = 200.;
+  double m_PadPitch = 1.;
+  int m_NPhiPads = 512;
+
+  double m_AdcPerKeV = 20.;
+  double m_AdcNoise = 2.;
+  double m_AdcThreshold = 6.;
+  double m_ClusterThreshold = 20.;
+
+  //! pad (row * m_NPhiPads + phi) -> signal
+  std::map<int, PadSignal> m_PadSignals;
+};
+
+#endif
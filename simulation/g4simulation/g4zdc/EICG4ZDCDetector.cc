@@ -30,6 +30,10 @@
 
 #include <g4main/PHG4Detector.h>
 
+#include <phool/phool.h>
+
+#include <TSystem.h>
+
 #include <Geant4/G4Box.hh>
 #include <Geant4/G4Color.hh>
 #include <Geant4/G4LogicalVolume.hh>
@@ -42,6 +46,7 @@
 
 #include <cmath>
 #include <iostream>
+#include <map>
 
 class G4VSolid;
 class PHCompositeNode;
@@ -61,23 +66,18 @@ EICG4ZDCDetector::EICG4ZDCDetector(PHG4Subsystem *subsys,
 //_______________________________________________________________
 int EICG4ZDCDetector::IsInDetector(G4VPhysicalVolume *volume) const
 {
-
-  G4LogicalVolume *lvolume = volume->GetLogicalVolume();
-  set<G4LogicalVolume *>::const_iterator iter_active  
-    = m_ActiveLogicalVolumesSet.find(lvolume);
-  if (iter_active != m_ActiveLogicalVolumesSet.end())  return 1;
-  set<G4LogicalVolume *>::const_iterator iter_absorber  
-    = m_AbsorberLogicalVolumesSet.find(lvolume);
-  if (iter_absorber != m_AbsorberLogicalVolumesSet.end())  return -1;
-  
-  return 0;
+  return GetVolumeInfo(volume).active;
 }
 
-int EICG4ZDCDetector::GetVolumeInfo(G4VPhysicalVolume *volume){
-
-  G4LogicalVolume *lvolume = volume->GetLogicalVolume();
-  int lvinfo = m_ActiveLogicalVolumeInfoMap[lvolume];
-  return lvinfo;
+//_______________________________________________________________
+const ZDCID::VolumeInfo &EICG4ZDCDetector::GetVolumeInfo(G4VPhysicalVolume *volume) const
+{
+  unsigned int id = volume->GetLogicalVolume()->GetInstanceID();
+  if (id < m_VolumeTable.size())
+  {
+    return m_VolumeTable[id];
+  }
+  return m_NotInDetector;
 }
 
 //_______________________________________________________________
@@ -121,12 +121,42 @@ void EICG4ZDCDetector::ConstructMe(G4LogicalVolume *logicWorld)
   
   mzs->ProvideLogicalVolumesSets(m_ActiveLogicalVolumesSet, 
   				 m_AbsorberLogicalVolumesSet);
-  mzs->ProvideLogicalVolumeInfoMap(m_ActiveLogicalVolumeInfoMap);
+  std::map<G4LogicalVolume *, ZDCID::VolumeInfo> volinfo;
+  mzs->ProvideLogicalVolumeInfoMap(volinfo);
+
+  // dense lookup table, the stepping action needs a single index per step
+  for (auto lv : m_AbsorberLogicalVolumesSet)
+  {
+    AddToVolumeTable(lv, ZDCID::VolumeInfo());
+    m_VolumeTable[lv->GetInstanceID()].active = -1;
+  }
+  for (auto lv : m_ActiveLogicalVolumesSet)
+  {
+    auto iter = volinfo.find(lv);
+    if (iter == volinfo.end())
+    {
+      std::cout << PHWHERE << " no volume info for active volume "
+                << lv->GetName() << std::endl;
+      gSystem->Exit(1);
+    }
+    AddToVolumeTable(lv, iter->second);
+  }
 
  //end implement your own here://
   return;
 }
 
+//_______________________________________________________________
+void EICG4ZDCDetector::AddToVolumeTable(G4LogicalVolume *lv, const ZDCID::VolumeInfo &info)
+{
+  unsigned int id = lv->GetInstanceID();
+  if (id >= m_VolumeTable.size())
+  {
+    m_VolumeTable.resize(id + 1);
+  }
+  m_VolumeTable[id] = info;
+}
+
 //_______________________________________________________________
 void EICG4ZDCDetector::Print(const std::string &what) const
 {
@@ -3,11 +3,13 @@
 #ifndef EICG4ZDCDETECTOR_H
 #define EICG4ZDCDETECTOR_H
 
+#include "EICG4ZDCdetid.h"
+
 #include <g4main/PHG4Detector.h>
 
-#include <map>
 #include <set>
 #include <string>  // for string
+#include <vector>
 
 class G4LogicalVolume;
 class G4VPhysicalVolume;
@@ -33,12 +35,15 @@ class EICG4ZDCDetector : public PHG4Detector
   //@{
   int IsInDetector(G4VPhysicalVolume *) const;
   //@}
-  int GetVolumeInfo(G4VPhysicalVolume *volume);
+  //! decoding descriptor of the volume, active == 0 if not in the detector
+  const ZDCID::VolumeInfo &GetVolumeInfo(G4VPhysicalVolume *volume) const;
 
   void SuperDetector(const std::string &name) { m_SuperDetector = name; }
   const std::string SuperDetector() const { return m_SuperDetector; }
 
  private:
+  void AddToVolumeTable(G4LogicalVolume *lv, const ZDCID::VolumeInfo &info);
+
   PHParameters *m_Params;
 
   std::set<G4LogicalVolume *> m_ActiveLogicalVolumesSet;
@@ -46,7 +51,9 @@ class EICG4ZDCDetector : public PHG4Detector
 
   // active volumes
   std::set<G4VPhysicalVolume *> m_PhysicalVolumesSet;
-  std::map<G4LogicalVolume*, int> m_ActiveLogicalVolumeInfoMap;
+  //! descriptors indexed by G4LogicalVolume::GetInstanceID()
+  std::vector<ZDCID::VolumeInfo> m_VolumeTable;
+  ZDCID::VolumeInfo m_NotInDetector;
 
   std::string m_SuperDetector;
 };
@@ -29,6 +29,8 @@
 
 #include <g4detectors/PHG4StepStatusDecode.h>
 
+#include <g4eicutils/PHG4TrackKiller.h>
+
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
 #include <g4main/PHG4Hitv1.h>
@@ -56,6 +58,7 @@
 #include <Geant4/G4VTouchable.hh>
 #include <Geant4/G4VUserTrackInformation.hh>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -79,6 +82,8 @@ EICG4ZDCSteppingAction::EICG4ZDCSteppingAction(EICG4ZDCDetector *detector, const
   , m_BlackHoleFlag(m_Params->get_int_param("blackhole"))
   , m_EdepSum(0)
   , m_EionSum(0)
+  , m_TrackKiller(new PHG4TrackKiller(parameters))
+  , m_AggregateCellsFlag(m_Params->get_int_param("aggregate_cells"))
 {
 
 }
@@ -91,6 +96,8 @@ EICG4ZDCSteppingAction::~EICG4ZDCSteppingAction()
   // if the last hit was saved, hit is a nullptr pointer which are
   // legal to delete (it results in a no operation)
   delete m_Hit;
+  m_TrackKiller->Print(GetName());
+  delete m_TrackKiller;
 }
 
 //____________________________________________________________________________..
@@ -102,11 +109,12 @@ bool EICG4ZDCSteppingAction::UserSteppingAction(const G4Step *aStep,bool was_use
   // get volume of the current step
   G4VPhysicalVolume *volume = touch->GetVolume();
 
-  // IsInDetector(volume) returns
+  // the volume info active flag is
   //  == 0 outside of detector
   //   > 0 for hits in active volume
   //  < 0 for hits in passive material
-  int whichactive = m_Detector->IsInDetector(volume);
+  const ZDCID::VolumeInfo &volinfo = m_Detector->GetVolumeInfo(volume);
+  int whichactive = volinfo.active;
   if (!whichactive)
   {
     return false;
@@ -124,6 +132,11 @@ bool EICG4ZDCSteppingAction::UserSteppingAction(const G4Step *aStep,bool was_use
     G4Track *killtrack = const_cast<G4Track *>(aTrack);
     killtrack->SetTrackStatus(fStopAndKill);
   }
+  // slow neutrons etc. which are too late for the readout
+  else
+  {
+    m_TrackKiller->Apply(const_cast<G4Track *>(aTrack));
+  }
   // we use here only one detector in this simple example
   // if you deal with multiple detectors in this stepping action
   // the detector id can be used to distinguish between them
@@ -133,44 +146,26 @@ bool EICG4ZDCSteppingAction::UserSteppingAction(const G4Step *aStep,bool was_use
   /*--Here check the ZDC detector ID and layers-----*/
   /*------------------------------------------------*/
 
-  int detflag = -1;
-  if(whichactive>0) detflag = m_Detector->GetVolumeInfo(volume);
-  int detector_id = detflag%100;  
-  int detector_layer = (detflag%10000)/100;
-  int detector_nlyrbox =(detflag%1000000)/10000;
-  int detector_system=  (detflag/1000000)*1000000;
-
-  int xid = touch->GetCopyNumber(1);
-  int yid = touch->GetCopyNumber();
-
+  // the layer is given by the copy numbers of the mother volumes
+  // with the strides precomputed by EICG4ZDCStructure
+  int detector_id = -1;
   int layer_id = -1;
-  
-  if(whichactive>0){
-    if(detector_system == ZDCID::CrystalTower){
-      int zid = touch->GetCopyNumber(2);
-      if(detector_id == ZDCID::SI_PIXEL) layer_id = zid * 2;
-      else if(detector_id==ZDCID::Crystal) layer_id = zid * 2 +1;
-
-    }else if(detector_system == ZDCID::EMLayer){
-      if(detector_id == ZDCID::SI_PIXEL) layer_id = detector_layer + touch->GetCopyNumber(3);
-      if(detector_id == ZDCID::SI_PAD) {
-	int boxid = touch->GetCopyNumber(4);
-	int zid    =touch->GetCopyNumber(3);
-	int nlyr = detector_nlyrbox +1;
-	layer_id = detector_layer + zid + boxid * nlyr; 
-      }
-    }else if (detector_system == ZDCID::HCPadLayer){
-      if(detector_id == ZDCID::SI_PAD) layer_id = detector_layer + touch->GetCopyNumber(3);
-    }else if (detector_system == ZDCID::HCSciLayer){
-      if(detector_id == ZDCID::Scintillator){
-	int boxid = touch->GetCopyNumber(4);
-	int zid   = touch->GetCopyNumber(3);
-	int nlyr  = detector_nlyrbox;
-	layer_id = detector_layer + zid + boxid *nlyr;
+  if (whichactive > 0)
+  {
+    detector_id = volinfo.detid;
+    layer_id = volinfo.layer0;
+    for (int depth = 0; depth < volinfo.maxdepth; depth++)
+    {
+      if (volinfo.layer_stride[depth])
+      {
+        layer_id += volinfo.layer_stride[depth] * touch->GetCopyNumber(depth);
       }
     }
   }
-      
+
+  int xid = touch->GetCopyNumber(1);
+  int yid = touch->GetCopyNumber();
+
   bool geantino = false;
   // the check for the pdg code speeds things up, I do not want to make
   // an expensive string compare for every track when we know
@@ -184,6 +179,22 @@ bool EICG4ZDCSteppingAction::UserSteppingAction(const G4Step *aStep,bool was_use
   G4StepPoint *prePoint = aStep->GetPreStepPoint();
   G4StepPoint *postPoint = aStep->GetPostStepPoint();
 
+  // in aggregation mode the silicon pixel and pad energy deposits are summed
+  // per (layer, cell) and written out by FlushCells() at the end of the event
+  if (m_AggregateCellsFlag && whichactive > 0 && !geantino && layer_id >= 0 &&
+      (detector_id == ZDCID::SI_PIXEL || detector_id == ZDCID::SI_PAD))
+  {
+    m_SavePreStepStatus = prePoint->GetStepStatus();
+    m_SavePostStepStatus = postPoint->GetStepStatus();
+    m_SaveVolPre = volume;
+    m_SaveVolPost = touchpost->GetVolume();
+    if (edep > 0)
+    {
+      AddToCell(aStep, detector_id, layer_id, edep, eion);
+    }
+    return true;
+  }
+
 // Here we have to decide if we need to create a new hit.  Normally this should 
 // only be neccessary if a G4 Track enters a new volume or is freshly created
 // For this we look at the step status of the prePoint (beginning of the G4 Step).
@@ -396,3 +407,128 @@ void EICG4ZDCSteppingAction::SetInterfacePointers(PHCompositeNode *topNode)
               << hitnodename << std::endl;
   }
 }
+
+//____________________________________________________________________________..
+void EICG4ZDCSteppingAction::AddToCell(const G4Step *aStep, const int detector_id, const int layer_id, const double edep, const double eion)
+{
+  // the silicon is a replica in y inside a replica in x, the multiplicities
+  // of the two replicas give the dimension of the layer buffer
+  const G4VTouchable *touch = aStep->GetPreStepPoint()->GetTouchable();
+  int xid = touch->GetCopyNumber(1);
+  int yid = touch->GetCopyNumber();
+
+  if (detector_id >= (int) m_CellLayers.size())
+  {
+    m_CellLayers.resize(detector_id + 1);
+  }
+  std::vector<CellLayer> &layers = m_CellLayers[detector_id];
+  if (layer_id >= (int) layers.size())
+  {
+    layers.resize(layer_id + 1);
+  }
+  CellLayer &layer = layers[layer_id];
+  if (layer.cells.empty())
+  {
+    layer.nx = touch->GetVolume(1)->GetMultiplicity();
+    layer.ny = touch->GetVolume()->GetMultiplicity();
+    layer.cells.resize(layer.nx * layer.ny);
+  }
+  if (xid < 0 || xid >= layer.nx || yid < 0 || yid >= layer.ny)
+  {
+    std::cout << GetName() << ": cell (" << xid << ", " << yid
+              << ") outside of layer " << layer_id << " with "
+              << layer.nx << " x " << layer.ny << " cells" << std::endl;
+    gSystem->Exit(1);
+  }
+
+  G4StepPoint *prePoint = aStep->GetPreStepPoint();
+  G4StepPoint *postPoint = aStep->GetPostStepPoint();
+  G4ThreeVector pos = 0.5 * (prePoint->GetPosition() + postPoint->GetPosition());
+  double tpre = prePoint->GetGlobalTime() / nanosecond;
+  double tpost = postPoint->GetGlobalTime() / nanosecond;
+
+  int index = xid * layer.ny + yid;
+  CellSum &cell = layer.cells[index];
+  if (cell.edep <= 0)
+  {
+    layer.fired.push_back(index);
+    cell.tmin = tpre;
+    cell.tmax = tpost;
+  }
+  else
+  {
+    cell.tmin = std::min(cell.tmin, tpre);
+    cell.tmax = std::max(cell.tmax, tpost);
+  }
+  cell.edep += edep;
+  cell.eion += eion;
+  cell.xsum += edep * pos.x() / cm;
+  cell.ysum += edep * pos.y() / cm;
+  cell.zsum += edep * pos.z() / cm;
+  if (edep > cell.maxstep)
+  {
+    // the track with the largest step is the truth of the cell, only this
+    // one is kept. The keep flag is read when the track ends, so a track
+    // which is overtaken later in the event stays kept.
+    const G4Track *aTrack = aStep->GetTrack();
+    cell.maxstep = edep;
+    cell.trkid = aTrack->GetTrackID();
+    cell.shower = nullptr;
+    if (G4VUserTrackInformation *p = aTrack->GetUserInformation())
+    {
+      if (PHG4TrackUserInfoV1 *pp = dynamic_cast<PHG4TrackUserInfoV1 *>(p))
+      {
+        cell.trkid = pp->GetUserTrackId();
+        cell.shower = pp->GetShower();
+        pp->SetKeep(1);  // we want to keep the track
+      }
+    }
+  }
+}
+
+//____________________________________________________________________________..
+void EICG4ZDCSteppingAction::FlushCells()
+{
+  for (unsigned int detector_id = 0; detector_id < m_CellLayers.size(); detector_id++)
+  {
+    std::vector<CellLayer> &layers = m_CellLayers[detector_id];
+    for (unsigned int layer_id = 0; layer_id < layers.size(); layer_id++)
+    {
+      CellLayer &layer = layers[layer_id];
+      for (int index : layer.fired)
+      {
+        CellSum &cell = layer.cells[index];
+        if (m_HitContainer)
+        {
+          PHG4Hit *hit = new PHG4Hitv1();
+          double x = cell.xsum / cell.edep;
+          double y = cell.ysum / cell.edep;
+          double z = cell.zsum / cell.edep;
+          for (int i = 0; i < 2; i++)
+          {
+            hit->set_x(i, x);
+            hit->set_y(i, y);
+            hit->set_z(i, z);
+          }
+          hit->set_t(0, cell.tmin);
+          hit->set_t(1, cell.tmax);
+          hit->set_trkid(cell.trkid);
+          hit->set_edep(cell.edep);
+          hit->set_eion(cell.eion);
+          hit->set_layer(layer_id);
+          hit->set_index_i(index / layer.ny);
+          hit->set_index_j(index % layer.ny);
+          hit->set_hit_type(detector_id);
+          m_HitContainer->AddHit(detector_id, hit);
+          // this is for the tracking of the truth info
+          if (cell.shower)
+          {
+            cell.shower->add_g4hit_id(m_HitContainer->GetID(), hit->get_hit_id());
+          }
+        }
+        cell = CellSum();
+      }
+      layer.fired.clear();
+    }
+  }
+}
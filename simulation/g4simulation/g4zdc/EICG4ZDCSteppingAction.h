@@ -5,6 +5,8 @@
 
 #include <g4main/PHG4SteppingAction.h>
 
+#include <vector>
+
 class EICG4ZDCDetector;
 
 class G4Step;
@@ -12,6 +14,8 @@ class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4Hit;
 class PHG4HitContainer;
+class PHG4Shower;
+class PHG4TrackKiller;
 class PHParameters;
 
 class EICG4ZDCSteppingAction : public PHG4SteppingAction
@@ -29,7 +33,38 @@ class EICG4ZDCSteppingAction : public PHG4SteppingAction
   //! reimplemented from base class
   virtual void SetInterfacePointers(PHCompositeNode*);
 
+  //! store one hit per fired silicon cell and reset the cell buffers
+  //! (only does something if aggregate_cells is set)
+  void FlushCells();
+
  private:
+  //! energy sum of a single silicon pixel/pad in aggregation mode
+  struct CellSum
+  {
+    double edep = 0;
+    double eion = 0;
+    double xsum = 0;  // edep weighted position (cm)
+    double ysum = 0;
+    double zsum = 0;
+    double tmin = 0;  // ns
+    double tmax = 0;
+    double maxstep = 0;  // largest single step edep, defines the track id
+    int trkid = 0;
+    PHG4Shower* shower = nullptr;  // shower of that track
+  };
+
+  //! dense buffer for all cells of one layer, index is ix * ny + iy
+  struct CellLayer
+  {
+    int nx = 0;
+    int ny = 0;
+    std::vector<CellSum> cells;
+    std::vector<int> fired;
+  };
+
+  //! add the energy deposit of this step to its (layer, cell)
+  void AddToCell(const G4Step* aStep, const int detector_id, const int layer_id, const double edep, const double eion);
+
   //! pointer to the detector
   EICG4ZDCDetector* m_Detector;
   const PHParameters* m_Params;
@@ -48,6 +83,12 @@ class EICG4ZDCSteppingAction : public PHG4SteppingAction
   double m_EdepSum;
   double m_EionSum;
 
+  PHG4TrackKiller* m_TrackKiller;
+
+  int m_AggregateCellsFlag;
+  //! cell buffers indexed by [detector id][layer id]
+  std::vector<std::vector<CellLayer>> m_CellLayers;
+
  
 };
 
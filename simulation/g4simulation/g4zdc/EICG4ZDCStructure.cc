@@ -35,7 +35,7 @@ void EICG4ZDCStructure::ProvideLogicalVolumesSets(std::set<G4LogicalVolume *> &A
 
 }
 
-void EICG4ZDCStructure::ProvideLogicalVolumeInfoMap(std::map<G4LogicalVolume *, int> &ActiveLogicalVolumeInfoMap){
+void EICG4ZDCStructure::ProvideLogicalVolumeInfoMap(std::map<G4LogicalVolume *, ZDCID::VolumeInfo> &ActiveLogicalVolumeInfoMap){
 					       
   ActiveLogicalVolumeInfoMap = m_ActiveLogicalVolumeInfoMap;
 
@@ -80,10 +80,9 @@ double EICG4ZDCStructure::ConstructCrystalTowers(double Start_X, double Start_Y,
   lV_PIXPlane->SetVisAttributes(G4VisAttributes::Invisible);
   lV_PIXEnvelope->SetVisAttributes(G4VisAttributes::Invisible);
   
-  std::pair<G4LogicalVolume*, int> pair_Crystal= std::make_pair(lV_Crystal, fLayer*100 + ZDCID::Crystal + ZDCID::CrystalTower);
-  std::pair<G4LogicalVolume*, int> pair_CPIX = std::make_pair(lV_PIX_Silicon, fLayer*100 + ZDCID::SI_PIXEL + ZDCID::CrystalTower);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_Crystal);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_CPIX);
+  // pixel planes and crystal boxes alternate, the box/plane copy number is the z index
+  AddVolumeInfo(lV_Crystal, ZDCID::CrystalTower, ZDCID::Crystal, fLayer + 1, 2, 2);
+  AddVolumeInfo(lV_PIX_Silicon, ZDCID::CrystalTower, ZDCID::SI_PIXEL, fLayer, 2, 2);
 
   m_ActiveLogicalVolumesSet.insert(lV_PIX_Silicon);
   m_ActiveLogicalVolumesSet.insert(lV_Crystal);
@@ -230,13 +229,10 @@ double EICG4ZDCStructure::ConstructEMLayers(double Start_X, double Start_Y, doub
   lV_PIXEnvelope->SetVisAttributes(G4VisAttributes::Invisible);
   lV_PIXLayer->SetVisAttributes(G4VisAttributes::Invisible);
 
-  int infoval=0;
-  infoval = ZDCID::EMLayer+ NPadOnlyLayers * 10000 + fLayer*100 + ZDCID::SI_PAD;
-  std::pair<G4LogicalVolume*, int> pair_PAD_Si = std::make_pair(lV_PAD_Silicon, infoval);
-  infoval = ZDCID::EMLayer+ NPadOnlyLayers * 10000 + fLayer*100 + ZDCID::SI_PIXEL;
-  std::pair<G4LogicalVolume*, int> pair_PIX_Si = std::make_pair(lV_PIX_Silicon, infoval);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_PAD_Si);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_PIX_Si);
+  // pad layers are replicas (depth 3) inside the pad only boxes (depth 4), each
+  // box is followed by a pixel layer whose copy number is its layer offset
+  AddVolumeInfo(lV_PAD_Silicon, ZDCID::EMLayer, ZDCID::SI_PAD, fLayer, 3, 1, 4, NPadOnlyLayers + 1);
+  AddVolumeInfo(lV_PIX_Silicon, ZDCID::EMLayer, ZDCID::SI_PIXEL, fLayer, 3, 1);
 
   m_ActiveLogicalVolumesSet.insert(lV_PAD_Silicon);
   m_ActiveLogicalVolumesSet.insert(lV_PIX_Silicon);
@@ -373,9 +369,7 @@ double EICG4ZDCStructure::ConstructHCSiliconLayers(double Start_X, double Start_
   lV_HCal_Layer->SetVisAttributes(G4VisAttributes::Invisible);
   lV_HC_Si_Box->SetVisAttributes(G4VisAttributes::Invisible);
 
-  int infoval = ZDCID::HCPadLayer + fLayer*100 + ZDCID::SI_PAD;
-  std::pair<G4LogicalVolume*, int> pair_PAD= std::make_pair(lV_PAD_Silicon, infoval);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_PAD);
+  AddVolumeInfo(lV_PAD_Silicon, ZDCID::HCPadLayer, ZDCID::SI_PAD, fLayer, 3, 1);
 
   m_ActiveLogicalVolumesSet.insert(lV_PAD_Silicon);
   m_AbsorberLogicalVolumesSet.insert(lV_HCal_Absorber);
@@ -454,9 +448,8 @@ double EICG4ZDCStructure::ConstructHCSciLayers(double Start_X, double Start_Y, d
   lV_HCal_SciEnvelope->SetVisAttributes(G4VisAttributes::Invisible);
   lV_HCal_Box->SetVisAttributes(G4VisAttributes::Invisible);
 
-  int infoval = ZDCID::HCSciLayer +NLayersHCALTower*10000 + fLayer*100 + ZDCID::Scintillator;
-  std::pair<G4LogicalVolume*, int> pair_Scint= std::make_pair(lV_HCal_Scintillator, infoval);
-  m_ActiveLogicalVolumeInfoMap.insert(pair_Scint);
+  // layer replica (depth 3) inside the tower boxes (depth 4)
+  AddVolumeInfo(lV_HCal_Scintillator, ZDCID::HCSciLayer, ZDCID::Scintillator, fLayer, 3, 1, 4, NLayersHCALTower);
 
   m_ActiveLogicalVolumesSet.insert(lV_HCal_Scintillator);
   m_AbsorberLogicalVolumesSet.insert(lV_HCal_Absorber);
@@ -492,6 +485,23 @@ double EICG4ZDCStructure::ConstructHCSciLayers(double Start_X, double Start_Y, d
   return Start_Z+TotalThicknessCreated;
 }
 
+void EICG4ZDCStructure::AddVolumeInfo(G4LogicalVolume *lv, const int system, const int detid, const int layer0,
+				      const int depth_a, const int stride_a,
+				      const int depth_b, const int stride_b){
+
+  ZDCID::VolumeInfo info;
+  info.active = 1;
+  info.system = system;
+  info.detid = detid;
+  info.layer0 = layer0;
+  info.layer_stride[depth_a] += stride_a;
+  info.layer_stride[depth_b] += stride_b;
+  for(int depth=0; depth<ZDCID::MaxDepth; depth++){
+    if(info.layer_stride[depth]) info.maxdepth = depth + 1;
+  }
+  m_ActiveLogicalVolumeInfoMap.insert(std::make_pair(lv, info));
+}
+
 void EICG4ZDCStructure::Materials(){
 
   //*****************************************************************************************
@@ -1,6 +1,8 @@
 #ifndef EICG4ZDCSTRUCTURE_H
 #define EICG4ZDCSTRUCTURE_H
 
+#include "EICG4ZDCdetid.h"
+
 #include <set>
 #include <map>
 #include <Geant4/globals.hh>
@@ -30,7 +32,7 @@ class EICG4ZDCStructure {
 			      G4VPhysicalVolume *mPhy);
   void ProvideLogicalVolumesSets(std::set<G4LogicalVolume *> &ActiveLogicalVolumesSet,
 				 std::set<G4LogicalVolume *> &AbsorberLogicalVolumesSet);
-  void ProvideLogicalVolumeInfoMap(std::map<G4LogicalVolume *, int> &ActiveLVInfoPairsSet);
+  void ProvideLogicalVolumeInfoMap(std::map<G4LogicalVolume *, ZDCID::VolumeInfo> &ActiveLVInfoPairsSet);
 
   void Print();
 
@@ -39,6 +41,9 @@ private:
 
   void SetColors();
   void Materials();
+  void AddVolumeInfo(G4LogicalVolume *lv, const int system, const int detid, const int layer0,
+                     const int depth_a = 0, const int stride_a = 0,
+                     const int depth_b = 0, const int stride_b = 0);
   
   int fLayer;
   
@@ -62,7 +67,7 @@ private:
 
   std::set<G4LogicalVolume *> m_ActiveLogicalVolumesSet;
   std::set<G4LogicalVolume *> m_AbsorberLogicalVolumesSet;
-  std::map<G4LogicalVolume*, int> m_ActiveLogicalVolumeInfoMap;
+  std::map<G4LogicalVolume*, ZDCID::VolumeInfo> m_ActiveLogicalVolumeInfoMap;
 
 };  
 
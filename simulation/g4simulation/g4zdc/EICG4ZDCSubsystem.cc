@@ -81,6 +81,15 @@ int EICG4ZDCSubsystem::process_event(PHCompositeNode *topNode)
   return 0;
 }
 //_______________________________________________________________________
+int EICG4ZDCSubsystem::process_after_geant(PHCompositeNode *)
+{
+  if (m_SteppingAction && GetParams()->get_int_param("aggregate_cells"))
+  {
+    static_cast<EICG4ZDCSteppingAction *>(m_SteppingAction)->FlushCells();
+  }
+  return 0;
+}
+//_______________________________________________________________________
 void EICG4ZDCSubsystem::Print(const string &what) const
 {
   if (m_Detector)
@@ -113,4 +122,14 @@ void EICG4ZDCSubsystem::SetDefaultParameters()
   set_default_double_param("size_y", 60.);
   set_default_double_param("size_z", 200.);
 
+  // kill the particles in kill_particles (comma separated G4 names) after
+  // kill_time (ns) or below kill_ekin (GeV), values <= 0 disable the cut
+  set_default_string_param("kill_particles", "neutron");
+  set_default_double_param("kill_time", -1.);
+  set_default_double_param("kill_ekin", -1.);
+
+  // sum the silicon pixel and pad energy deposits per (layer, cell) and store
+  // one G4Hit per fired cell instead of one per track and volume
+  set_default_int_param("aggregate_cells", 0);
+
 }
@@ -41,6 +41,9 @@ class EICG4ZDCSubsystem : public PHG4DetectorSubsystem
   */
   int process_event(PHCompositeNode*) override;
 
+  //! write the summed silicon cell hits in aggregation mode
+  int process_after_geant(PHCompositeNode*) override;
+
   //! accessors (reimplemented)
   PHG4Detector* GetDetector() const override;
 
@@ -15,6 +15,22 @@ namespace ZDCID{
   const int HCPadLayer   = 3000000;
   const int HCSciLayer   = 4000000;
 
+  // maximum depth of the touchable history used for the layer decoding
+  const int MaxDepth = 5;
+
+  // decoding of an active volume, precomputed by EICG4ZDCStructure:
+  // layer = layer0 + sum of layer_stride[depth] * copy number at depth
+  // the cell indices are the copy numbers at depth 1 (x) and 0 (y)
+  struct VolumeInfo
+  {
+    int active = 0;  // 1 active, -1 absorber, 0 not in detector
+    int system = 0;  // CrystalTower, EMLayer, HCPadLayer, HCSciLayer
+    int detid = 0;   // Crystal, SI_PIXEL, SI_PAD, Scintillator
+    int layer0 = 0;
+    int layer_stride[MaxDepth] = {0, 0, 0, 0, 0};
+    int maxdepth = 0;  // deepest level with a non zero stride + 1
+  };
+
 };
 
 #endif